@@ -0,0 +1,340 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "blurengine.h"
+#include "workerpool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace VSTGUI {
+namespace BitmapFilter {
+namespace BlurEngineDetail {
+
+//------------------------------------------------------------------------
+static constexpr uint32_t kTileColumns = 64;
+static constexpr uint32_t kTransposeBlockSize = 32;
+static constexpr uint32_t kMinPixelsForThreads = 128 * 128;
+static constexpr int32_t kMaxRadius = 4096;
+/** larger gaussian blurs are approximated by three box blurs, their cost does not depend on the
+ *	radius while the kernel needs 6 * sigma + 1 taps per pixel */
+static constexpr double kMaxKernelSigma = 4.;
+
+//------------------------------------------------------------------------
+/** a vertical blur pass over the columns [x, x + count) of a plane */
+struct ColumnPass
+{
+	const uint8_t* src;
+	uint8_t* dst;
+	uint32_t stride;
+	uint32_t height;
+	uint32_t x;
+	uint32_t count;
+
+	const uint8_t* row (int32_t y) const
+	{
+		auto clamped = std::min (std::max (y, 0), static_cast<int32_t> (height) - 1);
+		return src + static_cast<size_t> (clamped) * stride + x;
+	}
+	uint8_t* dstRow (uint32_t y) const { return dst + static_cast<size_t> (y) * stride + x; }
+};
+
+//------------------------------------------------------------------------
+/** box blur with running sums, the edge pixels are repeated */
+inline void boxColumns (const ColumnPass& pass, int32_t radius, uint32_t* sums)
+{
+	const uint32_t div = static_cast<uint32_t> (radius) * 2 + 1;
+	// sum * reciprocal does not overflow as long as div is smaller than 2^16
+	const uint32_t reciprocal = ((1u << 24) + div / 2) / div;
+	const auto count = pass.count;
+	std::fill (sums, sums + count, 0u);
+	for (auto i = -radius; i <= radius; ++i)
+	{
+		auto row = pass.row (i);
+		for (auto c = 0u; c < count; ++c)
+			sums[c] += row[c];
+	}
+	for (auto y = 0u; y < pass.height; ++y)
+	{
+		auto out = pass.dstRow (y);
+		for (auto c = 0u; c < count; ++c)
+			out[c] = static_cast<uint8_t> ((sums[c] * reciprocal + (1u << 23)) >> 24);
+		auto add = pass.row (static_cast<int32_t> (y) + radius + 1);
+		auto sub = pass.row (static_cast<int32_t> (y) - radius);
+		for (auto c = 0u; c < count; ++c)
+			sums[c] += static_cast<uint32_t> (add[c]) - sub[c];
+	}
+}
+
+//------------------------------------------------------------------------
+/** convolution with a normalized kernel of 2 * radius + 1 16 bit fixed point weights */
+inline void kernelColumns (const ColumnPass& pass, const std::vector<uint32_t>& weights,
+						   uint32_t* sums)
+{
+	const auto radius = static_cast<int32_t> (weights.size () / 2);
+	const auto count = pass.count;
+	for (auto y = 0u; y < pass.height; ++y)
+	{
+		std::fill (sums, sums + count, 1u << 15);
+		for (auto k = -radius; k <= radius; ++k)
+		{
+			auto row = pass.row (static_cast<int32_t> (y) + k);
+			auto weight = weights[static_cast<size_t> (k + radius)];
+			for (auto c = 0u; c < count; ++c)
+				sums[c] += weight * row[c];
+		}
+		auto out = pass.dstRow (y);
+		for (auto c = 0u; c < count; ++c)
+			out[c] = static_cast<uint8_t> (sums[c] >> 16);
+	}
+}
+
+//------------------------------------------------------------------------
+inline std::vector<uint32_t> gaussianWeights (double sigma)
+{
+	auto radius = std::min (static_cast<int32_t> (std::ceil (sigma * 3.)), kMaxRadius);
+	std::vector<double> values (static_cast<size_t> (radius) * 2 + 1);
+	double sum = 0.;
+	for (auto i = -radius; i <= radius; ++i)
+	{
+		auto v = std::exp (-(i * i) / (2. * sigma * sigma));
+		values[static_cast<size_t> (i + radius)] = v;
+		sum += v;
+	}
+	std::vector<uint32_t> weights (values.size ());
+	uint32_t total = 0;
+	for (auto i = 0u; i < values.size (); ++i)
+	{
+		weights[i] = static_cast<uint32_t> (std::round (values[i] / sum * 65536.));
+		total += weights[i];
+	}
+	// the weights must add up to exactly 1 so that uniform areas keep their value
+	weights[static_cast<size_t> (radius)] += 65536u - total;
+	return weights;
+}
+
+//------------------------------------------------------------------------
+/** the radii of three box blurs which together approximate a gaussian blur with the standard
+ *	deviation sigma */
+inline std::vector<int32_t> boxRadiiForGaussian (double sigma)
+{
+	constexpr auto numBoxes = 3;
+	auto ideal = std::sqrt (12. * sigma * sigma / numBoxes + 1.);
+	auto lower = static_cast<int32_t> (std::floor (ideal));
+	if (lower % 2 == 0)
+		--lower;
+	auto upper = lower + 2;
+	// the number of boxes of the lower size which gives the closest variance
+	auto numLower = static_cast<int32_t> (
+		std::round ((12. * sigma * sigma - numBoxes * lower * lower - 4. * numBoxes * lower -
+					 3. * numBoxes) /
+					(-4. * lower - 4.)));
+	std::vector<int32_t> radii (numBoxes);
+	for (auto i = 0; i < numBoxes; ++i)
+	{
+		auto boxSize = i < numLower ? lower : upper;
+		radii[static_cast<size_t> (i)] = std::min ((boxSize - 1) / 2, kMaxRadius);
+	}
+	return radii;
+}
+
+} // BlurEngineDetail
+
+using namespace BlurEngineDetail;
+
+//------------------------------------------------------------------------
+struct BlurEngine::Impl
+{
+	std::shared_ptr<WorkerPool> pool;
+	std::vector<uint8_t> plane;
+	std::vector<uint8_t> scratch;
+	std::vector<uint32_t> sums;
+	/** the gaussian kernel, if empty the passes of boxRadii are used */
+	std::vector<uint32_t> weights;
+	std::vector<int32_t> boxRadii;
+	uint32_t numThreads {1};
+
+	void parallelFor (uint32_t count, const WorkerPool::Task& task)
+	{
+		if (numThreads > 1 && count > 1)
+		{
+			pool->parallelFor (count, numThreads, task);
+			return;
+		}
+		for (auto i = 0u; i < count; ++i)
+			task (i);
+	}
+
+	/** blur the width x height plane vertically, returns the buffer containing the result */
+	uint8_t* blurColumns (uint8_t* data, uint8_t* tmp, uint32_t width, uint32_t height)
+	{
+		auto numPasses = weights.empty () ? static_cast<uint32_t> (boxRadii.size ()) : 1u;
+		auto numTiles = (width + kTileColumns - 1) / kTileColumns;
+		// a task can run on any thread, so every task needs its own sums. As only numThreads
+		// tasks run at the same time, tasks are mapped to the sums of a slot which is locked
+		std::vector<std::atomic<bool>> slotsInUse (numThreads);
+		for (auto& s : slotsInUse)
+			s = false;
+		parallelFor (numTiles, [&] (uint32_t tile) {
+			uint32_t slot = 0;
+			while (true)
+			{
+				bool expected = false;
+				if (slotsInUse[slot].compare_exchange_weak (expected, true))
+					break;
+				slot = (slot + 1) % numThreads;
+			}
+			auto tileSums = sums.data () + slot * kTileColumns;
+			auto x = tile * kTileColumns;
+			auto count = std::min (kTileColumns, width - x);
+			uint8_t* src = data;
+			uint8_t* dst = tmp;
+			for (auto pass = 0u; pass < numPasses; ++pass, std::swap (src, dst))
+			{
+				if (!weights.empty ())
+					kernelColumns ({src, dst, width, height, x, count}, weights, tileSums);
+				else
+					boxColumns ({src, dst, width, height, x, count}, boxRadii[pass], tileSums);
+			}
+			slotsInUse[slot] = false;
+		});
+		return numPasses % 2 ? tmp : data;
+	}
+
+	/** transpose the width x height plane src into dst */
+	void transpose (const uint8_t* src, uint8_t* dst, uint32_t width, uint32_t height)
+	{
+		auto numBlocks = (height + kTransposeBlockSize - 1) / kTransposeBlockSize;
+		parallelFor (numBlocks, [&] (uint32_t block) {
+			auto y0 = block * kTransposeBlockSize;
+			auto y1 = std::min (y0 + kTransposeBlockSize, height);
+			for (auto x0 = 0u; x0 < width; x0 += kTransposeBlockSize)
+			{
+				auto x1 = std::min (x0 + kTransposeBlockSize, width);
+				for (auto y = y0; y < y1; ++y)
+				{
+					auto srcRow = src + static_cast<size_t> (y) * width;
+					for (auto x = x0; x < x1; ++x)
+						dst[static_cast<size_t> (x) * height + y] = srcRow[x];
+				}
+			}
+		});
+	}
+
+	void extractPlane (const uint8_t* pixels, uint32_t bytesPerRow, uint32_t width,
+					   uint32_t height, uint32_t position)
+	{
+		auto numBlocks = (height + kTransposeBlockSize - 1) / kTransposeBlockSize;
+		parallelFor (numBlocks, [&] (uint32_t block) {
+			auto y1 = std::min ((block + 1) * kTransposeBlockSize, height);
+			for (auto y = block * kTransposeBlockSize; y < y1; ++y)
+			{
+				auto src = pixels + static_cast<size_t> (y) * bytesPerRow + position;
+				auto dst = plane.data () + static_cast<size_t> (y) * width;
+				for (auto x = 0u; x < width; ++x)
+					dst[x] = src[x * 4];
+			}
+		});
+	}
+
+	/** write the transposed plane src (height x width) back into the pixels */
+	void storeTransposedPlane (const uint8_t* src, uint8_t* pixels, uint32_t bytesPerRow,
+							   uint32_t width, uint32_t height, uint32_t position)
+	{
+		auto numBlocks = (height + kTransposeBlockSize - 1) / kTransposeBlockSize;
+		parallelFor (numBlocks, [&] (uint32_t block) {
+			auto y0 = block * kTransposeBlockSize;
+			auto y1 = std::min (y0 + kTransposeBlockSize, height);
+			for (auto x0 = 0u; x0 < width; x0 += kTransposeBlockSize)
+			{
+				auto x1 = std::min (x0 + kTransposeBlockSize, width);
+				for (auto y = y0; y < y1; ++y)
+				{
+					auto dst = pixels + static_cast<size_t> (y) * bytesPerRow + position;
+					for (auto x = x0; x < x1; ++x)
+						dst[x * 4] = src[static_cast<size_t> (x) * height + y];
+				}
+			}
+		});
+	}
+};
+
+//------------------------------------------------------------------------
+BlurEngine::BlurEngine ()
+{
+	impl = std::unique_ptr<Impl> (new Impl);
+}
+
+//------------------------------------------------------------------------
+BlurEngine::~BlurEngine () noexcept = default;
+
+//------------------------------------------------------------------------
+void BlurEngine::releaseBuffers ()
+{
+	impl->plane = {};
+	impl->scratch = {};
+	impl->sums = {};
+}
+
+//------------------------------------------------------------------------
+void BlurEngine::run (uint8_t* pixels, uint32_t bytesPerRow, uint32_t width, uint32_t height,
+					  const Options& options)
+{
+	if (pixels == nullptr || width == 0 || height == 0 || (options.planeMask & 0x0F) == 0)
+		return;
+	impl->weights.clear ();
+	if (options.mode == Mode::Gaussian)
+	{
+		if (options.radius <= 0.)
+			return;
+		if (options.radius <= kMaxKernelSigma)
+			impl->weights = gaussianWeights (options.radius);
+		else
+			impl->boxRadii = boxRadiiForGaussian (options.radius);
+	}
+	else
+	{
+		if (options.radius < 1. || options.boxPasses == 0)
+			return;
+		impl->boxRadii.assign (options.boxPasses,
+							   std::min (static_cast<int32_t> (options.radius), kMaxRadius));
+	}
+
+	auto maxThreads = options.maxThreads ? options.maxThreads : WorkerPool::kMaxThreads;
+	auto size = static_cast<size_t> (width) * height;
+	if (maxThreads > 1 && size >= kMinPixelsForThreads)
+	{
+		if (!impl->pool)
+			impl->pool = WorkerPool::get ();
+		impl->numThreads = std::min (maxThreads, impl->pool->getNumThreads ());
+	}
+	else
+		impl->numThreads = 1;
+
+	if (impl->plane.size () < size)
+	{
+		impl->plane.resize (size);
+		impl->scratch.resize (size);
+	}
+	impl->sums.resize (kTileColumns * impl->numThreads);
+
+	for (auto position = 0u; position < 4; ++position)
+	{
+		if ((options.planeMask & (1u << position)) == 0)
+			continue;
+		auto plane = impl->plane.data ();
+		auto scratch = impl->scratch.data ();
+		impl->extractPlane (pixels, bytesPerRow, width, height, position);
+		auto result = impl->blurColumns (plane, scratch, width, height);
+		auto other = result == plane ? scratch : plane;
+		impl->transpose (result, other, width, height);
+		result = impl->blurColumns (other, result, height, width);
+		impl->storeTransposedPlane (result, pixels, bytesPerRow, width, height, position);
+	}
+}
+
+//------------------------------------------------------------------------
+} // BitmapFilter
+} // VSTGUI
@@ -0,0 +1,67 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include <cstdint>
+#include <memory>
+
+namespace VSTGUI {
+namespace BitmapFilter {
+
+//------------------------------------------------------------------------
+/** Separable blur for buffers of 32 bit pixels
+ *
+ *	Every channel to blur is copied into an 8 bit plane. The plane is blurred vertically in tiles
+ *	of columns, transposed and blurred vertically again, so that both directions update the
+ *	running sums of a whole row of the tile at once. The tiles are distributed over a pool of
+ *	worker threads shared by all engines.
+ *
+ *	The engine keeps its buffers, blurring a bitmap of the same or a smaller size again does not
+ *	allocate memory.
+ */
+class BlurEngine
+{
+public:
+	enum class Mode
+	{
+		/** box blur applied Options::boxPasses times */
+		Box,
+		/** gaussian blur, large standard deviations are approximated by three box blurs */
+		Gaussian
+	};
+
+	struct Options
+	{
+		Mode mode {Mode::Box};
+		/** box mode: half of the box size in pixels, gaussian mode: the standard deviation in
+		 *	pixels */
+		double radius {1.};
+		/** number of box blur passes */
+		uint32_t boxPasses {1};
+		/** bit mask of the byte positions in a pixel to blur, 0x0F blurs all channels */
+		uint32_t planeMask {0x0F};
+		/** maximum number of threads to use, 0 to use all available */
+		uint32_t maxThreads {0};
+	};
+
+	BlurEngine ();
+	~BlurEngine () noexcept;
+
+	/** blur the pixels in place */
+	void run (uint8_t* pixels, uint32_t bytesPerRow, uint32_t width, uint32_t height,
+			  const Options& options);
+
+	/** release the buffers */
+	void releaseBuffers ();
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+//------------------------------------------------------------------------
+} // BitmapFilter
+} // VSTGUI
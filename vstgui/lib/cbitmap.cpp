@@ -5,6 +5,7 @@
 #include "cbitmap.h"
 #include "cdrawcontext.h"
 #include "ccolor.h"
+#include "cspriteatlas.h"
 #include "platform/iplatformbitmap.h"
 #include "platform/platformfactory.h"
 #include <cassert>
@@ -75,6 +76,9 @@ CBitmap::CBitmap (const PlatformBitmapPtr& platformBitmap)
 	bitmaps.emplace_back (platformBitmap);
 }
 
+//-----------------------------------------------------------------------------
+CBitmap::~CBitmap () noexcept = default;
+
 //-----------------------------------------------------------------------------
 void CBitmap::draw (CDrawContext* context, const CRect& rect, const CPoint& offset, float alpha)
 {
@@ -126,6 +130,7 @@ void CBitmap::setPlatformBitmap (const PlatformBitmapPtr& bitmap)
 		bitmaps.emplace_back (bitmap);
 	else
 		bitmaps[0] = bitmap;
+	contentChanged ();
 }
 
 //-----------------------------------------------------------------------------
@@ -150,9 +155,18 @@ bool CBitmap::addBitmap (const PlatformBitmapPtr& platformBitmap)
 		}
 	}
 	bitmaps.emplace_back (platformBitmap);
+	contentChanged ();
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+CSpriteAtlas* CBitmap::getSpriteAtlas (CCoord frameHeight)
+{
+	if (!spriteAtlas || spriteAtlas->getFrameHeight () != frameHeight)
+		spriteAtlas = makeOwned<CSpriteAtlas> (this, frameHeight);
+	return spriteAtlas;
+}
+
 //-----------------------------------------------------------------------------
 auto CBitmap::getBestPlatformBitmapForScaleFactor (double scaleFactor) const -> PlatformBitmapPtr
 {
@@ -282,6 +296,8 @@ CBitmapPixelAccess* CBitmapPixelAccess::create (CBitmap* bitmap, bool alphaPremu
 {
 	if (bitmap == nullptr || bitmap->getPlatformBitmap () == nullptr)
 		return nullptr;
+	// the pixels may be changed via the accessor
+	bitmap->contentChanged ();
 	auto pixelAccess = bitmap->getPlatformBitmap ()->lockPixels (alphaPremultiplied);
 	if (pixelAccess == nullptr)
 		return nullptr;
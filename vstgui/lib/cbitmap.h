@@ -31,7 +31,7 @@ public:
 	/** Create an image with a given size and scale factor */
 	CBitmap (CPoint size, double scaleFactor = 1.);
 	explicit CBitmap (const PlatformBitmapPtr& platformBitmap);
-	~CBitmap () noexcept override = default;
+	~CBitmap () noexcept override;
 
 	//-----------------------------------------------------------------------------
 	/// @name CBitmap Methods
@@ -59,6 +59,15 @@ public:
 
 	const_iterator begin () const { return bitmaps.begin (); }
 	const_iterator end () const { return bitmaps.end (); }
+
+	/** get the frames of this bitmap as a vertical film strip with frames of frameHeight */
+	CSpriteAtlas* getSpriteAtlas (CCoord frameHeight);
+
+	/** call after the pixels of the platform bitmaps were changed directly, like drawing into
+	 *	them, so that content derived from them (like the sprite atlas) is updated */
+	void contentChanged () { ++contentRevision; }
+	/** incremented whenever the platform bitmaps or their pixels change */
+	uint32_t getContentRevision () const { return contentRevision; }
 	//@}
 
 //-----------------------------------------------------------------------------
@@ -67,6 +76,10 @@ protected:
 
 	CResourceDescription resourceDesc;
 	BitmapVector bitmaps;
+
+private:
+	SharedPointer<CSpriteAtlas> spriteAtlas;
+	uint32_t contentRevision {0};
 };
 
 //-----------------------------------------------------------------------------
@@ -166,6 +179,21 @@ inline T1 convert (T2 format)
 	return static_cast<T1> (format);
 }
 
+//------------------------------------------------------------------------
+/** Byte positions of the color components in the pixels of a platform pixel accessor */
+inline PixelBuffer::ComponentPositions getComponentPositions (
+	IPlatformBitmapPixelAccess::PixelFormat format)
+{
+	switch (format)
+	{
+		case IPlatformBitmapPixelAccess::kARGB: return {1, 2, 3, 0};
+		case IPlatformBitmapPixelAccess::kRGBA: return {0, 1, 2, 3};
+		case IPlatformBitmapPixelAccess::kABGR: return {3, 2, 1, 0};
+		case IPlatformBitmapPixelAccess::kBGRA: return {2, 1, 0, 3};
+	}
+	return {0, 1, 2, 3};
+}
+
 //------------------------------------------------------------------------
 // CBitmapPixelAccess
 /// @brief direct pixel access to a CBitmap
@@ -3,12 +3,13 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cbitmapfilter.h"
+#include "blurengine.h"
 #include "cbitmap.h"
 #include "platform/iplatformbitmap.h"
 #include "ccolor.h"
 #include "cgraphicspath.h"
 #include "cgraphicstransform.h"
-#include "malloc.h"
+#include "pixelbuffer.h"
 #include <cassert>
 #include <algorithm>
 #include <memory>
@@ -392,284 +393,138 @@ namespace Standard {
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class BoxBlur : public FilterBase
+class BlurBase : public FilterBase
 {
-public:
-	static IFilter* CreateFunction (IdStringPtr _name)
-	{
-		return new BoxBlur ();
-	}
-
-private:
-	BoxBlur ()
-	: FilterBase ("A Box Blur Filter")
+protected:
+	BlurBase (UTF8StringPtr description)
+	: FilterBase (description)
 	{
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
-		registerProperty (Property::kRadius, BitmapFilter::Property ((int32_t)2));
 		registerProperty (Property::kAlphaChannelOnly, BitmapFilter::Property ((int32_t)0));
 	}
 
-	bool run (bool replace) override
+	/** blur the input bitmap, the radius of the options is scaled by the scale factor of the bitmap */
+	bool runBlur (bool replace, BlurEngine::Options options)
 	{
 		CBitmap* inputBitmap = getInputBitmap ();
 		if (inputBitmap == nullptr)
 			return false;
-		const auto& radiusProp = getProperty (Property::kRadius);
-		if (radiusProp.getType () != BitmapFilter::Property::kInteger)
-			return false;
-		uint32_t radius =
-		    static_cast<uint32_t> (static_cast<double> (radiusProp.getInteger ()) *
-		                           inputBitmap->getPlatformBitmap ()->getScaleFactor ());
-		if (radius == UINT_MAX)
+		const auto& alphaChannelOnlyProp = getProperty (Property::kAlphaChannelOnly);
+		if (alphaChannelOnlyProp.getType () != BitmapFilter::Property::kInteger)
 			return false;
-		if (radius < 2)
+		bool alphaChannelOnly = alphaChannelOnlyProp.getInteger () > 0 ? true : false;
+		options.radius *= inputBitmap->getPlatformBitmap ()->getScaleFactor ();
+		if (options.mode == BlurEngine::Mode::Box && options.radius < 1.)
 		{
 			if (replace)
 				return true;
 			return false; // TODO: We should just copy the input bitmap to the output bitmap
 		}
-		const auto& alphaChannelOnlyProp = getProperty (Property::kAlphaChannelOnly);
-		if (alphaChannelOnlyProp.getType () != BitmapFilter::Property::kInteger)
+
+		SharedPointer<CBitmapPixelAccess> inputAccessor = owned (CBitmapPixelAccess::create (inputBitmap));
+		if (inputAccessor == nullptr)
 			return false;
-		bool alphaChannelOnly = alphaChannelOnlyProp.getInteger () > 0 ? true : false;
+		SharedPointer<CBitmap> outputBitmap;
+		SharedPointer<CBitmapPixelAccess> outputAccessor;
 		if (replace)
 		{
-			SharedPointer<CBitmapPixelAccess> inputAccessor = owned (CBitmapPixelAccess::create (inputBitmap));
-			if (inputAccessor == nullptr)
-				return false;
-			run (*inputAccessor, *inputAccessor, radius, alphaChannelOnly);
-			return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (inputBitmap));
+			outputBitmap = inputBitmap;
+			outputAccessor = inputAccessor;
 		}
-		SharedPointer<CBitmap> outputBitmap = owned (new CBitmap (inputBitmap->getWidth (), inputBitmap->getHeight ()));
-		if (outputBitmap)
+		else
 		{
-			SharedPointer<CBitmapPixelAccess> inputAccessor = owned (CBitmapPixelAccess::create (inputBitmap));
-			SharedPointer<CBitmapPixelAccess> outputAccessor = owned (CBitmapPixelAccess::create (outputBitmap));
-			if (inputAccessor == nullptr || outputAccessor == nullptr)
+			outputBitmap = owned (new CBitmap (inputBitmap->getWidth (), inputBitmap->getHeight ()));
+			outputAccessor = owned (CBitmapPixelAccess::create (outputBitmap));
+			if (outputAccessor == nullptr)
+				return false;
+			if (!copyPixels (*inputAccessor, *outputAccessor))
 				return false;
-
-			run (*inputAccessor, *outputAccessor, radius, alphaChannelOnly);
-			return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
 		}
-		return false;
+		auto pixelAccess = outputAccessor->getPlatformBitmapPixelAccess ();
+		if (alphaChannelOnly)
+			options.planeMask = 1u << getComponentPositions (pixelAccess->getPixelFormat ()).alpha;
+		engine.run (pixelAccess->getAddress (), pixelAccess->getBytesPerRow (),
+		            outputAccessor->getBitmapWidth (), outputAccessor->getBitmapHeight (), options);
+		return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
 	}
 
-	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor, uint32_t radius, bool alphaChannelOnly)
+	static bool copyPixels (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
 	{
-		auto inputPbpa = inputAccessor.getPlatformBitmapPixelAccess ();
-		auto outputPbpa = outputAccessor.getPlatformBitmapPixelAccess ();
-		auto inputAddressPtr = inputPbpa->getAddress ();
-		auto outputAddressPtr = outputPbpa->getAddress ();
-		auto width = inputPbpa->getBytesPerRow () / 4;
-		auto height = inputAccessor.getBitmapHeight ();
-		if (alphaChannelOnly)
-		{
-			switch (inputPbpa->getPixelFormat ())
-			{
-				case IPlatformBitmapPixelAccess::kARGB:
-				case IPlatformBitmapPixelAccess::kABGR:
-				{
-					algo<true, false, false, false> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
-					break;
-				}
-				case IPlatformBitmapPixelAccess::kRGBA:
-				case IPlatformBitmapPixelAccess::kBGRA:
-				{
-					algo<false, false, false, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
-					break;
-				}
-			}
-		
-		}
-		else
+		auto input = inputAccessor.getPlatformBitmapPixelAccess ();
+		auto output = outputAccessor.getPlatformBitmapPixelAccess ();
+		if (input->getPixelFormat () != output->getPixelFormat () ||
+		    inputAccessor.getBitmapWidth () != outputAccessor.getBitmapWidth () ||
+		    inputAccessor.getBitmapHeight () != outputAccessor.getBitmapHeight ())
+			return false;
+		auto rowBytes = inputAccessor.getBitmapWidth () * 4;
+		for (auto y = 0u; y < inputAccessor.getBitmapHeight (); ++y)
 		{
-			algo<true, true, true, true> (inputAddressPtr, outputAddressPtr, width, height, static_cast<int32_t> (radius / 2));
+			memcpy (output->getAddress () + y * output->getBytesPerRow (),
+			        input->getAddress () + y * input->getBytesPerRow (), rowBytes);
 		}
+		return true;
 	}
 
-	Buffer<uint8_t> pc0;
-	Buffer<uint8_t> pc1;
-	Buffer<uint8_t> pc2;
-	Buffer<uint8_t> pc3;
-	Buffer<int32_t> vMin;
-	Buffer<int32_t> vMax;
-	Buffer<uint8_t> dv;
+	BlurEngine engine;
+};
 
-	template<bool plane0, bool plane1, bool plane2, bool plane3>
-	void algo (uint8_t* inPixel, uint8_t* outPixel, int32_t width, int32_t height, int32_t radius)
+//----------------------------------------------------------------------------------------------------
+class BoxBlur : public BlurBase
+{
+public:
+	static IFilter* CreateFunction (IdStringPtr _name)
 	{
-		vstgui_assert (radius > 0);
-
-		constexpr int32_t pos0 = 0;
-		constexpr int32_t pos1 = 1;
-		constexpr int32_t pos2 = 2;
-		constexpr int32_t pos3 = 3;
-		constexpr int32_t numComponents = 4;
-
-		int32_t wm = width - 1;
-		int32_t hm = height - 1;
-		int32_t areaSize = width * height;
-		int32_t div = radius + radius + 1;
-		
-		if (plane0)
-			pc0.allocate (areaSize);
-		if (plane1)
-			pc1.allocate (areaSize);
-		if (plane2)
-			pc2.allocate (areaSize);
-		if (plane3)
-			pc3.allocate (areaSize);
-		vMin.allocate (std::max (width, height));
-		vMax.allocate (std::max (width, height));
-		dv.allocate (256 * div);
-
-		for (auto i = 0u; i < dv.size (); ++i)
-			dv[i] = (i / div);
-
-		int32_t sum0, sum1, sum2, sum3;
-		for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
-		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius; i <= radius; i++)
-			{
-				auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
-				if (plane0)
-					sum0 += inPixel[p + pos0];
-				if (plane1)
-					sum1 += inPixel[p + pos1];
-				if (plane2)
-					sum2 += inPixel[p + pos2];
-				if (plane3)
-					sum3 += inPixel[p + pos3];
-			}
-			if (y == 0)
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					vMin[x] = std::min (x + radius + 1, wm);
-					vMax[x] = std::max (x - radius, 0);
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
-			}
-			else
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
-			}
-		}
+		return new BoxBlur ();
+	}
 
-		sum0 = sum1 = sum2 = sum3 = 0;
-		for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-		{
-			auto yi = std::max (0, yp);
-			if (plane0)
-				sum0 += pc0[yi];
-			if (plane1)
-				sum1 += pc1[yi];
-			if (plane2)
-				sum2 += pc2[yi];
-			if (plane3)
-				sum3 += pc3[yi];
-		}
-		for (auto y = 0, yi = 0; y < height; ++y, yi += width)
-		{
-			auto pos = yi * numComponents;
-			if (plane0)
-				outPixel[pos + pos0] = dv[sum0];
-			if (plane1)
-				outPixel[pos + pos1] = dv[sum1];
-			if (plane2)
-				outPixel[pos + pos2] = dv[sum2];
-			if (plane3)
-				outPixel[pos + pos3] = dv[sum3];
-			vMin[y] = std::min (y + radius + 1, hm) * width;
-			vMax[y] = std::max (y - radius, 0) * width;
-			auto p1 = vMin[y];
-			auto p2 = vMax[y];
-			if (plane0)
-				sum0 += pc0[p1] - pc0[p2];
-			if (plane1)
-				sum1 += pc1[p1] - pc1[p2];
-			if (plane2)
-				sum2 += pc2[p1] - pc2[p2];
-			if (plane3)
-				sum3 += pc3[p1] - pc3[p2];
-		}
+private:
+	BoxBlur ()
+	: BlurBase ("A Box Blur Filter")
+	{
+		registerProperty (Property::kRadius, BitmapFilter::Property ((int32_t)2));
+	}
 
-		for (auto x = 1; x < width; ++x)
-		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-			{
-				auto yi = std::max (0, yp) + x;
-				if (plane0)
-					sum0 += pc0[yi];
-				if (plane1)
-					sum1 += pc1[yi];
-				if (plane2)
-					sum2 += pc2[yi];
-				if (plane3)
-					sum3 += pc3[yi];
-			}
-			for (auto y = 0, yi = x; y < height; ++y, yi += width)
-			{
-				auto pos = yi * numComponents;
-				if (plane0)
-					outPixel[pos + pos0] = dv[sum0];
-				if (plane1)
-					outPixel[pos + pos1] = dv[sum1];
-				if (plane2)
-					outPixel[pos + pos2] = dv[sum2];
-				if (plane3)
-					outPixel[pos + pos3] = dv[sum3];
-				auto p1 = x + vMin[y];
-				auto p2 = x + vMax[y];
-				if (plane0)
-					sum0 += pc0[p1] - pc0[p2];
-				if (plane1)
-					sum1 += pc1[p1] - pc1[p2];
-				if (plane2)
-					sum2 += pc2[p1] - pc2[p2];
-				if (plane3)
-					sum3 += pc3[p1] - pc3[p2];
-			}
-		}
+	bool run (bool replace) override
+	{
+		const auto& radiusProp = getProperty (Property::kRadius);
+		if (radiusProp.getType () != BitmapFilter::Property::kInteger)
+			return false;
+		auto radius = radiusProp.getInteger ();
+		if (radius < 0)
+			return false;
+		BlurEngine::Options options;
+		options.mode = BlurEngine::Mode::Box;
+		// the radius property is the size of the box
+		options.radius = static_cast<double> (radius) / 2.;
+		return runBlur (replace, options);
+	}
+};
+
+//----------------------------------------------------------------------------------------------------
+class GaussianBlur : public BlurBase
+{
+public:
+	static IFilter* CreateFunction (IdStringPtr _name)
+	{
+		return new GaussianBlur ();
+	}
+
+private:
+	GaussianBlur ()
+	: BlurBase ("A Gaussian Blur Filter")
+	{
+		registerProperty (Property::kRadius, BitmapFilter::Property (2.));
+	}
+
+	bool run (bool replace) override
+	{
+		const auto& radiusProp = getProperty (Property::kRadius);
+		if (radiusProp.getType () != BitmapFilter::Property::kFloat || radiusProp.getFloat () <= 0.)
+			return false;
+		BlurEngine::Options options;
+		options.mode = BlurEngine::Mode::Gaussian;
+		options.radius = radiusProp.getFloat ();
+		return runBlur (replace, options);
 	}
 };
 
@@ -834,14 +689,72 @@ private:
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-using SimpleFilterProcessFunction = void (*) (CColor& color, FilterBase* self);
+/** a filter which processes every pixel independently of the other pixels, so that it can be run
+	row by row together with other row filters */
+class RowFilter : public FilterBase
+{
+public:
+	/** read the properties, must be called before processRow */
+	virtual bool prepare () { return true; }
+	virtual void processRow (const PixelBuffer::ComponentPositions& positions, const uint8_t* src,
+	                         uint8_t* dst, uint32_t width) = 0;
+
+	/** run the filters in the order of the list on every row of input and write the result to output */
+	static void processRows (const std::vector<RowFilter*>& filters,
+	                         CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
+	{
+		auto input = inputAccessor.getPlatformBitmapPixelAccess ();
+		auto output = outputAccessor.getPlatformBitmapPixelAccess ();
+		if (input->getPixelFormat () != output->getPixelFormat ())
+		{
+			// copy the pixels via the color accessors and process the output in place
+			inputAccessor.setPosition (0, 0);
+			outputAccessor.setPosition (0, 0);
+			CColor color;
+			do
+			{
+				inputAccessor.getColor (color);
+				outputAccessor.setColor (color);
+			}
+			while (++inputAccessor && ++outputAccessor);
+			processRows (filters, outputAccessor, outputAccessor);
+			return;
+		}
+		auto positions = getComponentPositions (input->getPixelFormat ());
+		auto width = std::min (inputAccessor.getBitmapWidth (), outputAccessor.getBitmapWidth ());
+		auto height = std::min (inputAccessor.getBitmapHeight (), outputAccessor.getBitmapHeight ());
+		const uint8_t* src = input->getAddress ();
+		uint8_t* dst = output->getAddress ();
+		for (auto y = 0u; y < height; ++y)
+		{
+			// the first filter reads the input, the following process the output row while it is
+			// still in the cache
+			const uint8_t* rowSrc = src;
+			for (auto filter : filters)
+			{
+				filter->processRow (positions, rowSrc, dst, width);
+				rowSrc = dst;
+			}
+			src += input->getBytesPerRow ();
+			dst += output->getBytesPerRow ();
+		}
+	}
+
+protected:
+	RowFilter (UTF8StringPtr description) : FilterBase (description) {}
+};
+
+//----------------------------------------------------------------------------------------------------
+using SimpleFilterProcessFunction = void (*) (const PixelBuffer::ComponentPositions& positions,
+											  const uint8_t* src, uint8_t* dst, uint32_t width,
+											  FilterBase* self);
 
 template<typename SimpleFilterProcessFunction>
-class SimpleFilter : public FilterBase
+class SimpleFilter : public RowFilter
 {
 protected:
 	SimpleFilter (UTF8StringPtr description, SimpleFilterProcessFunction function)
-	: FilterBase (description)
+	: RowFilter (description)
 	, processFunction (function)
 	{
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
@@ -849,6 +762,8 @@ protected:
 
 	bool run (bool replace) override
 	{
+		if (!prepare ())
+			return false;
 		SharedPointer<CBitmap> inputBitmap = getInputBitmap ();
 		if (inputBitmap == nullptr)
 			return false;
@@ -871,36 +786,14 @@ protected:
 			outputBitmap = inputBitmap;
 			outputAccessor = inputAccessor;
 		}
-		run (*inputAccessor, *outputAccessor);
+		processRows ({this}, *inputAccessor, *outputAccessor);
 		return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
 	}
 
-	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
+	void processRow (const PixelBuffer::ComponentPositions& positions, const uint8_t* src,
+	                 uint8_t* dst, uint32_t width) override
 	{
-		inputAccessor.setPosition (0, 0);
-		outputAccessor.setPosition (0, 0);
-		CColor color;
-		if (&inputAccessor == &outputAccessor)
-		{
-			do
-			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-			}
-			while (++inputAccessor);
-		}
-		else
-		{
-			do
-			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-				++outputAccessor;
-			}
-			while (++inputAccessor);
-		}
+		processFunction (positions, src, dst, width, this);
 	}
 
 	SimpleFilterProcessFunction processFunction;
@@ -925,18 +818,17 @@ private:
 		registerProperty (Property::kInputColor, BitmapFilter::Property (kWhiteCColor));
 	}
 
-	static void processSetColor (CColor& color, FilterBase* obj)
+	static void processSetColor (const PixelBuffer::ComponentPositions& positions,
+								 const uint8_t* src, uint8_t* dst, uint32_t width, FilterBase* obj)
 	{
 		SetColor* filter = static_cast<SetColor*> (obj);
-		if (filter->ignoreAlpha)
-			filter->inputColor.alpha = color.alpha;
-		color = filter->inputColor;
+		PixelBuffer::setColor (positions, src, dst, width, filter->inputColor, filter->ignoreAlpha);
 	}
 
 	bool ignoreAlpha;
 	CColor inputColor;
 
-	bool run (bool replace) override
+	bool prepare () override
 	{
 		const auto& inputColorProp = getProperty (Property::kInputColor);
 		const auto& ignoreAlphaProp = getProperty (Property::kIgnoreAlphaColorValue);
@@ -945,7 +837,7 @@ private:
 			return false;
 		inputColor = inputColorProp.getColor ();
 		ignoreAlpha = ignoreAlphaProp.getInteger () > 0;
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return true;
 	}
 };
 
@@ -966,9 +858,10 @@ private:
 	{
 	}
 
-	static void processGrayscale (CColor& color, FilterBase* obj)
+	static void processGrayscale (const PixelBuffer::ComponentPositions& positions,
+								  const uint8_t* src, uint8_t* dst, uint32_t width, FilterBase* obj)
 	{
-		color.red = color.green = color.blue = color.getLuma ();
+		PixelBuffer::grayscale (positions, src, dst, width);
 	}
 
 };
@@ -992,17 +885,18 @@ private:
 		registerProperty (Property::kOutputColor, BitmapFilter::Property (kTransparentCColor));
 	}
 
-	static void processReplace (CColor& color, FilterBase* obj)
+	static void processReplace (const PixelBuffer::ComponentPositions& positions,
+								const uint8_t* src, uint8_t* dst, uint32_t width, FilterBase* obj)
 	{
 		ReplaceColor* filter = static_cast<ReplaceColor*> (obj);
-		if (color == filter->inputColor)
-			color = filter->outputColor;
+		PixelBuffer::replaceColor (positions, src, dst, width, filter->inputColor,
+								   filter->outputColor);
 	}
 
 	CColor inputColor;
 	CColor outputColor;
 
-	bool run (bool replace) override
+	bool prepare () override
 	{
 		const auto& inputColorProp = getProperty (Property::kInputColor);
 		const auto& outputColorProp = getProperty (Property::kOutputColor);
@@ -1011,7 +905,7 @@ private:
 			return false;
 		inputColor = inputColorProp.getColor ();
 		outputColor = outputColorProp.getColor ();
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return true;
 	}
 };
 
@@ -1021,6 +915,7 @@ private:
 void registerStandardFilters (Factory& factory)
 {
 	factory.registerFilter (kBoxBlur, BoxBlur::CreateFunction);
+	factory.registerFilter (kGaussianBlur, GaussianBlur::CreateFunction);
 	factory.registerFilter (kSetColor, SetColor::CreateFunction);
 	factory.registerFilter (kGrayscale, Grayscale::CreateFunction);
 	factory.registerFilter (kReplaceColor, ReplaceColor::CreateFunction);
@@ -1032,4 +927,71 @@ void registerStandardFilters (Factory& factory)
 
 ///@endcond
 
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+void Pipeline::addFilter (IFilter* filter)
+{
+	if (filter)
+		filters.emplace_back (filter);
+}
+
+//----------------------------------------------------------------------------------------------------
+SharedPointer<CBitmap> Pipeline::run (CBitmap* inputBitmap)
+{
+	if (inputBitmap == nullptr || inputBitmap->getPlatformBitmap () == nullptr)
+		return nullptr;
+	SharedPointer<CBitmap> current = inputBitmap;
+	// the first filter creates a new bitmap, which the following filters may change in place
+	bool ownsCurrent = false;
+	std::vector<Standard::RowFilter*> rowFilters;
+	for (auto it = filters.begin (); it != filters.end ();)
+	{
+		rowFilters.clear ();
+		for (; it != filters.end (); ++it)
+		{
+			auto rowFilter = dynamic_cast<Standard::RowFilter*> (it->get ());
+			if (rowFilter == nullptr)
+				break;
+			if (rowFilter->prepare ())
+				rowFilters.emplace_back (rowFilter);
+		}
+		if (!rowFilters.empty ())
+		{
+			auto inputAccessor = owned (CBitmapPixelAccess::create (current));
+			if (inputAccessor == nullptr)
+				return nullptr;
+			if (ownsCurrent)
+			{
+				Standard::RowFilter::processRows (rowFilters, *inputAccessor, *inputAccessor);
+			}
+			else
+			{
+				auto outputBitmap = makeOwned<CBitmap> (current->getWidth (), current->getHeight ());
+				auto outputAccessor = owned (CBitmapPixelAccess::create (outputBitmap));
+				if (outputAccessor == nullptr)
+					return nullptr;
+				Standard::RowFilter::processRows (rowFilters, *inputAccessor, *outputAccessor);
+				current = outputBitmap;
+				ownsCurrent = true;
+			}
+			continue;
+		}
+		auto& filter = *it;
+		++it;
+		filter->setProperty (Standard::Property::kInputBitmap, current.get ());
+		if (!(ownsCurrent && filter->run (true)) && !filter->run (false))
+			continue;
+		auto obj = filter->getProperty (Standard::Property::kOutputBitmap).getObject ();
+		if (auto outputBitmap = dynamic_cast<CBitmap*> (obj))
+		{
+			current = outputBitmap;
+			ownsCurrent = true;
+		}
+		// release the reference to the input bitmap
+		filter->setProperty (Standard::Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
+	}
+	return ownsCurrent ? current : nullptr;
+}
+
 }} // namespaces
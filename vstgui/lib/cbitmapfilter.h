@@ -117,10 +117,24 @@ namespace Standard {
 		Properties:
 			- Property::kInputBitmap
 			- Property::kRadius
+			- Property::kAlphaChannelOnly
 			- Property::kOutputBitmap
 	*/
 	static const IdStringPtr kBoxBlur = "Box Blur";
 
+	/** Gaussian Blur Filter Name.
+
+		Applies a gaussian blur on the input bitmap. Property::kRadius is the standard deviation
+		as Property::kFloat.
+
+		Properties:
+			- Property::kInputBitmap
+			- Property::kRadius
+			- Property::kAlphaChannelOnly
+			- Property::kOutputBitmap
+	*/
+	static const IdStringPtr kGaussianBlur = "Gaussian Blur";
+
 	/** Grayscale Filter Name.
 	 
 		Produces a grayscale version of the input bitmap.
@@ -204,6 +218,27 @@ namespace Standard {
 
 } // Standard
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Runs a chain of filters on a bitmap
+/// @details Consecutive standard filters which change every pixel on its own (set color,
+/// grayscale and replace color) are run together in one pass over the pixels. Only the first
+/// filter creates a new bitmap, the following filters change it in place if they support it.
+//----------------------------------------------------------------------------------------------------
+class Pipeline
+{
+public:
+	void addFilter (IFilter* filter);
+	bool empty () const { return filters.empty (); }
+
+	/** run the filters on the input bitmap
+	 *	@return the filtered bitmap or nullptr if no filter succeeded, the input bitmap is not changed
+	 */
+	SharedPointer<CBitmap> run (CBitmap* inputBitmap);
+
+private:
+	std::vector<SharedPointer<IFilter>> filters;
+};
+
 //----------------------------------------------------------------------------------------------------
 /// @brief A Base Class for Implementing Bitmap Filters
 /// @ingroup new_in_4_1
@@ -41,14 +41,27 @@ public:
 	CRect getRowBounds (int32_t row);
 	void invalidateRow (int32_t row);
 
+	struct Column
+	{
+		/** left position relative to the view including the lines of the previous columns */
+		CCoord left;
+		CCoord width;
+	};
+	const std::vector<Column>& getColumns ();
+	void invalidateColumns () { columnsValid = false; }
+
 	bool getCell (const CPoint& where, CDataBrowser::Cell& cell);
 
 	bool drawFocusOnTop () override;
 	bool getFocusPath (CGraphicsPath& outPath) override;
 protected:
 
+	CCoord getLineWidth () const;
+
 	IDataBrowserDelegate* db;
 	CDataBrowser* browser;
+	std::vector<Column> columns;
+	bool columnsValid {false};
 };
 
 //-----------------------------------------------------------------------------------------------
@@ -241,6 +254,7 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 	CCoord allRowsHeight = rowHeight * numRows;
 	if (style & kDrawRowLines)
 		allRowsHeight += numRows * lineWidth;
+	dbView->invalidateColumns ();
 	CCoord allColumnsWidth = 0;
 	for (int32_t i = 0; i < numColumns; i++)
 		allColumnsWidth += db->dbGetCurrentColumnWidth (i, this);
@@ -378,24 +392,20 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 		index = numRows-1;
 
 	bool hasChanged = true;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), index);
-	if (alreadySelected != selection.end ())
-	{
-		selection.erase (alreadySelected);
-		hasChanged = !selection.empty ();
-	}
+	if (isRowSelected (index))
+		hasChanged = selection.size () > 1;
 	else
-	{
 		invalidateRow (index);
-	}
 	
 	for (auto row : selection)
 	{
-		dbView->invalidateRow (row);
+		if (row != index)
+			dbView->invalidateRow (row);
 	}
-	selection.clear ();
+	clearSelection ();
 	
 	selection.emplace_back (index);
+	setRowSelectedState (index, true);
 	if (hasChanged)
 		db->dbSelectionChanged (this);
 	
@@ -411,17 +421,45 @@ int32_t CDataBrowser::getSelectedRow () const
 	return kNoSelection;
 }
 
+//-----------------------------------------------------------------------------------------------
+bool CDataBrowser::isRowSelected (int32_t row) const
+{
+	return row >= 0 && static_cast<size_t> (row) < selectedRows.size () && selectedRows[row];
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::setRowSelectedState (int32_t row, bool state)
+{
+	if (row < 0)
+		return;
+	if (static_cast<size_t> (row) >= selectedRows.size ())
+	{
+		if (!state)
+			return;
+		selectedRows.resize (static_cast<size_t> (row) + 1, false);
+	}
+	selectedRows[row] = state;
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::clearSelection ()
+{
+	for (auto row : selection)
+		setRowSelectedState (row, false);
+	selection.clear ();
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::selectRow (int32_t row)
 {
-	if (row > db->dbGetNumRows (this))
+	if (row < 0 || row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected == selection.end ())
+	if (!isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
 			selection.emplace_back (row);
+			setRowSelectedState (row, true);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -437,12 +475,12 @@ void CDataBrowser::unselectRow (int32_t row)
 {
 	if (row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
-			selection.erase (alreadySelected);
+			selection.erase (std::find (selection.begin (), selection.end (), row));
+			setRowSelectedState (row, false);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -462,7 +500,7 @@ void CDataBrowser::unselectAll ()
 		{
 			dbView->invalidateRow (row);
 		}
-		selection.clear ();
+		clearSelection ();
 		db->dbSelectionChanged (this);
 	}
 }
@@ -470,20 +508,13 @@ void CDataBrowser::unselectAll ()
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::validateSelection ()
 {
-	bool selectionChanged = false;
 	int32_t numRows = db->dbGetNumRows (this);
-	for (Selection::iterator it = selection.begin (); it != selection.end ();)
-	{
-		if (*it >= numRows)
-		{
-			it = selection.erase (it);
-			selectionChanged = true;
-		}
-		else
-		{
-			++it;
-		}
-	}
+	auto it = std::remove_if (selection.begin (), selection.end (),
+	                          [&] (int32_t row) { return row >= numRows; });
+	bool selectionChanged = it != selection.end ();
+	selection.erase (it, selection.end ());
+	if (selectedRows.size () > static_cast<size_t> (std::max<int32_t> (numRows, 0)))
+		selectedRows.resize (static_cast<size_t> (std::max<int32_t> (numRows, 0)));
 	if (selectionChanged)
 		db->dbSelectionChanged (this);
 }
@@ -505,16 +536,11 @@ CRect CDataBrowser::getCellBounds (const Cell& cell)
 	if (style & kDrawRowLines)
 		rowHeight += lineWidth;
 	CRect result (0, rowHeight * cell.row, 0, rowHeight * (cell.row+1));
-	for (int32_t i = 0; i <= cell.column; i++)
+	const auto& columns = dbView->getColumns ();
+	if (cell.column >= 0 && static_cast<size_t> (cell.column) < columns.size ())
 	{
-		CCoord colWidth = db->dbGetCurrentColumnWidth (i, this);
-		if (i != cell.column)
-		{
-			result.offset (colWidth, 0);
-			if (style & kDrawColumnLines)
-				result.offset (lineWidth, 0);
-		}
-		result.setWidth (colWidth);
+		result.left = columns[cell.column].left;
+		result.setWidth (columns[cell.column].width);
 	}
 	CRect viewSize = dbView->getViewSize ();
 	result.offset (viewSize.left, viewSize.top);
@@ -740,6 +766,38 @@ CDataBrowserView::CDataBrowserView (const CRect& size, IDataBrowserDelegate* db,
 	setWantsFocus (true);
 }
 
+//-----------------------------------------------------------------------------------------------
+CCoord CDataBrowserView::getLineWidth () const
+{
+	CCoord lineWidth = 0;
+	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
+	{
+		CColor lineColor;
+		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
+	}
+	return lineWidth;
+}
+
+//-----------------------------------------------------------------------------------------------
+const std::vector<CDataBrowserView::Column>& CDataBrowserView::getColumns ()
+{
+	int32_t numColumns = db->dbGetNumColumns (browser);
+	if (!columnsValid || columns.size () != static_cast<size_t> (std::max<int32_t> (numColumns, 0)))
+	{
+		CCoord lineWidth = (browser->getStyle () & CDataBrowser::kDrawColumnLines) ? getLineWidth () : 0.;
+		columns.clear ();
+		CCoord left = 0;
+		for (int32_t col = 0; col < numColumns; col++)
+		{
+			CCoord width = db->dbGetCurrentColumnWidth (col, browser);
+			columns.push_back ({left, width});
+			left += width + lineWidth;
+		}
+		columnsValid = true;
+	}
+	return columns;
+}
+
 //-----------------------------------------------------------------------------------------------
 CRect CDataBrowserView::getRowBounds (int32_t row)
 {
@@ -793,58 +851,63 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 	int32_t numRows = db->dbGetNumRows (browser);
 	int32_t numColumns = db->dbGetNumColumns (browser);
 
-	const CDataBrowser::Selection& selection = browser->getSelection ();
+	const auto& columns = getColumns ();
+	const CRect viewSize (getViewSize ());
+
+	// only the rows intersecting the update rect are visited, the rows next to it are included
+	// for the row lines which are drawn centered on the bottom edge of a row
+	int32_t firstRow = 0;
+	int32_t lastRow = numRows;
+	if (rowHeight > 0.)
+	{
+		auto rowAt = [&] (CCoord y) {
+			auto row = std::floor ((y - viewSize.top) / rowHeight);
+			return static_cast<int32_t> (std::max (-1., std::min (row, static_cast<double> (numRows))));
+		};
+		firstRow = std::max<int32_t> (rowAt (updateRect.top) - 1, 0);
+		lastRow = std::min<int32_t> (rowAt (updateRect.bottom) + 2, numRows);
+	}
 
 	CDrawContext::LineList lines;
 
-	CRect r (getViewSize ());
-	r.setHeight (rowHeight - lineWidth);
-	for (int32_t row = 0; row < numRows; row++)
+	for (int32_t row = firstRow; row < lastRow; row++)
 	{
+		CRect r (viewSize.left, viewSize.top + rowHeight * row, viewSize.right, 0);
+		r.setHeight (rowHeight - lineWidth);
 		CRect testRect (r);
 		testRect.bound (updateRect);
 		if (testRect.isEmpty () == false)
 		{
-			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
+			int32_t flags = browser->isRowSelected (row) ? IDataBrowserDelegate::kRowSelected : 0;
 			for (int32_t col = 0; col < numColumns; col++)
 			{
-				CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
-				r.setWidth (columnWidth);
-				testRect = r;
+				CRect cellRect (r);
+				cellRect.left += columns[col].left;
+				if (cellRect.left >= updateRect.right)
+					break;
+				cellRect.setWidth (columns[col].width);
+				testRect = cellRect;
 				testRect.bound (updateRect);
 				if (testRect.isEmpty () == false)
 				{
 					context->setClipRect (testRect);
-					CRect cellSize (r);
-					cellSize.bottom++;
-					cellSize.right++;
-					db->dbDrawCell (context, cellSize, row, col, isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
+					cellRect.bottom++;
+					cellRect.right++;
+					db->dbDrawCell (context, cellRect, row, col, flags, browser);
 				}
-				r.offset (columnWidth, 0);
-				if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-					r.offset (lineWidth, 0);
 			}
 		}
-		r.left = getViewSize ().left;
-		r.setWidth (getWidth ());
 		if (drawRowLines)
 			lines.emplace_back (r.getBottomLeft (), r.getBottomRight ());
-		r.offset (0, rowHeight);
 	}
 	if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
 	{
-		
-		CPoint p1;
-		CPoint p2;
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
+		CPoint p1 (0, viewSize.top);
+		CPoint p2 (0, viewSize.bottom);
+		for (int32_t col = 0; col < numColumns - 1; col++)
 		{
-			p1 (getViewSize ().left - lineWidth, getViewSize ().top);
-			p2 (getViewSize ().left - lineWidth, getViewSize ().bottom);
-			for (int32_t col = 0; col < numColumns - 1; col++)
-			{
-				p1.x = p2.x = p1.x + db->dbGetCurrentColumnWidth (col, browser) + lineWidth;
-				lines.emplace_back (p1, p2);
-			}
+			p1.x = p2.x = viewSize.left + columns[col].left + columns[col].width;
+			lines.emplace_back (p1, p2);
 		}
 	}
 	if (!lines.empty ())
@@ -874,27 +937,23 @@ bool CDataBrowserView::getCell (const CPoint& where, CDataBrowser::Cell& cell)
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
 	}
 	CCoord rowHeight = db->dbGetRowHeight (browser);
-	int32_t numColumns = db->dbGetNumColumns (browser);
 
 	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
 		rowHeight += lineWidth;
 	int32_t rowNum = (int32_t)(_where.y / rowHeight);
-	int32_t colNum = 0;
-	CCoord cw = 0;
-	for (int32_t i = 0; i < numColumns; i++)
-	{
-		cw += db->dbGetCurrentColumnWidth (i, browser);
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-			cw += lineWidth;
-		if (_where.x < cw && rowNum < db->dbGetNumRows (browser) && colNum < db->dbGetNumColumns (browser))
-		{
-			colNum = i;
-			cell.row = rowNum;
-			cell.column = colNum;
-			return true;
-		}
-	}
-	return false;
+	if (rowNum >= db->dbGetNumRows (browser))
+		return false;
+	const auto& columns = getColumns ();
+	if (!(browser->getStyle () & CDataBrowser::kDrawColumnLines))
+		lineWidth = 0;
+	auto it = std::find_if (columns.begin (), columns.end (), [&] (const Column& column) {
+		return _where.x < column.left + column.width + lineWidth;
+	});
+	if (it == columns.end ())
+		return false;
+	cell.row = rowNum;
+	cell.column = static_cast<int32_t> (it - columns.begin ());
+	return true;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -905,7 +964,7 @@ CMouseEventResult CDataBrowserView::onMouseDown (CPoint &where, const CButtonSta
 	if (getCell (where, cell))
 	{
 		const CDataBrowser::Selection& selection = browser->getSelection ();
-		bool alreadySelected = std::find (selection.begin (), selection.end (), cell.row) != selection.end ();
+		bool alreadySelected = browser->isRowSelected (cell.row);
 		if (browser->getStyle () & CDataBrowser::kMultiSelectionStyle)
 		{
 			if (buttons.getModifierState () == kControl)
@@ -66,7 +66,7 @@ public:
 	/// @name CDataBrowser Methods
 	//-----------------------------------------------------------------------------
 	//@{
-	/** trigger recalculation, call if numRows or numColumns changed */
+	/** trigger recalculation, call if numRows, numColumns or the column widths changed */
 	virtual void recalculateLayout (bool rememberSelection = false);
 	/** invalidates an individual cell */
 	virtual void invalidate (const Cell& cell);
@@ -87,6 +87,8 @@ public:
 
 	/** get all selected rows */
 	const Selection& getSelection () const { return selection; }
+	/** check if row is selected */
+	bool isRowSelected (int32_t row) const;
 	/** add row to selection */
 	virtual void selectRow (int32_t row);
 	/** remove row from selection */
@@ -117,12 +119,16 @@ protected:
 
 	void recalculateSubViews () override;
 	void validateSelection ();
+	void setRowSelectedState (int32_t row, bool state);
+	void clearSelection ();
 
 	IDataBrowserDelegate* db;
 	CDataBrowserView* dbView;
 	CDataBrowserHeader* dbHeader;
 	CViewContainer* dbHeaderContainer;
 	Selection selection;
+	/** selection state per row for constant time lookups */
+	std::vector<bool> selectedRows;
 };
 
 //-----------------------------------------------------------------------------
@@ -5,105 +5,332 @@
 #pragma once
 
 #include "crect.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace VSTGUI {
 
 //-----------------------------------------------------------------------------
+/** List of invalid rectangles
+ *
+ *	Added rectangles are coalesced: a rectangle already covered by the list is dropped, rectangles
+ *	covered by a new one are removed and two rectangles are joined when their union does not cover
+ *	more area than both rectangles together.
+ *
+ *	To keep the cost of an insert bounded the rectangles are additionally indexed in a grid of
+ *	tiles, so that only the rectangles near the new one need to be checked. Rectangles spanning
+ *	too many tiles are kept in a separate list which is always checked.
+ *
+ *	Note that erasing a rectangle moves the last rectangle of the list to its position.
+ */
 struct CInvalidRectList
 {
 	using RectList = std::vector<CRect>;
 
 	bool add (const CRect& r);
+	/** join rectangles with the same horizontal or vertical extent which are not further apart
+	 *	than maxDistance */
+	void joinNearby (CCoord maxDistance);
 
 	RectList::iterator begin () { return list.begin (); }
 	RectList::iterator end () { return list.end (); }
 	RectList::const_iterator begin () const { return list.begin (); }
 	RectList::const_iterator end () const { return list.end (); }
 
-	void erase (RectList::iterator it) { list.erase (it); }
+	void erase (RectList::iterator it) { removeAt (static_cast<Index> (it - list.begin ())); }
 
-	void clear () { list.clear (); }
+	void clear ();
 	const RectList& data () const { return list; }
+	size_t size () const { return list.size (); }
+
+	static constexpr CCoord kTileSize = 64.;
+	static constexpr int32_t kMaxTilesPerRect = 64;
 
 private:
+	using Index = uint32_t;
+	using IndexList = std::vector<Index>;
+	using TileMap = std::unordered_map<uint64_t, IndexList>;
+
+	struct TileRange
+	{
+		int32_t left;
+		int32_t top;
+		int32_t right;
+		int32_t bottom;
+
+		int64_t numTiles () const
+		{
+			return (static_cast<int64_t> (right) - left + 1) *
+				   (static_cast<int64_t> (bottom) - top + 1);
+		}
+		bool isLarge () const { return numTiles () > kMaxTilesPerRect; }
+	};
+
+	static TileRange tileRange (const CRect& r);
+	static uint64_t tileKey (int32_t x, int32_t y);
+	static bool canJoin (const CRect& r1, const CRect& r2, CCoord maxDistance);
+
+	void insertIndex (Index index);
+	void replaceIndex (const CRect& r, Index oldIndex, Index newIndex);
+	void removeAt (Index index);
+	void rebuildIndex ();
+	const IndexList& collectCandidates (const CRect& r, bool scanAll);
+
+	static constexpr Index kNoIndex = ~Index (0);
+
 	RectList list;
+	TileMap tiles;
+	IndexList largeRects;
+	IndexList candidates;
 };
 
 //-----------------------------------------------------------------------------
-inline bool CInvalidRectList::add (const CRect& r)
+inline CInvalidRectList::TileRange CInvalidRectList::tileRange (const CRect& r)
+{
+	static constexpr CCoord kTileLimit = 1 << 20;
+	auto toTile = [] (CCoord c) {
+		auto t = std::floor (c / kTileSize);
+		return static_cast<int32_t> (std::min (std::max (t, -kTileLimit), kTileLimit));
+	};
+	// the range is inclusive so that rectangles touching each other share a tile
+	return {toTile (std::min (r.left, r.right)), toTile (std::min (r.top, r.bottom)),
+			toTile (std::max (r.left, r.right)), toTile (std::max (r.top, r.bottom))};
+}
+
+//-----------------------------------------------------------------------------
+inline uint64_t CInvalidRectList::tileKey (int32_t x, int32_t y)
+{
+	return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) |
+		   static_cast<uint64_t> (static_cast<uint32_t> (y));
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::insertIndex (Index index)
+{
+	auto range = tileRange (list[index]);
+	if (range.isLarge ())
+	{
+		largeRects.emplace_back (index);
+		return;
+	}
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+			tiles[tileKey (x, y)].emplace_back (index);
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::replaceIndex (const CRect& r, Index oldIndex, Index newIndex)
 {
-	for (auto it = list.begin (), end = list.end (); it != end; ++it)
+	auto replace = [&] (IndexList& indices) {
+		auto it = std::find (indices.begin (), indices.end (), oldIndex);
+		if (it == indices.end ())
+			return;
+		if (newIndex == kNoIndex)
+			indices.erase (it);
+		else
+			*it = newIndex;
+	};
+	auto range = tileRange (r);
+	if (range.isLarge ())
 	{
-		// the same rectangle is already in the list
-		if (*it == r)
-			return false;
-		// the new rectangle is part of one already in the list
-		if (it->rectInside (r))
-			return false;
-		// if the new rectangle contains one of the previous rectangles
-		if (r.rectInside (*it))
+		replace (largeRects);
+		return;
+	}
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
 		{
-			list.erase (it);
-			return add (r);
+			auto it = tiles.find (tileKey (x, y));
+			if (it != tiles.end ())
+				replace (it->second);
 		}
-		// now check if the combined rect has the same or less area as both rects together
-		auto area1 = r.getWidth () * r.getHeight ();
-		auto area2 = it->getWidth () * it->getHeight ();
-		CRect jr (*it);
-		jr.unite (r);
-		auto joinedArea = jr.getWidth () * jr.getHeight ();
-		if (joinedArea <= (area1 + area2))
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::removeAt (Index index)
+{
+	auto lastIndex = static_cast<Index> (list.size () - 1);
+	replaceIndex (list[index], index, kNoIndex);
+	if (index != lastIndex)
+	{
+		replaceIndex (list[lastIndex], lastIndex, index);
+		list[index] = list[lastIndex];
+	}
+	list.pop_back ();
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::rebuildIndex ()
+{
+	for (auto& tile : tiles)
+		tile.second.clear ();
+	largeRects.clear ();
+	for (Index i = 0, count = static_cast<Index> (list.size ()); i < count; ++i)
+		insertIndex (i);
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::clear ()
+{
+	list.clear ();
+	// keep the allocated tiles, the same areas are usually invalidated in the next frame again
+	for (auto& tile : tiles)
+		tile.second.clear ();
+	largeRects.clear ();
+}
+
+//-----------------------------------------------------------------------------
+inline auto CInvalidRectList::collectCandidates (const CRect& r, bool scanAll) -> const IndexList&
+{
+	candidates.clear ();
+	auto range = tileRange (r);
+	if (scanAll || range.isLarge ())
+	{
+		for (Index i = 0, count = static_cast<Index> (list.size ()); i < count; ++i)
+			candidates.emplace_back (i);
+		return candidates;
+	}
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
 		{
-			list.erase (it);
-			return add (jr);
+			auto it = tiles.find (tileKey (x, y));
+			if (it != tiles.end ())
+				candidates.insert (candidates.end (), it->second.begin (), it->second.end ());
 		}
 	}
-	list.emplace_back (r);
-	return true;
+	candidates.insert (candidates.end (), largeRects.begin (), largeRects.end ());
+	// check the candidates in list order
+	std::sort (candidates.begin (), candidates.end ());
+	candidates.erase (std::unique (candidates.begin (), candidates.end ()), candidates.end ());
+	return candidates;
 }
 
 //-----------------------------------------------------------------------------
-inline void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance)
+inline bool CInvalidRectList::add (const CRect& r)
 {
-	for (auto it = list.begin (); it != list.end (); ++it)
+	CRect rect (r);
+	// two rectangles can only be joined when they overlap or touch each other, except for
+	// empty ones which may be joined with other empty ones on the same line
+	auto scanAll = rect.isEmpty ();
+	bool restart = true;
+	while (restart)
 	{
-		for (auto it2 = list.begin (); it2 != list.end (); ++it2)
+		restart = false;
+		for (auto index : collectCandidates (rect, scanAll))
 		{
-			if (it2 == it)
-				continue;
-			if (it->left == it2->left && it->right == it2->right)
+			const auto& other = list[index];
+			// the same rectangle is already in the list
+			if (other == rect)
+				return false;
+			// the new rectangle is part of one already in the list
+			if (other.rectInside (rect))
+				return false;
+			// if the new rectangle contains one of the previous rectangles
+			if (rect.rectInside (other))
+			{
+				removeAt (index);
+				restart = true;
+				break;
+			}
+			// now check if the combined rect has the same or less area as both rects together
+			auto area1 = rect.getWidth () * rect.getHeight ();
+			auto area2 = other.getWidth () * other.getHeight ();
+			CRect jr (other);
+			jr.unite (rect);
+			auto joinedArea = jr.getWidth () * jr.getHeight ();
+			if (joinedArea <= (area1 + area2))
 			{
-				CCoord distance;
-				if (it->bottom < it2->top)
-					distance = it2->top - it->bottom;
-				else
-					distance = it->top - it2->bottom;
-				if (distance <= maxDistance)
-				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
-				}
+				removeAt (index);
+				rect = jr;
+				restart = true;
+				break;
 			}
-			if (it->top == it2->top && it->bottom == it2->bottom)
+		}
+	}
+	list.emplace_back (rect);
+	insertIndex (static_cast<Index> (list.size () - 1));
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+inline bool CInvalidRectList::canJoin (const CRect& r1, const CRect& r2, CCoord maxDistance)
+{
+	if (r1.left == r2.left && r1.right == r2.right)
+	{
+		auto distance = r1.bottom < r2.top ? r2.top - r1.bottom : r1.top - r2.bottom;
+		if (distance <= maxDistance)
+			return true;
+	}
+	if (r1.top == r2.top && r1.bottom == r2.bottom)
+	{
+		auto distance = r1.right < r2.left ? r2.left - r1.right : r1.left - r2.right;
+		if (distance <= maxDistance)
+			return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::joinNearby (CCoord maxDistance)
+{
+	if (list.size () < 2)
+		return;
+	auto extent = std::max (maxDistance, 0.);
+	// joined rectangles are only marked as removed and the list is compacted at the end, so that
+	// the indices stay valid while iterating
+	std::vector<bool> removed (list.size (), false);
+	bool didJoin = false;
+	for (Index index = 0, count = static_cast<Index> (list.size ()); index < count; ++index)
+	{
+		if (removed[index])
+			continue;
+		bool joined = true;
+		while (joined)
+		{
+			joined = false;
+			CRect searchRect (list[index]);
+			searchRect.extend (extent, extent);
+			for (auto other : collectCandidates (searchRect, false))
 			{
-				CCoord distance;
-				if (it->right < it2->left)
-					distance = it2->left - it->right;
-				else
-					distance = it->left - it2->right;
-				if (distance <= maxDistance)
-				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
-				}
+				if (other == index || removed[other])
+					continue;
+				if (!canJoin (list[index], list[other], maxDistance))
+					continue;
+				CRect joinedRect (list[index]);
+				joinedRect.unite (list[other]);
+				replaceIndex (list[other], other, kNoIndex);
+				removed[other] = true;
+				replaceIndex (list[index], index, kNoIndex);
+				list[index] = joinedRect;
+				insertIndex (index);
+				joined = didJoin = true;
+				break;
 			}
 		}
 	}
+	if (!didJoin)
+		return;
+	Index newIndex = 0;
+	for (Index index = 0, count = static_cast<Index> (list.size ()); index < count; ++index)
+	{
+		if (!removed[index])
+			list[newIndex++] = list[index];
+	}
+	list.resize (newIndex);
+	rebuildIndex ();
+}
+
+//-----------------------------------------------------------------------------
+inline void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance)
+{
+	list.joinNearby (maxDistance);
 }
 
 //-----------------------------------------------------------------------------
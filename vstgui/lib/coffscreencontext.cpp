@@ -45,6 +45,13 @@ SharedPointer<COffscreenContext> COffscreenContext::create (const CPoint& size,
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+void COffscreenContext::endDraw ()
+{
+	if (bitmap)
+		bitmap->contentChanged ();
+}
+
 //-----------------------------------------------------------------------------
 CCoord COffscreenContext::getWidth () const
 {
@@ -75,6 +75,9 @@ public:
 
 	CBitmap* getBitmap () const { return bitmap; }
 
+	/** marks the content of the bitmap as changed */
+	void endDraw () override;
+
 protected:
 	explicit COffscreenContext (CBitmap* bitmap);
 	explicit COffscreenContext (const CRect& surfaceRect);
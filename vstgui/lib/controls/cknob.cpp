@@ -7,8 +7,11 @@
 #include "../cdrawcontext.h"
 #include "../cframe.h"
 #include "../cgraphicspath.h"
+#include "../cspriteatlas.h"
 #include "../cvstguitimer.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace VSTGUI {
 #if TARGET_OS_IPHONE
@@ -399,6 +402,77 @@ The handle describes a circle over the background (between -45deg and +225deg).
 By clicking alt modifier and left mouse button the default value is used.
 By clicking alt modifier and left mouse button the value changes with a vertical move (version 2.1)
 */
+//------------------------------------------------------------------------
+/** Retained arc paths of a CKnob
+ *
+ *	The paths are keyed on their geometry, so that a change of the view size, the angles or the
+ *	insets results in a new path without the need to invalidate the cache in every setter. The
+ *	corona value is quantized to steps of 1/8 point along the arc, so that redrawing a knob with an
+ *	unchanged or a recently used value replays a path already built by the platform.
+ */
+struct CKnob::PathCache
+{
+	static constexpr CCoord kCoronaStepsPerPoint = 8.;
+	static constexpr size_t kMaxCoronaPaths = 16;
+
+	struct Key
+	{
+		CRect rect;
+		double startAngle;
+		double sweepAngle;
+
+		bool operator== (const Key& other) const
+		{
+			return rect == other.rect && startAngle == other.startAngle &&
+				   sweepAngle == other.sweepAngle;
+		}
+	};
+
+	struct Entry
+	{
+		Key key;
+		SharedPointer<CGraphicsPath> path;
+	};
+	using EntryList = std::vector<Entry>;
+
+	static float quantizeValue (float value, const CRect& r, float rangeAngle);
+	static CGraphicsPath* getArc (CDrawContext* context, EntryList& entries, size_t maxEntries,
+								  const Key& key);
+
+	EntryList outline;
+	EntryList corona;
+};
+
+//------------------------------------------------------------------------
+float CKnob::PathCache::quantizeValue (float value, const CRect& r, float rangeAngle)
+{
+	auto arcLength = std::abs (rangeAngle) * std::max (r.getWidth (), r.getHeight ()) / 2.;
+	auto steps = std::max (1., std::ceil (arcLength * kCoronaStepsPerPoint));
+	return static_cast<float> (std::round (value * steps) / steps);
+}
+
+//------------------------------------------------------------------------
+CGraphicsPath* CKnob::PathCache::getArc (CDrawContext* context, EntryList& entries,
+										 size_t maxEntries, const Key& key)
+{
+	auto it = std::find_if (entries.begin (), entries.end (),
+							[&] (const Entry& entry) { return entry.key == key; });
+	if (it != entries.end ())
+	{
+		// most recently used entry last
+		std::rotate (it, it + 1, entries.end ());
+		return entries.back ().path;
+	}
+	auto path = owned (context->createGraphicsPath ());
+	if (path == nullptr)
+		return nullptr;
+	addArc (path, key.rect, key.startAngle, key.sweepAngle);
+	if (entries.size () >= maxEntries)
+		entries.erase (entries.begin ());
+	entries.push_back ({key, path});
+	return path;
+}
+
 //------------------------------------------------------------------------
 /**
  * CKnob constructor.
@@ -462,6 +536,14 @@ CKnob::~CKnob () noexcept
 		pHandle->forget ();
 }
 
+//------------------------------------------------------------------------
+auto CKnob::getPathCache () const -> PathCache&
+{
+	if (!pathCache)
+		pathCache = std::unique_ptr<PathCache> (new PathCache);
+	return *pathCache;
+}
+
 //------------------------------------------------------------------------
 bool CKnob::drawFocusOnTop ()
 {
@@ -529,9 +611,6 @@ void CKnob::addArc (CGraphicsPath* path, const CRect& r, double startAngle, doub
 //------------------------------------------------------------------------
 void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 {
-	auto path = owned (pContext->createGraphicsPath ());
-	if (path == nullptr)
-		return;
 	CRect corona (getViewSize ());
 	corona.inset (coronaInset, coronaInset);
 	auto start = startAngle;
@@ -542,7 +621,9 @@ void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 		start -= a;
 		range += a * 2.f;
 	}
-	addArc (path, corona, start, range);
+	auto path = PathCache::getArc (pContext, getPathCache ().outline, 1, {corona, start, range});
+	if (path == nullptr)
+		return;
 	pContext->setFrameColor (colorShadowHandle);
 	CLineStyle lineStyle (kLineSolid);
 	if (!(drawStyle & kCoronaLineCapButt))
@@ -556,23 +637,36 @@ void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 //------------------------------------------------------------------------
 void CKnob::drawCorona (CDrawContext* pContext) const
 {
-	auto path = owned (pContext->createGraphicsPath ());
-	if (path == nullptr)
-		return;
 	float coronaValue = getValueNormalized ();
 	if (drawStyle & kCoronaInverted)
 		coronaValue = 1.f - coronaValue;
 	CRect corona (getViewSize ());
 	corona.inset (coronaInset, coronaInset);
+	coronaValue = PathCache::quantizeValue (coronaValue, corona, rangeAngle);
+	PathCache::Key key;
+	key.rect = corona;
 	if (drawStyle & kCoronaFromCenter)
-		addArc (path, corona, 1.5 * Constants::pi, rangeAngle * (coronaValue - 0.5));
+	{
+		key.startAngle = 1.5 * Constants::pi;
+		key.sweepAngle = rangeAngle * (coronaValue - 0.5);
+	}
 	else
 	{
 		if (drawStyle & kCoronaInverted)
-			addArc (path, corona, startAngle + rangeAngle, -rangeAngle * coronaValue);
+		{
+			key.startAngle = startAngle + rangeAngle;
+			key.sweepAngle = -rangeAngle * coronaValue;
+		}
 		else
-			addArc (path, corona, startAngle, rangeAngle * coronaValue);
+		{
+			key.startAngle = startAngle;
+			key.sweepAngle = rangeAngle * coronaValue;
+		}
 	}
+	auto path = PathCache::getArc (pContext, getPathCache ().corona, PathCache::kMaxCoronaPaths,
+								   key);
+	if (path == nullptr)
+		return;
 	pContext->setFrameColor (coronaColor);
 	if (!(drawStyle & kCoronaLineCapButt))
 	{
@@ -857,7 +951,8 @@ void CAnimKnob::draw (CDrawContext *pContext)
 			where.y -= (int32_t)where.y % (int32_t)heightOfOneImage;
 		}
 
-		getDrawBackground ()->draw (pContext, getViewSize (), where);
+		CSpriteAtlas::draw (getDrawBackground (), heightOfOneImage, pContext, getViewSize (),
+							where);
 	}
 	setDirty (false);
 }
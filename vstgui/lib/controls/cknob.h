@@ -7,6 +7,7 @@
 #include "ccontrol.h"
 #include "../ccolor.h"
 #include "../clinestyle.h"
+#include <memory>
 
 namespace VSTGUI {
 
@@ -146,6 +147,12 @@ protected:
 
 	CLineStyle coronaLineStyle;
 	CBitmap* pHandle;
+
+private:
+	struct PathCache;
+	PathCache& getPathCache () const;
+
+	mutable std::unique_ptr<PathCache> pathCache;
 };
 
 //-----------------------------------------------------------------------------
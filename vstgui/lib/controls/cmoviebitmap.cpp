@@ -5,6 +5,7 @@
 #include "cmoviebitmap.h"
 #include "../cdrawcontext.h"
 #include "../cbitmap.h"
+#include "../cspriteatlas.h"
 
 namespace VSTGUI {
 
@@ -79,7 +80,7 @@ void CMovieBitmap::draw (CDrawContext *pContext)
 			where.y += heightOfOneImage * step;
 		}
 
-		bitmap->draw (pContext, getViewSize (), where);
+		CSpriteAtlas::draw (bitmap, heightOfOneImage, pContext, getViewSize (), where);
 	}
 	setDirty (false);
 }
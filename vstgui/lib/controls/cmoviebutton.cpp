@@ -5,6 +5,7 @@
 #include "cmoviebutton.h"
 #include "../cdrawcontext.h"
 #include "../cbitmap.h"
+#include "../cspriteatlas.h"
 
 namespace VSTGUI {
 
@@ -71,7 +72,8 @@ void CMovieButton::draw (CDrawContext *pContext)
 
 	if (getDrawBackground ())
 	{
-		getDrawBackground ()->draw (pContext, getViewSize (), where);
+		CSpriteAtlas::draw (getDrawBackground (), heightOfOneImage, pContext, getViewSize (),
+							where);
 	}
 	buttonState = value;
 
@@ -4,11 +4,10 @@
 
 #include "cshadowviewcontainer.h"
 #include "coffscreencontext.h"
-#include "cbitmapfilter.h"
+#include "blurengine.h"
 #include "cframe.h"
 #include "cbitmap.h"
 #include <cassert>
-#include <array>
 
 namespace VSTGUI {
 
@@ -49,6 +48,7 @@ bool CShadowViewContainer::removed (CView* parent)
 {
 	getFrame ()->unregisterScaleFactorChangedListeneer (this);
 	setBackground (nullptr);
+	blurEngine = nullptr;
 	return CViewContainer::removed (parent);
 }
 
@@ -115,23 +115,6 @@ CMessageResult CShadowViewContainer::notify (CBaseObject* sender, IdStringPtr me
 	return CViewContainer::notify(sender, message);
 }
 
-//-----------------------------------------------------------------------------
-template <size_t numBoxes>
-static std::array<int32_t, numBoxes> boxesForGauss (double sigma)
-{
-	std::array<int32_t, numBoxes> boxes;
-	double ideal = std::sqrt ((12 * sigma * sigma / numBoxes) + 1);
-	uint16_t l = static_cast<uint16_t> (std::floor (ideal));
-	if (l % 2 == 0)
-		l--;
-	int32_t u = l + 2;
-	ideal = ((12. * sigma * sigma) - (numBoxes * l * l) - (4. * numBoxes * l) - (3. * numBoxes)) / ((-4. * l) - 4.);
-	int32_t m = static_cast<int32_t> (std::floor (ideal));
-	for (int32_t i = 0; i < numBoxes; ++i)
-		boxes[i] = (i < m ? l : u);
-	return boxes;
-}
-
 //-----------------------------------------------------------------------------
 static bool isUniformScaled (const CGraphicsTransform& matrix)
 {
@@ -167,32 +150,7 @@ void CShadowViewContainer::drawRect (CDrawContext* pContext, const CRect& update
 			if (bitmap)
 			{
 				setBackground (bitmap);
-				SharedPointer<BitmapFilter::IFilter> setColorFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kSetColor));
-				if (setColorFilter)
-				{
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputColor, kBlackCColor);
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kIgnoreAlphaColorValue, (int32_t)1);
-					if (setColorFilter->run (true))
-					{
-						SharedPointer<BitmapFilter::IFilter> boxBlurFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kBoxBlur));
-						if (boxBlurFilter)
-						{
-							auto boxSizes = boxesForGauss<3> (shadowBlurSize);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[0]);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kAlphaChannelOnly, 1);
-							if (boxBlurFilter->run (true))
-							{
-								boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[1]);
-								boxBlurFilter->run (true);
-								boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[2]);
-								boxBlurFilter->run (true);
-							}
-						}
-					}
-				}
-
+				createShadow (bitmap, scaleFactor);
 				CViewContainer::drawRect (pContext, updateRect);
 			}
 		}
@@ -203,6 +161,32 @@ void CShadowViewContainer::drawRect (CDrawContext* pContext, const CRect& update
 	}
 }
 
+//-----------------------------------------------------------------------------
+void CShadowViewContainer::createShadow (CBitmap* bitmap, double scaleFactor)
+{
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	if (!accessor)
+		return;
+	auto pixelAccess = accessor->getPlatformBitmapPixelAccess ();
+	auto positions = getComponentPositions (pixelAccess->getPixelFormat ());
+	auto width = accessor->getBitmapWidth ();
+	auto height = accessor->getBitmapHeight ();
+	for (auto y = 0u; y < height; ++y)
+	{
+		auto row = pixelAccess->getAddress () + y * pixelAccess->getBytesPerRow ();
+		PixelBuffer::setColor (positions, row, row, width, kBlackCColor, true);
+	}
+	// the engine is kept, so that rebuilding the shadow while resizing does not allocate
+	if (!blurEngine)
+		blurEngine = std::unique_ptr<BitmapFilter::BlurEngine> (new BitmapFilter::BlurEngine);
+	BitmapFilter::BlurEngine::Options options;
+	options.mode = BitmapFilter::BlurEngine::Mode::Gaussian;
+	options.radius = shadowBlurSize * scaleFactor;
+	options.planeMask = 1u << positions.alpha;
+	blurEngine->run (pixelAccess->getAddress (), pixelAccess->getBytesPerRow (), width, height,
+					 options);
+}
+
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::drawBackgroundRect (CDrawContext* pContext, const CRect& _updateRect)
 {
@@ -215,6 +199,13 @@ void CShadowViewContainer::drawBackgroundRect (CDrawContext* pContext, const CRe
 	}
 }
 
+//-----------------------------------------------------------------------------
+bool CShadowViewContainer::isOpaque () const
+{
+	// the background is drawn with the shadow intensity as alpha
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::setViewSize (const CRect& rect, bool invalid)
 {
@@ -7,8 +7,10 @@
 #include "cviewcontainer.h"
 #include "iviewlistener.h"
 #include "iscalefactorchangedlistener.h"
+#include <memory>
 
 namespace VSTGUI {
+namespace BitmapFilter { class BlurEngine; }
 
 //-----------------------------------------------------------------------------
 // CShadowViewContainer Declaration
@@ -46,6 +48,7 @@ public:
 	bool attached (CView* parent) override;
 	void drawRect (CDrawContext* pContext, const CRect& updateRect) override;
 	void drawBackgroundRect (CDrawContext* pContext, const CRect& _updateRect) override;
+	bool isOpaque () const override;
 	void setViewSize (const CRect& rect, bool invalid = true) override;
 	CMessageResult notify (CBaseObject* sender, IdStringPtr message) override;
 
@@ -58,12 +61,14 @@ protected:
 	void viewContainerViewZOrderChanged (CViewContainer* container, CView* view) override;
 
 	void beforeDelete () override;
+	void createShadow (CBitmap* bitmap, double scaleFactor);
 
 	bool dontDrawBackground;
 	CPoint shadowOffset;
 	float shadowIntensity;
 	double shadowBlurSize;
 	double scaleFactorUsed;
+	std::unique_ptr<BitmapFilter::BlurEngine> blurEngine;
 };
 
 } // VSTGUI
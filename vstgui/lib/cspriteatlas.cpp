@@ -0,0 +1,226 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cspriteatlas.h"
+#include "cbitmap.h"
+#include "cdrawcontext.h"
+#include "platform/iplatformbitmap.h"
+#include "platform/platformfactory.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+void CSpriteAtlas::draw (CBitmap* filmStrip, CCoord frameHeight, CDrawContext* context,
+						 const CRect& rect, const CPoint& offset, float alpha)
+{
+	// bitmaps with their own drawing like nine part tiled bitmaps are not sliced
+	auto isPlainBitmap = dynamic_cast<CNinePartTiledBitmap*> (filmStrip) == nullptr;
+	if (isPlainBitmap && frameHeight > 0. && offset.y >= 0. && offset.x >= 0.)
+	{
+		auto index = static_cast<uint32_t> (std::floor (offset.y / frameHeight));
+		CPoint frameOffset (offset.x, offset.y - index * frameHeight);
+		if (frameOffset.y + rect.getHeight () <= frameHeight)
+		{
+			// the same scale factor the draw context uses to choose the platform bitmap
+			auto scaleFactor = context->getScaleFactor ();
+			const auto& t = context->getCurrentTransform ();
+			if (t.m11 == t.m22 && t.m12 == 0 && t.m21 == 0)
+				scaleFactor *= t.m11;
+			if (auto atlas = filmStrip->getSpriteAtlas (frameHeight))
+			{
+				if (auto frame = atlas->getFrame (index, scaleFactor))
+				{
+					frame->draw (context, rect, frameOffset, alpha);
+					return;
+				}
+			}
+		}
+	}
+	filmStrip->draw (context, rect, offset, alpha);
+}
+
+//------------------------------------------------------------------------
+/** Least recently drawn list of all sliced atlases, to bound their memory usage globally */
+class CSpriteAtlas::Registry
+{
+public:
+	static Registry& instance ()
+	{
+		static Registry gInstance;
+		return gInstance;
+	}
+
+	void setMemoryLimit (size_t bytes)
+	{
+		memoryLimit = bytes;
+		evict (0);
+	}
+	size_t getMemoryLimit () const { return memoryLimit; }
+	size_t getMemoryUsage () const { return memoryUsage; }
+
+	void add (CSpriteAtlas* atlas)
+	{
+		evict (atlas->memorySize);
+		atlases.push_front (atlas);
+		atlas->position = atlases.begin ();
+		atlas->registered = true;
+		memoryUsage += atlas->memorySize;
+	}
+
+	void touch (CSpriteAtlas* atlas)
+	{
+		atlases.splice (atlases.begin (), atlases, atlas->position);
+	}
+
+	void remove (CSpriteAtlas* atlas)
+	{
+		atlases.erase (atlas->position);
+		atlas->registered = false;
+		memoryUsage -= atlas->memorySize;
+	}
+
+private:
+	void evict (size_t requiredSize)
+	{
+		while (!atlases.empty () && memoryUsage + requiredSize > memoryLimit)
+		{
+			// sliced again when it is drawn the next time
+			auto atlas = atlases.back ();
+			atlas->releaseFrames ();
+			atlas->sliced = false;
+		}
+	}
+
+	std::list<CSpriteAtlas*> atlases;
+	size_t memoryUsage {0};
+	size_t memoryLimit {32 * 1024 * 1024};
+};
+
+//------------------------------------------------------------------------
+void CSpriteAtlas::setMemoryLimit (size_t bytes)
+{
+	Registry::instance ().setMemoryLimit (bytes);
+}
+
+//------------------------------------------------------------------------
+size_t CSpriteAtlas::getMemoryLimit ()
+{
+	return Registry::instance ().getMemoryLimit ();
+}
+
+//------------------------------------------------------------------------
+size_t CSpriteAtlas::getMemoryUsage ()
+{
+	return Registry::instance ().getMemoryUsage ();
+}
+
+//------------------------------------------------------------------------
+CSpriteAtlas::CSpriteAtlas (CBitmap* filmStrip, CCoord frameHeight)
+: filmStrip (filmStrip), frameHeight (frameHeight)
+{
+}
+
+//------------------------------------------------------------------------
+CSpriteAtlas::~CSpriteAtlas () noexcept
+{
+	releaseFrames ();
+}
+
+//------------------------------------------------------------------------
+uint32_t CSpriteAtlas::getNumFrames () const
+{
+	if (frameHeight <= 0.)
+		return 0;
+	return static_cast<uint32_t> (std::floor (filmStrip->getHeight () / frameHeight));
+}
+
+//------------------------------------------------------------------------
+CBitmap* CSpriteAtlas::getFrame (uint32_t index, double scaleFactor)
+{
+	auto source = filmStrip->getBestPlatformBitmapForScaleFactor (scaleFactor);
+	if (!sliced || source.get () != slicedBitmap ||
+		filmStrip->getContentRevision () != slicedRevision)
+	{
+		releaseFrames ();
+		sliced = true;
+		slicedBitmap = source.get ();
+		slicedRevision = filmStrip->getContentRevision ();
+		if (source && slice (source))
+			Registry::instance ().add (this);
+		else
+			releaseFrames ();
+	}
+	else if (registered)
+	{
+		Registry::instance ().touch (this);
+	}
+	return index < frames.size () ? frames[index].get () : nullptr;
+}
+
+//------------------------------------------------------------------------
+void CSpriteAtlas::releaseFrames ()
+{
+	if (registered)
+		Registry::instance ().remove (this);
+	frames.clear ();
+	memorySize = 0;
+}
+
+//------------------------------------------------------------------------
+bool CSpriteAtlas::slice (IPlatformBitmap* source)
+{
+	auto numFrames = getNumFrames ();
+	if (numFrames == 0)
+		return false;
+	// a frame must start at a pixel row of the film strip
+	auto scaleFactor = source->getScaleFactor ();
+	auto pixelFrameHeight = frameHeight * scaleFactor;
+	if (pixelFrameHeight != std::floor (pixelFrameHeight))
+		return false;
+	auto rows = static_cast<uint32_t> (pixelFrameHeight);
+	auto width = source->getSize ().x;
+	memorySize = static_cast<size_t> (width) * rows * numFrames * 4;
+	if (memorySize > Registry::instance ().getMemoryLimit ())
+	{
+		// checked again on the next draw, the limit may have been raised
+		sliced = false;
+		return false;
+	}
+
+	frames.resize (numFrames);
+	auto sourceAccess = source->lockPixels (true);
+	if (!sourceAccess)
+		return false;
+	for (auto index = 0u; index < numFrames; ++index)
+	{
+		auto platformBitmap = getPlatformFactory ().createBitmap (CPoint (width, rows));
+		if (!platformBitmap)
+			return false;
+		platformBitmap->setScaleFactor (scaleFactor);
+		{
+			auto frameAccess = platformBitmap->lockPixels (true);
+			if (!frameAccess ||
+				frameAccess->getPixelFormat () != sourceAccess->getPixelFormat ())
+				return false;
+			auto rowSize = std::min (frameAccess->getBytesPerRow (),
+									 sourceAccess->getBytesPerRow ());
+			auto src = sourceAccess->getAddress () +
+					   index * rows * sourceAccess->getBytesPerRow ();
+			auto dst = frameAccess->getAddress ();
+			for (auto row = 0u; row < rows; ++row)
+			{
+				std::memcpy (dst, src, rowSize);
+				src += sourceAccess->getBytesPerRow ();
+				dst += frameAccess->getBytesPerRow ();
+			}
+		}
+		frames[index] = makeOwned<CBitmap> (platformBitmap);
+	}
+	return true;
+}
+
+} // VSTGUI
@@ -0,0 +1,71 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include <list>
+#include <vector>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+/** Frames of a vertical film strip bitmap
+ *
+ *	CAnimKnob, CMovieBitmap and CMovieButton draw one frame of a tall film strip bitmap by
+ *	drawing the whole bitmap with an offset into a clipped rectangle. The sprite atlas slices the
+ *	film strip once into a bitmap per frame (with a platform bitmap for every scale factor of the
+ *	film strip), so that drawing a frame is a plain blit of a small surface.
+ *
+ *	Only the platform bitmap of the film strip used for the scale factor of the draw context is
+ *	sliced, and the memory of all atlases is bound globally (see setMemoryLimit): the least
+ *	recently drawn atlases release their frames and slice again when they are drawn the next time.
+ *
+ *	The atlas of a bitmap is obtained via CBitmap::getSpriteAtlas. It is sliced again when the
+ *	content revision of the film strip changes, see CBitmap::contentChanged.
+ */
+class CSpriteAtlas : public AtomicReferenceCounted
+{
+public:
+	/** draw the part of filmStrip at offset into rect.
+	 *
+	 *	Uses the frame bitmap if the drawn part lies within one frame, otherwise or if the film
+	 *	strip cannot be sliced, the film strip is drawn as is.
+	 */
+	static void draw (CBitmap* filmStrip, CCoord frameHeight, CDrawContext* context,
+					  const CRect& rect, const CPoint& offset, float alpha = 1.f);
+
+	/** set the maximum memory in bytes used by the frames of all sprite atlases */
+	static void setMemoryLimit (size_t bytes);
+	static size_t getMemoryLimit ();
+	static size_t getMemoryUsage ();
+
+	CSpriteAtlas (CBitmap* filmStrip, CCoord frameHeight);
+	~CSpriteAtlas () noexcept override;
+
+	CCoord getFrameHeight () const { return frameHeight; }
+	uint32_t getNumFrames () const;
+
+	/** bitmap of frame index sliced from the platform bitmap of the film strip best matching
+	 *	scaleFactor, nullptr if the film strip could not be sliced */
+	CBitmap* getFrame (uint32_t index, double scaleFactor = 1.);
+
+private:
+	class Registry;
+
+	bool slice (IPlatformBitmap* source);
+	void releaseFrames ();
+
+	CBitmap* filmStrip;
+	CCoord frameHeight;
+	std::vector<SharedPointer<CBitmap>> frames;
+	const IPlatformBitmap* slicedBitmap {nullptr};
+	uint32_t slicedRevision {0};
+	size_t memorySize {0};
+	std::list<CSpriteAtlas*>::iterator position;
+	bool sliced {false};
+	bool registered {false};
+};
+
+} // VSTGUI
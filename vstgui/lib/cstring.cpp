@@ -177,7 +177,11 @@ void UTF8String::copy (UTF8StringBuffer dst, SizeType dstSize) const noexcept
 #if WINDOWS
 	strncpy_s (dst, dstSize, string.data (), _TRUNCATE);
 #elif LINUX
-	strncpy (dst, string.data (), dstSize);
+	if (dstSize == 0)
+		return;
+	// like strlcpy, dst is always zero terminated
+	strncpy (dst, string.data (), dstSize - 1);
+	dst[dstSize - 1] = 0;
 #else
 	strlcpy (dst, string.data (), dstSize);
 #endif
@@ -373,6 +373,13 @@ void CTabView::drawBackgroundRect (CDrawContext *pContext, const CRect& _updateR
 	pContext->setClipRect (oldClip);
 }
 
+//-----------------------------------------------------------------------------
+bool CTabView::isOpaque () const
+{
+	// the background is not drawn behind the tab buttons
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 void CTabView::valueChanged (CControl *pControl)
 {
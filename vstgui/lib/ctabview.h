@@ -69,6 +69,7 @@ public:
 	//@}
 
 	void drawBackgroundRect (CDrawContext *pContext, const CRect& _updateRect) override;
+	bool isOpaque () const override;
 	void valueChanged (CControl *pControl) override;
 	void setViewSize (const CRect &rect, bool invalid = true) override;
 	void setAutosizeFlags (int32_t flags) override;
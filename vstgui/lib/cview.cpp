@@ -280,6 +280,8 @@ void CView::setMouseableArea (const CRect& rect)
 		setViewFlag (kHasMouseableArea, true);
 		setAttribute (kCViewMouseableAreaAttrID, rect);
 	}
+	if (auto container = pImpl->parentView ? pImpl->parentView->asViewContainer () : nullptr)
+		container->childGeometryChanged (this);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -715,7 +717,11 @@ void CView::setViewSize (const CRect& newSize, bool doInvalid)
 		if (doInvalid)
 			setDirty ();
 		if (getParentView ())
+		{
+			if (auto container = getParentView ()->asViewContainer ())
+				container->childGeometryChanged (this);
 			getParentView ()->notify (this, kMsgViewSizeChanged);
+		}
 		if (pImpl->viewListeners)
 		{
 			pImpl->viewListeners->forEach (
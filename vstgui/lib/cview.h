@@ -257,6 +257,9 @@ public:
 	virtual void setTransparency (bool val);
 	/** get views transparent state */
 	bool getTransparency () const { return hasViewFlag (kTransparencyEnabled); }
+	/** returns true if the view fills its whole view size with opaque pixels when drawn. Views
+	 *	completely covered by opaque siblings are not drawn. */
+	virtual bool isOpaque () const { return false; }
 
 	/** set alpha value which will be applied when drawing this view */
 	virtual void setAlphaValue (float alpha);
@@ -18,6 +18,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -28,6 +32,352 @@ const CViewAttributeID kCViewContainerMouseDownViewAttribute = 'vcmd';
 const CViewAttributeID kCViewContainerLastDrawnFocusAttribute = 'vclf';
 const CViewAttributeID kCViewContainerBackgroundOffsetAttribute = 'vcbo';
 
+//-----------------------------------------------------------------------------
+namespace {
+
+//-----------------------------------------------------------------------------
+/** Opaque areas of the views drawn on top of the current one */
+struct Occluders
+{
+	static constexpr size_t kMaxOccluders = 8;
+
+	bool add (const CRect& r)
+	{
+		if (numRects == kMaxOccluders)
+			return false;
+		rects[numRects++] = r;
+		return true;
+	}
+
+	bool covers (const CRect& r, size_t start = 0) const
+	{
+		for (auto i = start; i < numRects; ++i)
+		{
+			const auto& o = rects[i];
+			if (o.rectInside (r))
+				return true;
+			if (o.left >= r.right || o.right <= r.left || o.top >= r.bottom || o.bottom <= r.top)
+				continue;
+			// the parts of r not covered by o must be covered by the remaining rects
+			CRect parts[] = {
+				{r.left, r.top, r.right, o.top},
+				{r.left, o.bottom, r.right, r.bottom},
+				{r.left, std::max (r.top, o.top), o.left, std::min (r.bottom, o.bottom)},
+				{o.right, std::max (r.top, o.top), r.right, std::min (r.bottom, o.bottom)}
+			};
+			for (const auto& part : parts)
+			{
+				if (!part.isEmpty () && !covers (part, i + 1))
+					return false;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	bool empty () const { return numRects == 0; }
+
+private:
+	CRect rects[kMaxOccluders];
+	size_t numRects {0};
+};
+
+//-----------------------------------------------------------------------------
+void clearDirtyState (CView* view)
+{
+	view->setDirty (false);
+	if (auto container = view->asViewContainer ())
+	{
+		container->forEachChild ([] (CView* child) {
+			if (child->isDirty ())
+				clearDirtyState (child);
+		});
+	}
+}
+
+#if DEBUG
+uint32_t gNumCulledDraws = 0;
+#endif
+
+} // anonymous
+
+///@cond ignore
+namespace CViewContainerDetail {
+
+//-----------------------------------------------------------------------------
+/** Bitmap with the drawing of a container and its children */
+struct RenderCache
+{
+	SharedPointer<CBitmap> bitmap;
+	CPoint size;
+	double scaleFactor {0.};
+	size_t memorySize {0};
+	std::list<RenderCache*>::iterator position;
+};
+
+//-----------------------------------------------------------------------------
+/** Least recently drawn list of all render caches, to bound their memory usage globally */
+class RenderCacheRegistry
+{
+public:
+	static RenderCacheRegistry& instance ()
+	{
+		static RenderCacheRegistry gInstance;
+		return gInstance;
+	}
+
+	void setMemoryLimit (size_t bytes)
+	{
+		memoryLimit = bytes;
+		evict (0);
+	}
+	size_t getMemoryLimit () const { return memoryLimit; }
+	size_t getMemoryUsage () const { return memoryUsage; }
+
+	void add (RenderCache* cache)
+	{
+		evict (cache->memorySize);
+		caches.push_front (cache);
+		cache->position = caches.begin ();
+		memoryUsage += cache->memorySize;
+	}
+
+	void touch (RenderCache* cache)
+	{
+		caches.splice (caches.begin (), caches, cache->position);
+	}
+
+	void remove (RenderCache* cache)
+	{
+		caches.erase (cache->position);
+		memoryUsage -= cache->memorySize;
+		cache->bitmap = nullptr;
+		cache->memorySize = 0;
+	}
+
+private:
+	void evict (size_t requiredSize)
+	{
+		while (!caches.empty () && memoryUsage + requiredSize > memoryLimit)
+			remove (caches.back ());
+	}
+
+	std::list<RenderCache*> caches;
+	size_t memoryUsage {0};
+	size_t memoryLimit {64 * 1024 * 1024};
+};
+
+//-----------------------------------------------------------------------------
+/** Uniform grid of the mouseable areas of the child views of a container
+ *
+ *	Views covering too many cells are kept in a separate list which is always checked. The
+ *	z-order of the views is stored in the entries and every list is kept sorted by it, so that
+ *	the candidates of a cell can be returned in the same order as the child list by merging the
+ *	cell list with the list of large views.
+ */
+class ViewHitTestIndex
+{
+public:
+	using ViewList = CViewContainer::ViewList;
+
+	static constexpr CCoord kCellSize = 64.;
+	static constexpr int64_t kMaxCellsPerView = 256;
+
+	void build (const ViewList& children)
+	{
+		clear ();
+		for (const auto& view : children)
+			add (view, nextOrder++);
+	}
+
+	void clear ()
+	{
+		for (auto& cell : cells)
+			cell.second.clear ();
+		largeViews.clear ();
+		entries.clear ();
+		nextOrder = 0;
+	}
+
+	void addOnTop (CView* view) { add (view, nextOrder++); }
+
+	void remove (CView* view)
+	{
+		auto it = entries.find (view);
+		if (it == entries.end ())
+			return;
+		removeFromCells (&it->second);
+		entries.erase (it);
+	}
+
+	void update (CView* view)
+	{
+		auto it = entries.find (view);
+		if (it == entries.end ())
+			return;
+		auto area = view->getMouseableArea ();
+		if (area == it->second.area)
+			return;
+		removeFromCells (&it->second);
+		it->second.area = area;
+		addToCells (&it->second);
+	}
+
+	/** renumber the z-order after a view was inserted or moved inside the child list */
+	void updateOrder (const ViewList& children)
+	{
+		nextOrder = 0;
+		for (const auto& view : children)
+		{
+			auto it = entries.find (view);
+			if (it != entries.end ())
+				it->second.order = nextOrder;
+			++nextOrder;
+		}
+		for (auto& cell : cells)
+			sortByOrder (cell.second);
+		sortByOrder (largeViews);
+	}
+
+	/** call proc for the views whose mouseable area may contain where, top to bottom, until proc
+	 *	returns false */
+	template<typename Proc>
+	void forEachCandidate (const CPoint& where, Proc proc) const
+	{
+		auto large = largeViews.rbegin ();
+		auto largeEnd = largeViews.rend ();
+		auto cell = cells.find (cellKey (toCell (where.x), toCell (where.y)));
+		if (cell != cells.end ())
+		{
+			for (auto it = cell->second.rbegin (), end = cell->second.rend (); it != end; ++it)
+			{
+				for (; large != largeEnd && (*large)->order > (*it)->order; ++large)
+				{
+					if (!proc ((*large)->view))
+						return;
+				}
+				if (!proc ((*it)->view))
+					return;
+			}
+		}
+		for (; large != largeEnd; ++large)
+		{
+			if (!proc ((*large)->view))
+				return;
+		}
+	}
+
+private:
+	struct Entry
+	{
+		CView* view;
+		CRect area;
+		uint64_t order;
+	};
+	using EntryList = std::vector<const Entry*>;
+
+	struct CellRange
+	{
+		int32_t left;
+		int32_t top;
+		int32_t right;
+		int32_t bottom;
+
+		int64_t numCells () const
+		{
+			return (static_cast<int64_t> (right) - left + 1) *
+				   (static_cast<int64_t> (bottom) - top + 1);
+		}
+	};
+
+	static int32_t toCell (CCoord c)
+	{
+		static constexpr CCoord kCellLimit = 1 << 20;
+		auto cell = std::floor (c / kCellSize);
+		return static_cast<int32_t> (std::min (std::max (cell, -kCellLimit), kCellLimit));
+	}
+
+	static CellRange cellRange (const CRect& r)
+	{
+		return {toCell (std::min (r.left, r.right)), toCell (std::min (r.top, r.bottom)),
+				toCell (std::max (r.left, r.right)), toCell (std::max (r.top, r.bottom))};
+	}
+
+	static uint64_t cellKey (int32_t x, int32_t y)
+	{
+		return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) |
+			   static_cast<uint64_t> (static_cast<uint32_t> (y));
+	}
+
+	static bool lessOrder (const Entry* e1, const Entry* e2) { return e1->order < e2->order; }
+
+	static void sortByOrder (EntryList& list)
+	{
+		std::sort (list.begin (), list.end (), lessOrder);
+	}
+
+	/** views are mostly added on top, which appends to the end of the list */
+	static void insertByOrder (EntryList& list, const Entry* entry)
+	{
+		list.insert (std::upper_bound (list.begin (), list.end (), entry, lessOrder), entry);
+	}
+
+	void add (CView* view, uint64_t order)
+	{
+		// the entries are node based, so the pointers stored in the cells stay valid
+		auto& entry = entries[view];
+		entry = {view, view->getMouseableArea (), order};
+		addToCells (&entry);
+	}
+
+	void addToCells (const Entry* entry)
+	{
+		auto range = cellRange (entry->area);
+		if (range.numCells () > kMaxCellsPerView)
+		{
+			insertByOrder (largeViews, entry);
+			return;
+		}
+		for (auto y = range.top; y <= range.bottom; ++y)
+		{
+			for (auto x = range.left; x <= range.right; ++x)
+				insertByOrder (cells[cellKey (x, y)], entry);
+		}
+	}
+
+	void removeFromCells (const Entry* entry)
+	{
+		auto remove = [entry] (EntryList& list) {
+			auto it = std::find (list.begin (), list.end (), entry);
+			if (it != list.end ())
+				list.erase (it);
+		};
+		auto range = cellRange (entry->area);
+		if (range.numCells () > kMaxCellsPerView)
+		{
+			remove (largeViews);
+			return;
+		}
+		for (auto y = range.top; y <= range.bottom; ++y)
+		{
+			for (auto x = range.left; x <= range.right; ++x)
+			{
+				auto it = cells.find (cellKey (x, y));
+				if (it != cells.end ())
+					remove (it->second);
+			}
+		}
+	}
+
+	std::unordered_map<CView*, Entry> entries;
+	std::unordered_map<uint64_t, EntryList> cells;
+	EntryList largeViews;
+	uint64_t nextOrder {0};
+};
+
+} // CViewContainerDetail
+///@endcond
+
 //-----------------------------------------------------------------------------
 // CViewContainer Implementation
 //-----------------------------------------------------------------------------
@@ -42,6 +392,53 @@ struct CViewContainer::Impl
 	
 	CDrawStyle backgroundColorDrawStyle {kDrawFilledAndStroked};
 	CColor backgroundColor {kBlackCColor};
+
+	using ViewHitTestIndex = CViewContainerDetail::ViewHitTestIndex;
+	using RenderCache = CViewContainerDetail::RenderCache;
+	using RenderCacheRegistry = CViewContainerDetail::RenderCacheRegistry;
+
+	bool hitTestIndexEnabled {false};
+	/** only exists while the index is enabled and the container is attached */
+	std::unique_ptr<ViewHitTestIndex> hitTestIndex;
+
+	bool opaque {false};
+
+	bool renderCacheEnabled {false};
+	bool drawingIntoRenderCache {false};
+	RenderCache renderCache;
+
+	~Impl () noexcept { dropRenderCache (); }
+
+	void dropRenderCache ()
+	{
+		if (renderCache.bitmap)
+			RenderCacheRegistry::instance ().remove (&renderCache);
+	}
+
+	/** call proc for the child views whose mouseable area contains where, top to bottom, until
+	 *	proc returns false */
+	template<typename Proc>
+	void forEachChildAt (const CPoint& where, Proc proc) const
+	{
+		if (hitTestIndex)
+		{
+			hitTestIndex->forEachCandidate (where, [&] (CView* view) {
+				if (view->getMouseableArea ().pointInside (where))
+					return proc (view);
+				return true;
+			});
+			return;
+		}
+		for (auto it = children.rbegin (), end = children.rend (); it != end; ++it)
+		{
+			const auto& pV = *it;
+			if (pV && pV->getMouseableArea ().pointInside (where))
+			{
+				if (!proc (pV))
+					break;
+			}
+		}
+	}
 };
 
 //------------------------------------------------------------------------
@@ -148,6 +545,9 @@ CViewContainer::CViewContainer (const CViewContainer& v)
 	pImpl->transform = v.getTransform ();
 	pImpl->backgroundColorDrawStyle = v.pImpl->backgroundColorDrawStyle;
 	pImpl->backgroundColor = v.pImpl->backgroundColor;
+	pImpl->hitTestIndexEnabled = v.pImpl->hitTestIndexEnabled;
+	pImpl->opaque = v.pImpl->opaque;
+	pImpl->renderCacheEnabled = v.pImpl->renderCacheEnabled;
 	setBackgroundOffset (v.getBackgroundOffset ());
 	for (auto& view : v.pImpl->children)
 		addView (static_cast<CView*> (view->newCopy ()));
@@ -256,6 +656,7 @@ void CViewContainer::setTransform (const CGraphicsTransform& t)
 	if (getTransform () != t)
 	{
 		pImpl->transform = t;
+		pImpl->dropRenderCache ();
 		pImpl->viewContainerListeners.forEach ([this] (IViewContainerListener* listener) {
 			listener->viewContainerTransformChanged (this);
 		});
@@ -274,6 +675,80 @@ void CViewContainer::setAutosizingEnabled (bool state)
 	setViewFlag (kAutosizeSubviews, state);
 }
 
+//-----------------------------------------------------------------------------
+void CViewContainer::setHitTestIndexEnabled (bool state)
+{
+	if (pImpl->hitTestIndexEnabled == state)
+		return;
+	pImpl->hitTestIndexEnabled = state;
+	if (state && isAttached ())
+	{
+		pImpl->hitTestIndex = std::unique_ptr<Impl::ViewHitTestIndex> (new Impl::ViewHitTestIndex ());
+		pImpl->hitTestIndex->build (pImpl->children);
+	}
+	else
+		pImpl->hitTestIndex = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::isHitTestIndexEnabled () const
+{
+	return pImpl->hitTestIndexEnabled;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::setOpaque (bool state)
+{
+	pImpl->opaque = state;
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::getOpaque () const
+{
+	return pImpl->opaque;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::setRenderCacheEnabled (bool state)
+{
+	if (pImpl->renderCacheEnabled == state)
+		return;
+	pImpl->renderCacheEnabled = state;
+	if (!state)
+		pImpl->dropRenderCache ();
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::isRenderCacheEnabled () const
+{
+	return pImpl->renderCacheEnabled;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::setRenderCacheMemoryLimit (size_t bytes)
+{
+	Impl::RenderCacheRegistry::instance ().setMemoryLimit (bytes);
+}
+
+//-----------------------------------------------------------------------------
+size_t CViewContainer::getRenderCacheMemoryLimit ()
+{
+	return Impl::RenderCacheRegistry::instance ().getMemoryLimit ();
+}
+
+//-----------------------------------------------------------------------------
+size_t CViewContainer::getRenderCacheMemoryUsage ()
+{
+	return Impl::RenderCacheRegistry::instance ().getMemoryUsage ();
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::childGeometryChanged (CView* child)
+{
+	if (pImpl->hitTestIndex)
+		pImpl->hitTestIndex->update (child);
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @param rect the new size of the container
@@ -513,13 +988,21 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 		auto it = std::find (pImpl->children.begin (), pImpl->children.end (), pBefore);
 		vstgui_assert (it != pImpl->children.end ());
 		pImpl->children.insert (it, pView);
+		if (pImpl->hitTestIndex)
+		{
+			pImpl->hitTestIndex->addOnTop (pView);
+			pImpl->hitTestIndex->updateOrder (pImpl->children);
+		}
 	}
 	else
 	{
 		pImpl->children.emplace_back (pView);
+		if (pImpl->hitTestIndex)
+			pImpl->hitTestIndex->addOnTop (pView);
 	}
 
 	pView->setSubviewState (true);
+	pImpl->dropRenderCache ();
 
 	pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 		listener->viewContainerViewAdded (this, pView);
@@ -566,8 +1049,11 @@ bool CViewContainer::removeAll (bool withForget)
 		auto view = *it;
 		if (isAttached ())
 			view->removed (this);
+		if (pImpl->hitTestIndex)
+			pImpl->hitTestIndex->remove (view);
 		pImpl->children.erase (it);
 		view->setSubviewState (false);
+		pImpl->dropRenderCache ();
 		pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 			listener->viewContainerViewRemoved (this, view);
 		});
@@ -594,7 +1080,10 @@ bool CViewContainer::removeView (CView *pView, bool withForget)
 			clearMouseDownView ();
 		if (isAttached ())
 			pView->removed (this);
+		if (pImpl->hitTestIndex)
+			pImpl->hitTestIndex->remove (pView);
 		pView->setSubviewState (false);
+		pImpl->dropRenderCache ();
 		pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 			listener->viewContainerViewRemoved (this, pView);
 		});
@@ -698,6 +1187,9 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 
 			pImpl->children.insert (dest, view);
 			pImpl->children.erase (src);
+			if (pImpl->hitTestIndex)
+				pImpl->hitTestIndex->updateOrder (pImpl->children);
+			pImpl->dropRenderCache ();
 
 			pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 				listener->viewContainerViewZOrderChanged (this, view);
@@ -735,6 +1227,7 @@ bool CViewContainer::invalidateDirtyViews ()
 //-----------------------------------------------------------------------------
 void CViewContainer::invalid ()
 {
+	pImpl->dropRenderCache ();
 	if (!isVisible ())
 		return;
 	CRect _rect (getViewSize ());
@@ -745,6 +1238,7 @@ void CViewContainer::invalid ()
 //-----------------------------------------------------------------------------
 void CViewContainer::invalidRect (const CRect& rect)
 {
+	pImpl->dropRenderCache ();
 	if (!isVisible ())
 		return;
 	CRect _rect (rect);
@@ -809,6 +1303,10 @@ void CViewContainer::drawBackgroundRect (CDrawContext* pContext, const CRect& _u
  */
 void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 {
+	if (pImpl->renderCacheEnabled && !pImpl->drawingIntoRenderCache &&
+		drawRenderCache (pContext, updateRect))
+		return;
+
 	CPoint offset (getViewSize ().left, getViewSize ().top);
 	CDrawContext::Transform offsetTransform (*pContext, CGraphicsTransform ().translate (offset.x, offset.y));
 
@@ -843,10 +1341,40 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 		getTransform ().inverse ().transform (newClip);
 		getTransform ().inverse ().transform (clientRect);
 		getTransform ().transform (oldClip2);
-		
+
+		// find the views which are completely covered by opaque views drawn on top of them
+		std::vector<bool> covered;
+		Occluders occluders;
+		auto index = pImpl->children.size ();
+		for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
+		{
+			--index;
+			const auto& pV = *it;
+			if (!checkUpdateRect (pV, clientRect))
+				continue;
+			CRect viewSize = pV->getViewSize ();
+			viewSize.bound (newClip);
+			if (viewSize.isEmpty ())
+				continue;
+			if (!occluders.empty () && occluders.covers (viewSize))
+			{
+				if (covered.empty ())
+					covered.resize (pImpl->children.size (), false);
+				covered[index] = true;
+			}
+			else if (pV->isOpaque () && pV->getAlphaValue () >= 1.f)
+			{
+				if (!occluders.add (viewSize))
+					break;
+			}
+		}
+
 		// draw each view
+		index = 0;
 		for (const auto& pV : pImpl->children)
 		{
+			auto isCovered = !covered.empty () && covered[index];
+			++index;
 			if (pV->isVisible ())
 			{
 				if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
@@ -872,7 +1400,16 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 					}
 				}
 
-				if (checkUpdateRect (pV, clientRect))
+				if (isCovered)
+				{
+					// the view would be completely overdrawn, but must not stay dirty
+					if (pV->isDirty ())
+						clearDirtyState (pV);
+#if DEBUG
+					++gNumCulledDraws;
+#endif
+				}
+				else if (checkUpdateRect (pV, clientRect))
 				{
 					CRect viewSize = pV->getViewSize ();
 					viewSize.bound (newClip);
@@ -923,6 +1460,81 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 	setDirty (false);
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * @param pContext the context which to use to draw
+ * @param updateRect the area which to draw
+ * @return false if the render cache could not be used
+ */
+bool CViewContainer::drawRenderCache (CDrawContext* pContext, const CRect& updateRect)
+{
+	CPoint size (getWidth (), getHeight ());
+	if (size.x <= 0. || size.y <= 0.)
+		return false;
+
+	auto scaleFactor = pContext->getScaleFactor ();
+	const auto& matrix = pContext->getCurrentTransform ();
+	if (matrix.m11 == matrix.m22 && matrix.m11 > 0.)
+		scaleFactor *= matrix.m11;
+
+	auto& registry = Impl::RenderCacheRegistry::instance ();
+	auto& cache = pImpl->renderCache;
+	if (cache.bitmap && (cache.size != size || cache.scaleFactor != scaleFactor || isDirty ()))
+		pImpl->dropRenderCache ();
+	if (cache.bitmap)
+	{
+		registry.touch (&cache);
+	}
+	else
+	{
+		auto memorySize = static_cast<size_t> (std::ceil (size.x * scaleFactor) *
+											   std::ceil (size.y * scaleFactor) * 4.);
+		if (memorySize > registry.getMemoryLimit ())
+			return false;
+		auto offscreen = COffscreenContext::create (size, scaleFactor);
+		if (!offscreen)
+			return false;
+		offscreen->beginDraw ();
+		{
+			CDrawContext::Transform transform (
+				*offscreen,
+				CGraphicsTransform ().translate (-getViewSize ().left, -getViewSize ().top));
+			pImpl->drawingIntoRenderCache = true;
+			CViewContainer::drawRect (offscreen, getViewSize ());
+			pImpl->drawingIntoRenderCache = false;
+		}
+		offscreen->endDraw ();
+		if (!offscreen->getBitmap ())
+			return false;
+		cache.bitmap = offscreen->getBitmap ();
+		cache.size = size;
+		cache.scaleFactor = scaleFactor;
+		cache.memorySize = memorySize;
+		registry.add (&cache);
+	}
+
+	CRect r (updateRect);
+	r.bound (getViewSize ());
+	if (!r.isEmpty ())
+		cache.bitmap->draw (pContext, r, r.getTopLeft () - getViewSize ().getTopLeft ());
+	setDirty (false);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * a container is opaque if it fills its background with an opaque color
+ */
+bool CViewContainer::isOpaque () const
+{
+	if (!pImpl->opaque || getTransparency () || getDrawBackground ())
+		return false;
+	if (pImpl->backgroundColor.alpha != 255)
+		return false;
+	return pImpl->backgroundColorDrawStyle == kDrawFilled ||
+		   pImpl->backgroundColorDrawStyle == kDrawFilledAndStroked;
+}
+
 //-----------------------------------------------------------------------------
 /**
  * check if view needs to be updated for rect
@@ -1296,33 +1908,31 @@ CView* CViewContainer::getViewAt (const CPoint& p, const GetViewOptions& options
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	CView* result = nullptr;
+	pImpl->forEachChildAt (where, [&] (CView* pV) {
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled () == false)
-					continue;
-			}
-			if (options.getDeep ())
+			if (pV->getMouseEnabled () == false)
+				return true;
+		}
+		if (options.getDeep ())
+		{
+			if (auto container = pV->asViewContainer ())
 			{
-				if (auto container = pV->asViewContainer ())
-				{
-					CView* view = container->getViewAt (where, options);
-					return options.getIncludeViewContainer () ? (view ? view : container) : view;
-				}
+				CView* view = container->getViewAt (where, options);
+				result = options.getIncludeViewContainer () ? (view ? view : container) : view;
+				return false;
 			}
-			if (!options.getIncludeViewContainer () && pV->asViewContainer ())
-				continue;
-			return pV;
 		}
-	}
+		if (!options.getIncludeViewContainer () && pV->asViewContainer ())
+			return true;
+		result = pV;
+		return false;
+	});
 
-	return nullptr;
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1340,32 +1950,28 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	pImpl->forEachChildAt (where, [&] (CView* pV) {
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled () == false)
-					continue;
-			}
-			if (options.getDeep ())
-			{
-				if (CViewContainer* container = pV->asViewContainer ())
-					result |= container->getViewsAt (where, views, options);
-			}
-			if (options.getIncludeViewContainer () == false)
-			{
-				if (pV->asViewContainer ())
-					continue;
-			}
-			views.emplace_back (pV);
-			result = true;
+			if (pV->getMouseEnabled () == false)
+				return true;
 		}
-	}
+		if (options.getDeep ())
+		{
+			if (CViewContainer* container = pV->asViewContainer ())
+				result |= container->getViewsAt (where, views, options);
+		}
+		if (options.getIncludeViewContainer () == false)
+		{
+			if (pV->asViewContainer ())
+				return true;
+		}
+		views.emplace_back (pV);
+		result = true;
+		return true;
+	});
 
 	return result;
 }
@@ -1382,28 +1988,24 @@ CViewContainer* CViewContainer::getContainerAt (const CPoint& p, const GetViewOp
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	CViewContainer* result = const_cast<CViewContainer*>(this);
+	pImpl->forEachChildAt (where, [&] (CView* pV) {
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled() == false)
-					continue;
-			}
-			if (options.getDeep ())
-			{
-				if (CViewContainer* container = pV->asViewContainer ())
-					return container->getContainerAt (where, options);
-			}
-			break;
+			if (pV->getMouseEnabled() == false)
+				return true;
 		}
-	}
+		if (options.getDeep ())
+		{
+			if (CViewContainer* container = pV->asViewContainer ())
+				result = container->getContainerAt (where, options);
+		}
+		return false;
+	});
 
-	return const_cast<CViewContainer*>(this);
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1430,6 +2032,9 @@ bool CViewContainer::removed (CView* parent)
 	if (!isAttached ())
 		return false;
 
+	// the children do not report size changes to a removed container
+	pImpl->hitTestIndex = nullptr;
+	pImpl->dropRenderCache ();
 	for (const auto& pV : pImpl->children)
 		pV->removed (this);
 	
@@ -1449,6 +2054,11 @@ bool CViewContainer::attached (CView* parent)
 	{
 		for (const auto& pV : pImpl->children)
 			pV->attached (this);
+		if (pImpl->hitTestIndexEnabled)
+		{
+			pImpl->hitTestIndex = std::unique_ptr<Impl::ViewHitTestIndex> (new Impl::ViewHitTestIndex ());
+			pImpl->hitTestIndex->build (pImpl->children);
+		}
 	}
 	return result;
 }
@@ -1461,6 +2071,18 @@ void CViewContainer::dumpInfo ()
 	CView::dumpInfo ();
 }
 
+//-----------------------------------------------------------------------------
+uint32_t CViewContainer::getNumCulledDraws ()
+{
+	return gNumCulledDraws;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::resetNumCulledDraws ()
+{
+	gNumCulledDraws = 0;
+}
+
 //-----------------------------------------------------------------------------
 void CViewContainer::dumpHierarchy ()
 {
@@ -94,6 +94,34 @@ public:
 	virtual void setAutosizingEnabled (bool state);
 	bool getAutosizingEnabled () const { return hasViewFlag (kAutosizeSubviews); }
 
+	/** enable or disable the spatial index of the child views used by getViewAt, getViewsAt and
+	 *	getContainerAt. Useful for containers with many child views. The index is only used while
+	 *	the container is attached. Per default this is disabled. */
+	void setHitTestIndexEnabled (bool state);
+	bool isHitTestIndexEnabled () const;
+
+	/** declare that the container fills its whole view size when drawn, so that the views
+	 *	behind it don't need to be drawn. Only takes effect while the container is not transparent
+	 *	and draws a fully opaque filled background color without a background bitmap. Subclasses
+	 *	drawing their own content must only enable it if they fill the whole view size. Per
+	 *	default this is disabled. */
+	void setOpaque (bool state);
+	bool getOpaque () const;
+
+	/** enable or disable drawing this container and its children into a cached bitmap which is
+	 *	reused for the following draws. Useful for static content which is expensive to draw. The
+	 *	cache is dropped when the container or one of its children gets dirty or invalidated.
+	 *	Per default this is disabled. */
+	void setRenderCacheEnabled (bool state);
+	bool isRenderCacheEnabled () const;
+
+	/** set the maximum memory in bytes the render caches of all containers may use together.
+	 *	If a new cache exceeds the limit, the least recently drawn caches are dropped. */
+	static void setRenderCacheMemoryLimit (size_t bytes);
+	static size_t getRenderCacheMemoryLimit ();
+	/** get the memory in bytes currently used by the render caches of all containers */
+	static size_t getRenderCacheMemoryUsage ();
+
 	/** get child views of type ViewClass. ContainerClass must be a stdc++ container */
 	template<class ViewClass, class ContainerClass>
 	uint32_t getChildViewsOfType (ContainerClass& result, bool deep = false) const;
@@ -136,6 +164,7 @@ public:
 	// CView
 	void draw (CDrawContext* pContext) override;
 	void drawRect (CDrawContext* pContext, const CRect& updateRect) override;
+	bool isOpaque () const override;
 	CMouseEventResult onMouseDown (CPoint& where, const CButtonState& buttons) override;
 	CMouseEventResult onMouseUp (CPoint& where, const CButtonState& buttons) override;
 	CMouseEventResult onMouseMoved (CPoint& where, const CButtonState& buttons) override;
@@ -229,6 +258,11 @@ public:
 	#if DEBUG
 	void dumpInfo () override;
 	virtual void dumpHierarchy ();
+
+	/** number of child view draws skipped because the views were covered by opaque siblings.
+	 *	Reset it at the start of a frame to get the number per frame. */
+	static uint32_t getNumCulledDraws ();
+	static void resetNumCulledDraws ();
 	#endif
 
 	CViewContainer* asViewContainer () final { return this; }
@@ -249,6 +283,11 @@ protected:
 	
 	const ViewList& getChildren () const;
 private:
+	friend class CView;
+	/** called by a child view when its size or mouseable area changed */
+	void childGeometryChanged (CView* child);
+
+	bool drawRenderCache (CDrawContext* pContext, const CRect& updateRect);
 	void clearMouseDownView ();
 	CRect getLastDrawnFocus () const;
 	void setLastDrawnFocus (CRect r);
@@ -3,7 +3,6 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cvstguitimer.h"
-#include "platform/platformfactory.h"
 
 #if DEBUG
 #define DEBUGLOG	0
@@ -17,7 +16,6 @@ IdStringPtr CVSTGUITimer::kMsgTimer = "timer fired";
 //-----------------------------------------------------------------------------
 CVSTGUITimer::CVSTGUITimer (CBaseObject* timerObject, uint32_t fireTime, bool doStart)
 : fireTime (fireTime)
-, platformTimer (nullptr)
 {
 	callbackFunc = [timerObject](CVSTGUITimer* timer) {
 		timerObject->notify (timer, kMsgTimer);
@@ -30,7 +28,6 @@ CVSTGUITimer::CVSTGUITimer (CBaseObject* timerObject, uint32_t fireTime, bool do
 CVSTGUITimer::CVSTGUITimer (const CallbackFunc& callback, uint32_t fireTime, bool doStart)
 : fireTime (fireTime)
 , callbackFunc (callback)
-, platformTimer (nullptr)
 {
 	if (doStart)
 		start ();
@@ -40,7 +37,6 @@ CVSTGUITimer::CVSTGUITimer (const CallbackFunc& callback, uint32_t fireTime, boo
 CVSTGUITimer::CVSTGUITimer (CallbackFunc&& callback, uint32_t fireTime, bool doStart)
 : fireTime (fireTime)
 , callbackFunc (std::move (callback))
-, platformTimer (nullptr)
 {
 	if (doStart)
 		start ();
@@ -59,30 +55,28 @@ void CVSTGUITimer::beforeDelete ()
 //-----------------------------------------------------------------------------
 bool CVSTGUITimer::start ()
 {
-	if (platformTimer == nullptr)
+	if (!wheelEntry.isScheduled ())
 	{
-		platformTimer = getPlatformFactory ().createTimer (this);
-		if (platformTimer)
+		wheel = &TimerWheel::current ();
+		if (wheel->schedule (wheelEntry, fireTime, TimerWheel::now ()))
 		{
-			platformTimer->start (fireTime);
 		#if DEBUGLOG
-			DebugPrint ("Timer started (0x%x)\n", timerObject);
+			DebugPrint ("Timer started (0x%x)\n", this);
 		#endif
 		}
 	}
-	return (platformTimer != nullptr);
+	return wheelEntry.isScheduled ();
 }
 
 //-----------------------------------------------------------------------------
 bool CVSTGUITimer::stop ()
 {
-	if (platformTimer)
+	if (wheelEntry.isScheduled ())
 	{
-		platformTimer->stop ();
-		platformTimer = nullptr;
+		wheel->cancel (wheelEntry);
 
 		#if DEBUGLOG
-		DebugPrint ("Timer stopped (0x%x)\n", timerObject);
+		DebugPrint ("Timer stopped (0x%x)\n", this);
 		#endif
 		return true;
 	}
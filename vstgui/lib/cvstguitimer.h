@@ -6,6 +6,7 @@
 
 #include "vstguifwd.h"
 #include "platform/iplatformtimer.h"
+#include "timerwheel.h"
 #include <functional>
 
 namespace VSTGUI {
@@ -13,6 +14,7 @@ namespace VSTGUI {
 //-----------------------------------------------------------------------------
 // CVSTGUITimer Declaration
 //! A timer class, which posts timer messages to CBaseObjects or calls a lambda function (c++11 only).
+//! All timers of a thread share one platform timer, see TimerWheel.
 //-----------------------------------------------------------------------------
 class CVSTGUITimer final : public CBaseObject, public IPlatformTimerCallback
 {
@@ -47,7 +49,8 @@ protected:
 	uint32_t fireTime;
 	CallbackFunc callbackFunc;
 
-	PlatformTimerPtr platformTimer;
+	TimerWheel::Entry wheelEntry {this};
+	TimerWheel* wheel {nullptr};
 };
 
 namespace Call
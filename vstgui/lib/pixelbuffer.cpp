@@ -3,6 +3,20 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "pixelbuffer.h"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VSTGUI_PIXELBUFFER_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VSTGUI_PIXELBUFFER_SSE2 1
+#endif
+#if (defined(__ARM_NEON) || defined(_M_ARM64)) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define VSTGUI_PIXELBUFFER_NEON 1
+#endif
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -10,157 +24,339 @@ namespace PixelBuffer {
 namespace Private {
 
 //------------------------------------------------------------------------
-template<int8_t bs1, int8_t bs2, int8_t bs3, int8_t bs4>
-inline uint32_t shuffle (uint32_t input)
+/** Scalar lanes, one pixel per step */
+struct ScalarLanes
 {
-	static constexpr auto s1 = bs1 * 8;
-	static constexpr auto s2 = bs2 * 8;
-	static constexpr auto s3 = bs3 * 8;
-	static constexpr auto s4 = bs4 * 8;
+	using Type = uint32_t;
+	static constexpr uint32_t count = 1;
 
-	auto b1 = (input & 0xFF000000);
-	auto b2 = (input & 0x00FF0000);
-	auto b3 = (input & 0x0000FF00);
-	auto b4 = (input & 0x000000FF);
+	static Type load (const uint8_t* src)
+	{
+		Type value;
+		memcpy (&value, src, sizeof (value));
+		return value;
+	}
+	static void store (uint8_t* dst, Type value) { memcpy (dst, &value, sizeof (value)); }
+	static Type splat (uint32_t value) { return value; }
+	static Type bitAnd (Type a, Type b) { return a & b; }
+	static Type bitOr (Type a, Type b) { return a | b; }
+	static Type shiftLeft (Type v, uint32_t bits) { return v << bits; }
+	static Type shiftRight (Type v, uint32_t bits) { return v >> bits; }
+	static Type select (Type a, Type b, Type ifEqual, Type otherwise)
+	{
+		return a == b ? ifEqual : otherwise;
+	}
+	static Type luma (Type red, Type green, Type blue)
+	{
+		return static_cast<Type> (static_cast<float> (red) * 0.3f +
+								  static_cast<float> (green) * 0.59f +
+								  static_cast<float> (blue) * 0.11f);
+	}
+};
 
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable:4293)
+#if VSTGUI_PIXELBUFFER_SSE2
+//------------------------------------------------------------------------
+struct SSE2Lanes
+{
+	using Type = __m128i;
+	static constexpr uint32_t count = 4;
+
+	static Type load (const uint8_t* src)
+	{
+		return _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src));
+	}
+	static void store (uint8_t* dst, Type value)
+	{
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst), value);
+	}
+	static Type splat (uint32_t value) { return _mm_set1_epi32 (static_cast<int32_t> (value)); }
+	static Type bitAnd (Type a, Type b) { return _mm_and_si128 (a, b); }
+	static Type bitOr (Type a, Type b) { return _mm_or_si128 (a, b); }
+	static Type shiftLeft (Type v, uint32_t bits)
+	{
+		return _mm_sll_epi32 (v, _mm_cvtsi32_si128 (static_cast<int32_t> (bits)));
+	}
+	static Type shiftRight (Type v, uint32_t bits)
+	{
+		return _mm_srl_epi32 (v, _mm_cvtsi32_si128 (static_cast<int32_t> (bits)));
+	}
+	static Type select (Type a, Type b, Type ifEqual, Type otherwise)
+	{
+		auto mask = _mm_cmpeq_epi32 (a, b);
+		return _mm_or_si128 (_mm_and_si128 (mask, ifEqual), _mm_andnot_si128 (mask, otherwise));
+	}
+	static Type luma (Type red, Type green, Type blue)
+	{
+		auto r = _mm_mul_ps (_mm_cvtepi32_ps (red), _mm_set1_ps (0.3f));
+		auto g = _mm_mul_ps (_mm_cvtepi32_ps (green), _mm_set1_ps (0.59f));
+		auto b = _mm_mul_ps (_mm_cvtepi32_ps (blue), _mm_set1_ps (0.11f));
+		return _mm_cvttps_epi32 (_mm_add_ps (_mm_add_ps (r, g), b));
+	}
+};
 #endif
 
-	b1 = (s1 >= 0) ? b1 << s1 : b1 >> -s1;
-	b2 = (s2 >= 0) ? b2 << s2 : b2 >> -s2;
-	b3 = (s3 >= 0) ? b3 << s3 : b3 >> -s3;
-	b4 = (s4 >= 0) ? b4 << s4 : b4 >> -s4;
+#if VSTGUI_PIXELBUFFER_AVX2
+//------------------------------------------------------------------------
+struct AVX2Lanes
+{
+	using Type = __m256i;
+	static constexpr uint32_t count = 8;
 
-#ifdef _MSC_VER
-#pragma warning(pop)
+	static Type load (const uint8_t* src)
+	{
+		return _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src));
+	}
+	static void store (uint8_t* dst, Type value)
+	{
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (dst), value);
+	}
+	static Type splat (uint32_t value) { return _mm256_set1_epi32 (static_cast<int32_t> (value)); }
+	static Type bitAnd (Type a, Type b) { return _mm256_and_si256 (a, b); }
+	static Type bitOr (Type a, Type b) { return _mm256_or_si256 (a, b); }
+	static Type shiftLeft (Type v, uint32_t bits)
+	{
+		return _mm256_sll_epi32 (v, _mm_cvtsi32_si128 (static_cast<int32_t> (bits)));
+	}
+	static Type shiftRight (Type v, uint32_t bits)
+	{
+		return _mm256_srl_epi32 (v, _mm_cvtsi32_si128 (static_cast<int32_t> (bits)));
+	}
+	static Type select (Type a, Type b, Type ifEqual, Type otherwise)
+	{
+		return _mm256_blendv_epi8 (otherwise, ifEqual, _mm256_cmpeq_epi32 (a, b));
+	}
+	static Type luma (Type red, Type green, Type blue)
+	{
+		// no fused multiply add, so that the result is the same as CColor::getLuma
+		auto r = _mm256_mul_ps (_mm256_cvtepi32_ps (red), _mm256_set1_ps (0.3f));
+		auto g = _mm256_mul_ps (_mm256_cvtepi32_ps (green), _mm256_set1_ps (0.59f));
+		auto b = _mm256_mul_ps (_mm256_cvtepi32_ps (blue), _mm256_set1_ps (0.11f));
+		return _mm256_cvttps_epi32 (_mm256_add_ps (_mm256_add_ps (r, g), b));
+	}
+};
 #endif
 
-	return b1 | b2 | b3 | b4;
+#if VSTGUI_PIXELBUFFER_NEON
+//------------------------------------------------------------------------
+struct NEONLanes
+{
+	using Type = uint32x4_t;
+	static constexpr uint32_t count = 4;
+
+	static Type load (const uint8_t* src) { return vreinterpretq_u32_u8 (vld1q_u8 (src)); }
+	static void store (uint8_t* dst, Type value) { vst1q_u8 (dst, vreinterpretq_u8_u32 (value)); }
+	static Type splat (uint32_t value) { return vdupq_n_u32 (value); }
+	static Type bitAnd (Type a, Type b) { return vandq_u32 (a, b); }
+	static Type bitOr (Type a, Type b) { return vorrq_u32 (a, b); }
+	static Type shiftLeft (Type v, uint32_t bits)
+	{
+		return vshlq_u32 (v, vdupq_n_s32 (static_cast<int32_t> (bits)));
+	}
+	static Type shiftRight (Type v, uint32_t bits)
+	{
+		return vshlq_u32 (v, vdupq_n_s32 (-static_cast<int32_t> (bits)));
+	}
+	static Type select (Type a, Type b, Type ifEqual, Type otherwise)
+	{
+		return vbslq_u32 (vceqq_u32 (a, b), ifEqual, otherwise);
+	}
+	static Type luma (Type red, Type green, Type blue)
+	{
+		// no fused multiply add, so that the result is the same as CColor::getLuma
+		auto r = vmulq_n_f32 (vcvtq_f32_u32 (red), 0.3f);
+		auto g = vmulq_n_f32 (vcvtq_f32_u32 (green), 0.59f);
+		auto b = vmulq_n_f32 (vcvtq_f32_u32 (blue), 0.11f);
+		return vcvtq_u32_f32 (vaddq_f32 (vaddq_f32 (r, g), b));
+	}
+};
+#endif
+
+//------------------------------------------------------------------------
+#if VSTGUI_PIXELBUFFER_AVX2
+using VectorLanes = AVX2Lanes;
+#elif VSTGUI_PIXELBUFFER_SSE2
+using VectorLanes = SSE2Lanes;
+#elif VSTGUI_PIXELBUFFER_NEON
+using VectorLanes = NEONLanes;
+#else
+using VectorLanes = ScalarLanes;
+#endif
+
+//------------------------------------------------------------------------
+/** call proc for as many pixels as fit into the vector lanes and for the rest one by one.
+ *
+ *	proc is called with an instance of the lanes type and the loaded pixels and returns the
+ *	pixels to store
+ */
+template<typename Proc>
+inline void processRow (const uint8_t* src, uint8_t* dst, uint32_t width, Proc proc)
+{
+	static constexpr auto vectorBytes = VectorLanes::count * 4;
+	auto x = 0u;
+	for (; x + VectorLanes::count <= width; x += VectorLanes::count)
+	{
+		VectorLanes::store (dst, proc (VectorLanes (), VectorLanes::load (src)));
+		src += vectorBytes;
+		dst += vectorBytes;
+	}
+	for (; x < width; ++x, src += 4, dst += 4)
+		ScalarLanes::store (dst, proc (ScalarLanes (), ScalarLanes::load (src)));
+}
+
+//------------------------------------------------------------------------
+/** the pixels are loaded as native 32 bit integers, get the value of a pixel with this color */
+inline uint32_t pixelValue (const ComponentPositions& positions, const CColor& color)
+{
+	uint8_t bytes[4];
+	bytes[positions.red] = color.red;
+	bytes[positions.green] = color.green;
+	bytes[positions.blue] = color.blue;
+	bytes[positions.alpha] = color.alpha;
+	return ScalarLanes::load (bytes);
+}
+
+//------------------------------------------------------------------------
+/** shift of the byte in a lane, the components are in big endian order
+ *	(the 32 bit value 0xAARRGGBB is in ARGB format) */
+template<typename Lanes, int8_t bs1, int8_t bs2, int8_t bs3, int8_t bs4>
+inline typename Lanes::Type shuffle (typename Lanes::Type input)
+{
+	auto shift = [] (typename Lanes::Type value, int32_t bytes) {
+		return bytes >= 0 ? Lanes::shiftLeft (value, static_cast<uint32_t> (bytes * 8))
+						  : Lanes::shiftRight (value, static_cast<uint32_t> (-bytes * 8));
+	};
+	auto b1 = shift (Lanes::bitAnd (input, Lanes::splat (0xFF000000)), bs1);
+	auto b2 = shift (Lanes::bitAnd (input, Lanes::splat (0x00FF0000)), bs2);
+	auto b3 = shift (Lanes::bitAnd (input, Lanes::splat (0x0000FF00)), bs3);
+	auto b4 = shift (Lanes::bitAnd (input, Lanes::splat (0x000000FF)), bs4);
+	return Lanes::bitOr (Lanes::bitOr (b1, b2), Lanes::bitOr (b3, b4));
+}
+
+//------------------------------------------------------------------------
+template<int8_t bs1, int8_t bs2, int8_t bs3, int8_t bs4>
+inline void convertRows (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height)
+{
+	for (auto y = 0u; y < height; ++y, buffer += bytesPerRow)
+	{
+		processRow (buffer, buffer, width, [] (auto lanes, auto pixels) {
+			return shuffle<decltype (lanes), bs1, bs2, bs3, bs4> (pixels);
+		});
+	}
 }
 
 //------------------------------------------------------------------------
 template<Format SourceFormat, Format DestinationFormat>
 inline void convert (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height)
 {
-	for (auto y = 0u; y < height; ++y, buffer += bytesPerRow)
+	switch (SourceFormat)
 	{
-		auto intPtr = reinterpret_cast<uint32_t*> (buffer);
-		for (auto x = 0u; x < width; ++x, ++intPtr)
+		case Format::ARGB:
+		{
+			switch (DestinationFormat)
+			{
+				case Format::ARGB:
+				{
+					// nothing to do
+					break;
+				}
+				case Format::ABGR:
+				{
+					convertRows<0, -2, 0, 2> (buffer, bytesPerRow, width, height);
+					break;
+				}
+				case Format::BGRA:
+				{
+					convertRows<-3, -1, 1, 3> (buffer, bytesPerRow, width, height);
+					break;
+				}
+				case Format::RGBA:
+				{
+					convertRows<-3, 1, 1, 1> (buffer, bytesPerRow, width, height);
+					break;
+				}
+			}
+			break;
+		}
+		case Format::ABGR:
 		{
-			auto pixel = *intPtr;
-			switch (SourceFormat)
+			switch (DestinationFormat)
 			{
 				case Format::ARGB:
 				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							// nothing to do
-							break;
-						}
-						case Format::ABGR:
-						{
-							*intPtr = shuffle<0, -2, 0, 2> (pixel);
-							break;
-						}
-						case Format::BGRA:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-						case Format::RGBA:
-						{
-							*intPtr = shuffle<-3, 1, 1, 1> (pixel);
-							break;
-						}
-					}
+					convertRows<0, -2, 0, 2> (buffer, bytesPerRow, width, height);
 					break;
 				}
 				case Format::ABGR:
 				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							*intPtr = shuffle<0, -2, 0, 2> (pixel);
-							break;
-						}
-						case Format::ABGR:
-						{
-							// nothing to do
-							break;
-						}
-						case Format::BGRA:
-						{
-							*intPtr = shuffle<-3, 1, 1, 1> (pixel);
-							break;
-						}
-						case Format::RGBA:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-					}
+					// nothing to do
+					break;
+				}
+				case Format::BGRA:
+				{
+					convertRows<-3, 1, 1, 1> (buffer, bytesPerRow, width, height);
 					break;
 				}
 				case Format::RGBA:
 				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							*intPtr = shuffle<-3, 1, 1, 1> (pixel);
-							break;
-						}
-						case Format::ABGR:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-						case Format::BGRA:
-						{
-							*intPtr = shuffle<-2, 0, 2, 0> (pixel);
-							break;
-						}
-						case Format::RGBA:
-						{
-							// nothing to do
-							break;
-						}
-					}
+					convertRows<-3, -1, 1, 3> (buffer, bytesPerRow, width, height);
+					break;
+				}
+			}
+			break;
+		}
+		case Format::RGBA:
+		{
+			switch (DestinationFormat)
+			{
+				case Format::ARGB:
+				{
+					convertRows<-3, 1, 1, 1> (buffer, bytesPerRow, width, height);
+					break;
+				}
+				case Format::ABGR:
+				{
+					convertRows<-3, -1, 1, 3> (buffer, bytesPerRow, width, height);
 					break;
 				}
 				case Format::BGRA:
 				{
-					switch (DestinationFormat)
-					{
-						case Format::ARGB:
-						{
-							*intPtr = shuffle<-3, -1, 1, 3> (pixel);
-							break;
-						}
-						case Format::ABGR:
-						{
-							*intPtr = shuffle<-3, 1, 1, 1> (pixel);
-							break;
-						}
-						case Format::BGRA:
-						{
-							// nothing to do
-							break;
-						}
-						case Format::RGBA:
-						{
-							*intPtr = shuffle<-2, 0, 2, 0> (pixel);
-							break;
-						}
-					}
+					convertRows<-2, 0, 2, 0> (buffer, bytesPerRow, width, height);
+					break;
+				}
+				case Format::RGBA:
+				{
+					// nothing to do
 					break;
 				}
 			}
+			break;
+		}
+		case Format::BGRA:
+		{
+			switch (DestinationFormat)
+			{
+				case Format::ARGB:
+				{
+					convertRows<-3, -1, 1, 3> (buffer, bytesPerRow, width, height);
+					break;
+				}
+				case Format::ABGR:
+				{
+					convertRows<-3, 1, 1, 1> (buffer, bytesPerRow, width, height);
+					break;
+				}
+				case Format::BGRA:
+				{
+					// nothing to do
+					break;
+				}
+				case Format::RGBA:
+				{
+					convertRows<-2, 0, 2, 0> (buffer, bytesPerRow, width, height);
+					break;
+				}
+			}
+			break;
 		}
 	}
 }
@@ -273,6 +469,64 @@ void convert (Format srcFormat, Format dstFormat, uint8_t* buffer, uint32_t byte
 	}
 }
 
+//------------------------------------------------------------------------
+void setColor (const ComponentPositions& positions, const uint8_t* src, uint8_t* dst,
+			   uint32_t width, const CColor& color, bool ignoreAlpha)
+{
+	using namespace Private;
+	auto value = pixelValue (positions, color);
+	if (!ignoreAlpha)
+	{
+		processRow (src, dst, width, [value] (auto lanes, auto) {
+			return decltype (lanes)::splat (value);
+		});
+		return;
+	}
+	auto alphaMask = pixelValue (positions, CColor (0, 0, 0, 255));
+	value &= ~alphaMask;
+	processRow (src, dst, width, [value, alphaMask] (auto lanes, auto pixels) {
+		using Lanes = decltype (lanes);
+		return Lanes::bitOr (Lanes::bitAnd (pixels, Lanes::splat (alphaMask)),
+							 Lanes::splat (value));
+	});
+}
+
+//------------------------------------------------------------------------
+void grayscale (const ComponentPositions& positions, const uint8_t* src, uint8_t* dst,
+				uint32_t width)
+{
+	using namespace Private;
+	auto alphaMask = pixelValue (positions, CColor (0, 0, 0, 255));
+	uint32_t redShift = positions.red * 8u;
+	uint32_t greenShift = positions.green * 8u;
+	uint32_t blueShift = positions.blue * 8u;
+	processRow (src, dst, width, [=] (auto lanes, auto pixels) {
+		using Lanes = decltype (lanes);
+		auto byteMask = Lanes::splat (0xFF);
+		auto luma = Lanes::luma (Lanes::bitAnd (Lanes::shiftRight (pixels, redShift), byteMask),
+								 Lanes::bitAnd (Lanes::shiftRight (pixels, greenShift), byteMask),
+								 Lanes::bitAnd (Lanes::shiftRight (pixels, blueShift), byteMask));
+		auto result = Lanes::bitAnd (pixels, Lanes::splat (alphaMask));
+		result = Lanes::bitOr (result, Lanes::shiftLeft (luma, redShift));
+		result = Lanes::bitOr (result, Lanes::shiftLeft (luma, greenShift));
+		return Lanes::bitOr (result, Lanes::shiftLeft (luma, blueShift));
+	});
+}
+
+//------------------------------------------------------------------------
+void replaceColor (const ComponentPositions& positions, const uint8_t* src, uint8_t* dst,
+				   uint32_t width, const CColor& color, const CColor& replacement)
+{
+	using namespace Private;
+	auto value = pixelValue (positions, color);
+	auto replacementValue = pixelValue (positions, replacement);
+	processRow (src, dst, width, [value, replacementValue] (auto lanes, auto pixels) {
+		using Lanes = decltype (lanes);
+		return Lanes::select (pixels, Lanes::splat (value), Lanes::splat (replacementValue),
+							  pixels);
+	});
+}
+
 //------------------------------------------------------------------------
 } // PixelBuffer
 } // VSTGUI
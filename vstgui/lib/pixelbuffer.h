@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "ccolor.h"
 #include <cstdint>
 
 //------------------------------------------------------------------------
@@ -32,6 +33,40 @@ enum class Format
 void convert (Format srcFormat, Format dstFormat, uint8_t* buffer, uint32_t bytesPerRow,
 			  uint32_t width, uint32_t height);
 
+//------------------------------------------------------------------------
+/** Byte positions of the color components of a 32 bit pixel in memory */
+struct ComponentPositions
+{
+	constexpr ComponentPositions (uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+	: red (red), green (green), blue (blue), alpha (alpha)
+	{
+	}
+
+	uint8_t red;
+	uint8_t green;
+	uint8_t blue;
+	uint8_t alpha;
+};
+
+//------------------------------------------------------------------------
+/** @name Row kernels
+ *
+ *	The row kernels process width pixels from src and write them to dst. Both may point to the
+ *	same row. The rows are processed with SSE2, AVX2 or NEON if the compiler targets it and with
+ *	a scalar loop otherwise.
+ */
+//@{
+/** set all pixels to color, if ignoreAlpha is true the alpha value of the pixels is kept */
+void setColor (const ComponentPositions& positions, const uint8_t* src, uint8_t* dst,
+			   uint32_t width, const CColor& color, bool ignoreAlpha);
+/** set the color components of all pixels to the luma of the pixel (see CColor::getLuma) */
+void grayscale (const ComponentPositions& positions, const uint8_t* src, uint8_t* dst,
+				uint32_t width);
+/** replace all pixels equal to color with replacement */
+void replaceColor (const ComponentPositions& positions, const uint8_t* src, uint8_t* dst,
+				   uint32_t width, const CColor& color, const CColor& replacement);
+//@}
+
 //------------------------------------------------------------------------
 } // PixelBuffer
 } // VSTGUI
@@ -0,0 +1,111 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "mappedfileresourceinputstream.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if !WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+PlatformResourceInputStreamPtr MappedFileResourceInputStream::create (const std::string& path)
+{
+#if WINDOWS
+	return nullptr;
+#else
+	auto fd = open (path.data (), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return nullptr;
+	void* address = MAP_FAILED;
+	uint64_t size = 0;
+	struct stat info {};
+	if (fstat (fd, &info) == 0 && S_ISREG (info.st_mode) && info.st_size > 0 &&
+		static_cast<uint64_t> (info.st_size) <= std::numeric_limits<size_t>::max ())
+	{
+		size = static_cast<uint64_t> (info.st_size);
+		address = mmap (nullptr, static_cast<size_t> (size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	// the mapping keeps the file alive
+	close (fd);
+	if (address == MAP_FAILED)
+		return nullptr;
+	// resources are parsed or decoded from front to back
+	posix_madvise (address, static_cast<size_t> (size), POSIX_MADV_SEQUENTIAL);
+	return PlatformResourceInputStreamPtr (
+		new MappedFileResourceInputStream (static_cast<const uint8_t*> (address), size));
+#endif
+}
+
+//-----------------------------------------------------------------------------
+MappedFileResourceInputStream::MappedFileResourceInputStream (const uint8_t* data, uint64_t size)
+: data (data), dataSize (size)
+{
+}
+
+//-----------------------------------------------------------------------------
+MappedFileResourceInputStream::~MappedFileResourceInputStream () noexcept
+{
+#if !WINDOWS
+	munmap (const_cast<uint8_t*> (data), static_cast<size_t> (dataSize));
+#endif
+}
+
+//-----------------------------------------------------------------------------
+uint32_t MappedFileResourceInputStream::readRaw (void* buffer, uint32_t size)
+{
+	if (position >= dataSize)
+		return 0;
+	auto numBytes = static_cast<uint32_t> (std::min<uint64_t> (size, dataSize - position));
+	std::memcpy (buffer, data + position, numBytes);
+	position += numBytes;
+	return numBytes;
+}
+
+//-----------------------------------------------------------------------------
+int64_t MappedFileResourceInputStream::seek (int64_t pos, SeekMode mode)
+{
+	int64_t newPosition;
+	switch (mode)
+	{
+		case SeekMode::Set:
+			newPosition = pos;
+			break;
+		case SeekMode::Current:
+			newPosition = static_cast<int64_t> (position) + pos;
+			break;
+		case SeekMode::End:
+		default:
+			newPosition = static_cast<int64_t> (dataSize) + pos;
+			break;
+	}
+	if (newPosition < 0 || static_cast<uint64_t> (newPosition) > dataSize)
+		return kStreamSeekError;
+	position = static_cast<uint64_t> (newPosition);
+	return newPosition;
+}
+
+//-----------------------------------------------------------------------------
+int64_t MappedFileResourceInputStream::tell ()
+{
+	return static_cast<int64_t> (position);
+}
+
+//-----------------------------------------------------------------------------
+const uint8_t* MappedFileResourceInputStream::getMemory (uint64_t& size) const
+{
+	size = dataSize;
+	return data;
+}
+
+//-----------------------------------------------------------------------------
+} // VSTGUI
@@ -0,0 +1,42 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../iplatformresourceinputstream.h"
+#include <string>
+
+//-----------------------------------------------------------------------------
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** resource input stream on a read only memory mapping of a file
+ *
+ *	The content of the file is available via getMemory, so that parsers and image decoders can
+ *	read it in place instead of copying it through a buffered file handle.
+ *
+ *	create returns nullptr for empty files and on platforms without POSIX mmap, callers fall back
+ *	to FileResourceInputStream in that case.
+ */
+class MappedFileResourceInputStream : public IPlatformResourceInputStream
+{
+public:
+	static PlatformResourceInputStreamPtr create (const std::string& path);
+
+private:
+	MappedFileResourceInputStream (const uint8_t* data, uint64_t size);
+	~MappedFileResourceInputStream () noexcept override;
+
+	uint32_t readRaw (void* buffer, uint32_t size) override;
+	int64_t seek (int64_t pos, SeekMode mode) override;
+	int64_t tell () override;
+	const uint8_t* getMemory (uint64_t& size) const override;
+
+	const uint8_t* data;
+	uint64_t dataSize;
+	uint64_t position {0};
+};
+
+//-----------------------------------------------------------------------------
+} // VSTGUI
@@ -20,6 +20,10 @@ public:
 	virtual uint32_t readRaw (void* buffer, uint32_t size) = 0;
 	virtual int64_t seek (int64_t pos, SeekMode mode) = 0;
 	virtual int64_t tell () = 0;
+
+	/** the whole content of the resource if it is available in memory, nullptr otherwise. The
+	 *	memory is valid for the lifetime of the stream. */
+	virtual const uint8_t* getMemory (uint64_t& size) const { return nullptr; }
 };
 
 //-----------------------------------------------------------------------------
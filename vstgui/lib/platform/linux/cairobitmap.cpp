@@ -4,6 +4,7 @@
 
 #include "../../cpoint.h"
 #include "../../cresourcedescription.h"
+#include "../common/mappedfileresourceinputstream.h"
 #include "linuxfactory.h"
 #include "cairobitmap.h"
 #include <memory>
@@ -40,6 +41,31 @@ private:
 	size_t size;
 };
 
+//-----------------------------------------------------------------------------
+struct PNGStreamReader
+{
+	PNGStreamReader (const BitmapDataReader& reader) : reader (reader) {}
+
+	cairo_surface_t* create () { return cairo_image_surface_create_from_png_stream (read, this); }
+
+private:
+	static cairo_status_t read (void* closure, unsigned char* data, unsigned int length)
+	{
+		auto self = reinterpret_cast<PNGStreamReader*> (closure);
+		while (length > 0)
+		{
+			auto numBytes = self->reader (data, length);
+			if (numBytes == 0 || numBytes > length)
+				return CAIRO_STATUS_READ_ERROR;
+			data += numBytes;
+			length -= numBytes;
+		}
+		return CAIRO_STATUS_SUCCESS;
+	}
+
+	const BitmapDataReader& reader;
+};
+
 //-----------------------------------------------------------------------------
 struct PNGMemoryWriter
 {
@@ -64,10 +90,26 @@ private:
 	}
 };
 
+//-----------------------------------------------------------------------------
+static cairo_surface_t* loadPNG (const char* path)
+{
+	// decode directly from the mapped file instead of reading it through stdio
+	if (auto stream = MappedFileResourceInputStream::create (path))
+	{
+		uint64_t size = 0;
+		if (auto memory = stream->getMemory (size))
+		{
+			PNGMemoryReader reader (memory, static_cast<size_t> (size));
+			return reader.create ();
+		}
+	}
+	return cairo_image_surface_create_from_png (path);
+}
+
 //-----------------------------------------------------------------------------
 static SurfaceHandle createImageFromPath (const char* path)
 {
-	if (auto surface = cairo_image_surface_create_from_png (path))
+	if (auto surface = loadPNG (path))
 	{
 		if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
 		{
@@ -154,6 +196,22 @@ SharedPointer<Bitmap> Bitmap::create (const void* ptr, uint32_t memSize)
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+SharedPointer<Bitmap> Bitmap::create (const BitmapDataReader& reader)
+{
+	Cairo::CairoBitmapPrivate::PNGStreamReader streamReader (reader);
+	if (auto surface = streamReader.create ())
+	{
+		if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
+		{
+			cairo_surface_destroy (surface);
+			return nullptr;
+		}
+		return makeOwned<Bitmap> (Cairo::SurfaceHandle {surface});
+	}
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 Bitmap::Bitmap (const CPoint& _size)
 {
@@ -201,6 +259,7 @@ bool Bitmap::load (const CResourceDescription& desc)
 				return false;
 			}
 			surface = s;
+			pattern.reset ();
 			size.x = cairo_image_surface_get_width (surface);
 			size.y = cairo_image_surface_get_height (surface);
 			return true;
@@ -231,6 +290,29 @@ SharedPointer<IPlatformBitmapPixelAccess> Bitmap::lockPixels (bool alphaPremulti
 void Bitmap::setScaleFactor (double factor)
 {
 	scaleFactor = factor;
+	pattern.reset ();
+}
+
+//-----------------------------------------------------------------------------
+const PatternHandle& Bitmap::getPattern (const CPoint& offset)
+{
+	if (locked || !surface)
+	{
+		static PatternHandle empty;
+		return empty;
+	}
+	bool updateMatrix = !pattern || offset != patternOffset;
+	if (!pattern)
+		pattern.assign (cairo_pattern_create_for_surface (surface));
+	if (updateMatrix)
+	{
+		cairo_matrix_t matrix;
+		cairo_matrix_init_scale (&matrix, scaleFactor, scaleFactor);
+		cairo_matrix_translate (&matrix, offset.x, offset.y);
+		cairo_pattern_set_matrix (pattern, &matrix);
+		patternOffset = offset;
+	}
+	return pattern;
 }
 
 //-----------------------------------------------------------------------------
@@ -23,6 +23,8 @@ class Bitmap : public IPlatformBitmap
 public:
 	static SharedPointer<Bitmap> create (UTF8StringPtr absolutePath);
 	static SharedPointer<Bitmap> create (const void* ptr, uint32_t memSize);
+	/** decodes PNG data while it is read */
+	static SharedPointer<Bitmap> create (const BitmapDataReader& reader);
 
 	Bitmap ();
 	explicit Bitmap (const CPoint& size);
@@ -48,11 +50,17 @@ public:
 		return surface;
 	}
 
+	/** pattern of the surface scaled to the scale factor and translated by offset.
+	 *	The pattern is kept between draw calls, its matrix is only updated if offset changes. */
+	const PatternHandle& getPattern (const CPoint& offset);
+
 	void unlock () { locked = false; }
 
 private:
 	double scaleFactor {1.0};
 	SurfaceHandle surface;
+	PatternHandle pattern;
+	CPoint patternOffset;
 	CPoint size;
 	bool locked {false};
 };
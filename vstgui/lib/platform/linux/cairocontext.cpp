@@ -396,18 +396,14 @@ void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offs
 			bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor).cast<Bitmap> ();
 		if (cairoBitmap)
 		{
+			// The bitmap keeps its pattern for scaling between draws, so drawing the same part
+			// of a bitmap again (like a frame of a sprite atlas) needs no pattern setup.
+			const auto& pattern = cairoBitmap->getPattern (offset);
+			if (!pattern)
+				return;
 			cairo_translate (cr, dest.left, dest.top);
 			cairo_rectangle (cr, 0, 0, dest.getWidth (), dest.getHeight ());
 			cairo_clip (cr);
-
-			// Setup a pattern for scaling bitmaps and take it as source afterwards.
-			auto pattern = cairo_pattern_create_for_surface (cairoBitmap->getSurface ());
-			cairo_matrix_t matrix;
-			cairo_pattern_get_matrix (pattern, &matrix);
-			cairo_matrix_init_scale (&matrix, cairoBitmap->getScaleFactor (),
-									 cairoBitmap->getScaleFactor ());
-			cairo_matrix_translate (&matrix, offset.x, offset.y);
-			cairo_pattern_set_matrix (pattern, &matrix);
 			cairo_set_source (cr, pattern);
 
 			cairo_rectangle (cr, -offset.x, -offset.y, dest.getWidth () + offset.x,
@@ -421,8 +417,6 @@ void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offs
 			{
 				cairo_fill (cr);
 			}
-
-			cairo_pattern_destroy (pattern);
 		}
 	}
 	checkCairoStatus (cr);
@@ -443,7 +437,7 @@ void Context::clearRect (const CRect& rect)
 //-----------------------------------------------------------------------------
 CGraphicsPath* Context::createGraphicsPath ()
 {
-	return new Path (cr);
+	return new Path ();
 }
 
 //-----------------------------------------------------------------------------
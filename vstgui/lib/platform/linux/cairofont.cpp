@@ -11,6 +11,9 @@
 #include <pango/pango-features.h>
 #include <pango/pangofc-fontmap.h>
 #include <fontconfig/fontconfig.h>
+#include <list>
+#include <string>
+#include <unordered_map>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -21,6 +24,10 @@ using PangoFontHandle =
 	Handle<PangoFont*, decltype (&g_object_ref), g_object_ref,
 		   decltype (&g_object_unref), g_object_unref>;
 
+using PangoLayoutHandle =
+	Handle<PangoLayout*, decltype (&g_object_ref), g_object_ref,
+		   decltype (&g_object_unref), g_object_unref>;
+
 //------------------------------------------------------------------------
 class FontList
 {
@@ -128,6 +135,129 @@ private:
 	}
 };
 
+//------------------------------------------------------------------------
+struct ShapedLayout
+{
+	PangoLayoutHandle layout;
+	PangoRectangle extents {};
+	CCoord baseline {0.};
+	int width {0};
+};
+
+//------------------------------------------------------------------------
+/** LRU cache of shaped pango layouts
+ *
+ *	Labels and parameter displays redraw the same strings over and over again, so the layouts
+ *	are kept with their metrics. The key is the identity of the font (its pango description and
+ *	style), so equal fonts share entries, and the text. The cache is cleared when the
+ *	configuration of the font context changes.
+ *
+ *	Pango layouts must not be used by two threads at once, so every thread has its own cache.
+ */
+class LayoutCache
+{
+public:
+	static constexpr size_t kDefaultMaxEntries = 512;
+
+	static LayoutCache& instance ()
+	{
+		static thread_local LayoutCache gInstance;
+		return gInstance;
+	}
+
+	template<typename CreateProc>
+	const ShapedLayout& get (const std::string& font, const std::string& text,
+							 CreateProc createProc)
+	{
+		checkContextSerial ();
+		if (maxEntries == 0)
+		{
+			++statistics.misses;
+			uncached = createProc ();
+			return uncached;
+		}
+		Key key {font, text};
+		auto it = map.find (key);
+		if (it != map.end ())
+		{
+			++statistics.hits;
+			entries.splice (entries.begin (), entries, it->second);
+			return it->second->second;
+		}
+		++statistics.misses;
+		entries.emplace_front (key, createProc ());
+		map.emplace (std::move (key), entries.begin ());
+		shrinkTo (maxEntries);
+		return entries.front ().second;
+	}
+
+	void setMaxEntries (size_t numEntries)
+	{
+		maxEntries = numEntries;
+		shrinkTo (maxEntries);
+	}
+
+	Font::LayoutCacheStatistics getStatistics () const
+	{
+		auto result = statistics;
+		result.numEntries = map.size ();
+		return result;
+	}
+
+private:
+	struct Key
+	{
+		std::string font;
+		std::string text;
+
+		bool operator== (const Key& other) const
+		{
+			return font == other.font && text == other.text;
+		}
+	};
+	struct KeyHash
+	{
+		size_t operator() (const Key& key) const
+		{
+			return std::hash<std::string> () (key.text) ^
+				   (std::hash<std::string> () (key.font) << 1);
+		}
+	};
+	using EntryList = std::list<std::pair<Key, ShapedLayout>>;
+	using EntryMap = std::unordered_map<Key, EntryList::iterator, KeyHash>;
+
+	void checkContextSerial ()
+	{
+		auto context = FontList::instance ().getFontContext ();
+		if (!context)
+			return;
+		auto serial = pango_context_get_serial (context);
+		if (serial == contextSerial)
+			return;
+		contextSerial = serial;
+		statistics.evictions += map.size ();
+		map.clear ();
+		entries.clear ();
+	}
+
+	void shrinkTo (size_t numEntries)
+	{
+		while (map.size () > numEntries)
+		{
+			map.erase (entries.back ().first);
+			entries.pop_back ();
+			++statistics.evictions;
+		}
+	}
+
+	EntryList entries;
+	EntryMap map;
+	ShapedLayout uncached;
+	size_t maxEntries {kDefaultMaxEntries};
+	guint contextSerial {0};
+	Font::LayoutCacheStatistics statistics;
+};
+
 //------------------------------------------------------------------------
 } // anonymous
 
@@ -135,11 +265,63 @@ private:
 struct Font::Impl
 {
 	PangoFontHandle font;
+	/** the pango font description and the style, see LayoutCache */
+	std::string identity;
 	int32_t style;
 	CCoord ascent {-1.};
 	CCoord descent {-1.};
 	CCoord leading {-1.};
 	CCoord capHeight {-1.};
+
+	ShapedLayout createLayout (const std::string& text) const
+	{
+		ShapedLayout result;
+		PangoContext* context = FontList::instance ().getFontContext ();
+		if (!context)
+			return result;
+		result.layout.assign (pango_layout_new (context));
+		if (!result.layout)
+			return result;
+		if (font)
+		{
+			PangoFontDescription* desc = pango_font_describe (font);
+			if (desc)
+			{
+				pango_layout_set_font_description (result.layout, desc);
+				pango_font_description_free (desc);
+			}
+		}
+
+		PangoAttrList* attrs = pango_attr_list_new ();
+		if (attrs)
+		{
+			if (style & kUnderlineFace)
+				pango_attr_list_insert (attrs, pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
+			if (style & kStrikethroughFace)
+				pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
+			pango_layout_set_attributes (result.layout, attrs);
+			pango_attr_list_unref (attrs);
+		}
+
+		pango_layout_set_text (result.layout, text.c_str (), -1);
+
+		pango_layout_get_pixel_extents (result.layout, nullptr, &result.extents);
+		pango_layout_get_pixel_size (result.layout, &result.width, nullptr);
+
+		PangoLayoutIter* iter = pango_layout_get_iter (result.layout);
+		if (iter)
+		{
+			result.baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
+			pango_layout_iter_free (iter);
+		}
+		return result;
+	}
+
+	const ShapedLayout& getLayout (const std::string& text) const
+	{
+		return LayoutCache::instance ().get (identity, text,
+											 [&] () { return createLayout (text); });
+	}
 };
 
 //------------------------------------------------------------------------
@@ -190,10 +372,23 @@ Font::Font (UTF8StringPtr name, const CCoord& size, const int32_t& style)
 	}
 
 	impl->style = style;
+	if (impl->font)
+	{
+		if (PangoFontDescription* desc = pango_font_describe (impl->font))
+		{
+			if (char* descString = pango_font_description_to_string (desc))
+			{
+				impl->identity = descString;
+				g_free (descString);
+			}
+			pango_font_description_free (desc);
+		}
+	}
+	impl->identity += "|" + std::to_string (style);
 }
 
 //------------------------------------------------------------------------
-Font::~Font () {}
+Font::~Font () = default;
 
 //------------------------------------------------------------------------
 bool Font::valid () const
@@ -247,50 +442,12 @@ void Font::drawString (CDrawContext* context, IPlatformString* string, const CPo
 				cairo_set_source_rgba (cr, color.normRed<double> (), color.normGreen<double> (),
 									   color.normBlue<double> (), alpha);
 
-				PangoContext* context = FontList::instance ().getFontContext();
-				if (context)
+				const auto& shaped = impl->getLayout (linuxString->get ());
+				if (shaped.layout)
 				{
-					PangoLayout* layout = pango_layout_new (context);
-					if (layout)
-					{
-						if (impl->font)
-						{
-							PangoFontDescription* desc = pango_font_describe (impl->font);
-							if (desc)
-							{
-								pango_layout_set_font_description (layout, desc);
-								pango_font_description_free (desc);
-							}
-						}
-
-						PangoAttrList* attrs = pango_attr_list_new ();
-						if (attrs)
-						{
-							if (impl->style & kUnderlineFace)
-								pango_attr_list_insert (attrs, pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
-							if (impl->style & kStrikethroughFace)
-								pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
-							pango_layout_set_attributes(layout, attrs);
-							pango_attr_list_unref (attrs);
-						}
-
-						pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-
-						PangoRectangle extents {};
-						pango_layout_get_pixel_extents (layout, nullptr, &extents);
-
-						PangoLayoutIter* iter = pango_layout_get_iter (layout);
-						CCoord baseline = 0.0;
-						if (iter)
-						{
-							baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
-							pango_layout_iter_free (iter);
-						}
-
-						cairo_move_to (cr, p.x + extents.x, p.y + extents.y - baseline);
-						pango_cairo_show_layout (cr, layout);
-						g_object_unref (layout);
-					}
+					cairo_move_to (cr, p.x + shaped.extents.x,
+								   p.y + shaped.extents.y - shaped.baseline);
+					pango_cairo_show_layout (cr, shaped.layout);
 				}
 			}
 		}
@@ -302,33 +459,23 @@ CCoord Font::getStringWidth (CDrawContext* context, IPlatformString* string, boo
 {
 	if (auto linuxString = dynamic_cast<LinuxString*> (string))
 	{
-		int pangoWidth = 0;
-		PangoContext* context = FontList::instance ().getFontContext();
-		if (context)
-		{
-			PangoLayout* layout = pango_layout_new (context);
-			if (layout)
-			{
-				if (impl->font)
-				{
-					PangoFontDescription* desc = pango_font_describe (impl->font);
-					if (desc)
-					{
-						pango_layout_set_font_description (layout, desc);
-						pango_font_description_free (desc);
-					}
-				}
-				pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-				pango_layout_get_pixel_size (layout, &pangoWidth, nullptr);
-				g_object_unref (layout);
-			}
-		}
-
-		return pangoWidth;
+		return impl->getLayout (linuxString->get ()).width;
 	}
 	return 0;
 }
 
+//------------------------------------------------------------------------
+auto Font::getLayoutCacheStatistics () -> LayoutCacheStatistics
+{
+	return LayoutCache::instance ().getStatistics ();
+}
+
+//------------------------------------------------------------------------
+void Font::setLayoutCacheSize (size_t maxEntries)
+{
+	LayoutCache::instance ().setMaxEntries (maxEntries);
+}
+
 //------------------------------------------------------------------------
 bool Font::getAllFamilies (const FontFamilyCallback& callback)
 {
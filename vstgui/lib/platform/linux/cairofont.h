@@ -36,6 +36,19 @@ public:
 
 	static bool getAllFamilies (const FontFamilyCallback& callback);
 
+	struct LayoutCacheStatistics
+	{
+		uint64_t hits {0};
+		uint64_t misses {0};
+		uint64_t evictions {0};
+		size_t numEntries {0};
+	};
+	/** statistics of the cache of shaped text layouts the fonts share on the calling thread */
+	static LayoutCacheStatistics getLayoutCacheStatistics ();
+	/** set the maximum number of shaped text layouts to cache on the calling thread, zero
+	 *	disables the cache */
+	static void setLayoutCacheSize (size_t maxEntries);
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl;
@@ -12,7 +12,24 @@ namespace VSTGUI {
 namespace Cairo {
 
 //------------------------------------------------------------------------
-Path::Path (const ContextHandle& cr) noexcept : cr (cr) {}
+namespace {
+
+//------------------------------------------------------------------------
+/** the context used to build and measure paths outside of drawing, so that a path does not keep
+ *	the context (and its surface) it was created for alive */
+const ContextHandle& getMeasureContext ()
+{
+	static ContextHandle context = [] () {
+		SurfaceHandle surface (cairo_image_surface_create (CAIRO_FORMAT_A8, 1, 1));
+		return ContextHandle (cairo_create (surface));
+	}();
+	return context;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+Path::Path () noexcept {}
 
 //------------------------------------------------------------------------
 Path::~Path () noexcept
@@ -31,6 +48,7 @@ CGradient* Path::createGradient (double color1Start, double color2Start,
 bool Path::hitTest (const CPoint& p, bool evenOddFilled, CGraphicsTransform* transform)
 {
 	auto result = false;
+	const auto& cr = getMeasureContext ();
 	if (auto cPath = getPath (cr))
 	{
 		auto tp = p;
@@ -40,8 +58,8 @@ bool Path::hitTest (const CPoint& p, bool evenOddFilled, CGraphicsTransform* tra
 		cairo_new_path (cr);
 		cairo_append_path (cr, cPath);
 		cairo_set_fill_rule (cr, evenOddFilled ? CAIRO_FILL_RULE_EVEN_ODD : CAIRO_FILL_RULE_WINDING);
-		cairo_clip (cr);
-		result = cairo_in_clip (cr, tp.x, tp.y);
+		// the measure context has a 1x1 surface, so test the fill and not the clip
+		result = cairo_in_fill (cr, tp.x, tp.y);
 		cairo_restore (cr);
 	}
 	return result;
@@ -51,6 +69,7 @@ bool Path::hitTest (const CPoint& p, bool evenOddFilled, CGraphicsTransform* tra
 CPoint Path::getCurrentPosition ()
 {
 	CPoint p;
+	const auto& cr = getMeasureContext ();
 	if (auto cPath = getPath (cr))
 	{
 		cairo_save (cr);
@@ -66,6 +85,7 @@ CPoint Path::getCurrentPosition ()
 CRect Path::getBoundingBox ()
 {
 	CRect r;
+	const auto& cr = getMeasureContext ();
 	if (auto cPath = getPath (cr))
 	{
 		cairo_save (cr);
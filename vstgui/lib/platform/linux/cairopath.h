@@ -15,7 +15,7 @@ namespace Cairo {
 class Path : public CGraphicsPath
 {
 public:
-	Path (const ContextHandle& cr) noexcept;
+	Path () noexcept;
 	~Path () noexcept;
 
 	cairo_path_t* getPath (const ContextHandle& handle,
@@ -33,7 +33,7 @@ public:
 
 //------------------------------------------------------------------------
 private:
-	ContextHandle cr;
+	/** built on first use, independent of the context it was built with */
 	cairo_path_t* path {nullptr};
 };
 
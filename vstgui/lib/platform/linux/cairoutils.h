@@ -76,6 +76,10 @@ using ScaledFontHandle = Handle<cairo_scaled_font_t*, decltype (&cairo_scaled_fo
 								cairo_scaled_font_reference, decltype (&cairo_scaled_font_destroy),
 								cairo_scaled_font_destroy>;
 
+using RegionHandle =
+	Handle<cairo_region_t*, decltype (&cairo_region_reference), cairo_region_reference,
+		   decltype (&cairo_region_destroy), cairo_region_destroy>;
+
 //-----------------------------------------------------------------------------
 } // Cairo
 } // VSTGUI
@@ -8,6 +8,7 @@
 #include "x11frame.h"
 #include "../iplatformframecallback.h"
 #include "../common/fileresourceinputstream.h"
+#include "../common/mappedfileresourceinputstream.h"
 #include "../iplatformresourceinputstream.h"
 #include "linuxstring.h"
 #include "x11timer.h"
@@ -137,6 +138,13 @@ PlatformBitmapPtr LinuxFactory::createBitmapFromMemory (const void* ptr,
 	return Cairo::Bitmap::create (ptr, memSize);
 }
 
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr LinuxFactory::createBitmapFromReader (
+	const BitmapDataReader& reader) const noexcept
+{
+	return Cairo::Bitmap::create (reader);
+}
+
 //-----------------------------------------------------------------------------
 PNGBitmapBuffer LinuxFactory::createBitmapMemoryPNGRepresentation (
 	const PlatformBitmapPtr& bitmap) const noexcept
@@ -156,6 +164,8 @@ PlatformResourceInputStreamPtr
 		return {};
 	auto path = impl->resPath;
 	path += desc.u.name;
+	if (auto stream = MappedFileResourceInputStream::create (path))
+		return stream;
 	return FileResourceInputStream::create (path);
 }
 
@@ -71,6 +71,11 @@ public:
 	 */
 	PlatformBitmapPtr createBitmapFromMemory (const void* ptr,
 											  uint32_t memSize) const noexcept final;
+	/** Create a platform bitmap object from data which is read piece by piece
+	 *	@param reader called to read the next bytes of the bitmap data
+	 *	@return platform bitmap or nullptr on failure
+	 */
+	PlatformBitmapPtr createBitmapFromReader (const BitmapDataReader& reader) const noexcept final;
 	/** Create a memory representation of the platform bitmap in PNG format.
 	 *	@param bitmap the platform bitmap object
 	 *	@return memory buffer containing the PNG representation of the bitmap
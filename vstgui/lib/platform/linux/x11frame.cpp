@@ -22,7 +22,9 @@
 #include "cairocontext.h"
 #include "x11platform.h"
 #include "x11utils.h"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <unordered_map>
 #include <X11/Xlib.h>
@@ -84,26 +86,139 @@ inline uint32_t translateModifiers (int state)
 } // anonymous
 
 //------------------------------------------------------------------------
-struct RedrawTimerHandler
+/** Schedules the redraws of a frame
+ *
+ *	Redraws are aligned to a steady tick with the period of the target rate. If the frame was
+ *	idle for at least one period the redraw is done on the next run loop iteration, otherwise on
+ *	the next tick. Invalidations which arrive while drawing are drawn on the next tick and ticks
+ *	which were missed because drawing took too long are skipped.
+ */
+struct RedrawScheduler
 : ITimerHandler
 , NonAtomicReferenceCounted
 {
+	using Clock = std::chrono::steady_clock;
 	using RedrawCallback = std::function<void ()>;
 
-	RedrawTimerHandler (uint64_t delay, RedrawCallback&& redrawCallback)
+	RedrawScheduler (uint32_t framesPerSecond, RedrawCallback&& redrawCallback)
 	: redrawCallback (std::move (redrawCallback))
 	{
-		RunLoop::instance ().get ()->registerTimer (delay, this);
+		period = std::chrono::duration_cast<Clock::duration> (
+			std::chrono::microseconds (1000000 / std::max<uint32_t> (framesPerSecond, 1)));
+		epoch = Clock::now ();
+	}
+	~RedrawScheduler () noexcept { stopTimer (); }
+
+	void schedule ()
+	{
+		++pendingInvalidations;
+		if (inRedraw || timerInterval)
+			return;
+		auto now = Clock::now ();
+		if (!lastRedraw || now - *lastRedraw >= period)
+		{
+			nextTick = tickIndex (now);
+			startTimer (1);
+		}
+		else
+		{
+			nextTick = tickIndex (*lastRedraw) + 1;
+			startTimer (millisecondsUntil (tickTime (nextTick), now));
+		}
 	}
-	~RedrawTimerHandler () noexcept { RunLoop::instance ().get ()->unregisterTimer (this); }
 
 	void onTimer () override
 	{
-		SharedPointer<RedrawTimerHandler> Self (this);
-		Self->redrawCallback ();
+		SharedPointer<RedrawScheduler> Self (this);
+		if (pendingInvalidations == 0)
+		{
+			stopTimer ();
+			return;
+		}
+		auto start = Clock::now ();
+		statistics.numInvalidations += pendingInvalidations;
+		pendingInvalidations = 0;
+		inRedraw = true;
+		redrawCallback ();
+		inRedraw = false;
+		auto end = Clock::now ();
+		lastRedraw = makeOptional (start);
+		updateStatistics (end - start);
+
+		// skip the ticks which passed while drawing or while the run loop was late
+		auto tick = tickIndex (end) + 1;
+		if (tick > nextTick + 1)
+			statistics.numDroppedFrames += tick - nextTick - 1;
+		nextTick = tick;
+
+		if (pendingInvalidations == 0)
+			stopTimer ();
+		else
+			startTimer (millisecondsUntil (tickTime (nextTick), end));
+	}
+
+	const RedrawStatistics& getStatistics () const { return statistics; }
+
+private:
+	uint64_t tickIndex (Clock::time_point time) const
+	{
+		return static_cast<uint64_t> ((time - epoch) / period);
+	}
+
+	Clock::time_point tickTime (uint64_t index) const { return epoch + period * index; }
+
+	static uint64_t millisecondsUntil (Clock::time_point time, Clock::time_point now)
+	{
+		if (time <= now)
+			return 1;
+		// round up, firing before the tick would draw twice in the same period
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds> (
+					  time - now + std::chrono::milliseconds (1) - Clock::duration (1))
+					  .count ();
+		return std::max<uint64_t> (static_cast<uint64_t> (ms), 1);
+	}
+
+	void startTimer (uint64_t interval)
+	{
+		if (timerInterval == interval)
+			return;
+		auto runLoop = RunLoop::instance ().get ();
+		if (timerInterval)
+			runLoop->unregisterTimer (this);
+		timerInterval = interval;
+		runLoop->registerTimer (interval, this);
+	}
+
+	void stopTimer ()
+	{
+		if (timerInterval == 0)
+			return;
+		if (auto runLoop = RunLoop::instance ().get ())
+			runLoop->unregisterTimer (this);
+		timerInterval = 0;
+	}
+
+	void updateStatistics (Clock::duration frameDuration)
+	{
+		auto frameTime =
+			std::chrono::duration_cast<std::chrono::duration<double, std::milli>> (frameDuration)
+				.count ();
+		++statistics.numFrames;
+		statistics.lastFrameTime = frameTime;
+		statistics.averageFrameTime +=
+			(frameTime - statistics.averageFrameTime) / static_cast<double> (statistics.numFrames);
+		statistics.maxFrameTime = std::max (statistics.maxFrameTime, frameTime);
 	}
 
 	RedrawCallback redrawCallback;
+	Clock::duration period;
+	Clock::time_point epoch;
+	Optional<Clock::time_point> lastRedraw;
+	uint64_t nextTick {0};
+	uint64_t timerInterval {0};
+	uint64_t pendingInvalidations {0};
+	bool inRedraw {false};
+	RedrawStatistics statistics;
 };
 
 //------------------------------------------------------------------------
@@ -138,7 +253,7 @@ struct DrawHandler
 	template<typename RectList, typename Proc>
 	void draw (const RectList& dirtyRects, Proc proc)
 	{
-		CRect copyRect;
+		Cairo::RegionHandle damageRegion (cairo_region_create ());
 		drawContext->beginDraw ();
 		for (auto rect : dirtyRects)
 		{
@@ -146,13 +261,14 @@ struct DrawHandler
 			drawContext->saveGlobalState ();
 			proc (drawContext, rect);
 			drawContext->restoreGlobalState ();
-			if (copyRect.isEmpty ())
-				copyRect = rect;
-			else
-				copyRect.unite (rect);
+			rect.makeIntegral ();
+			cairo_rectangle_int_t r = {static_cast<int> (rect.left), static_cast<int> (rect.top),
+									   static_cast<int> (rect.getWidth ()),
+									   static_cast<int> (rect.getHeight ())};
+			cairo_region_union_rectangle (damageRegion, &r);
 		}
 		drawContext->endDraw ();
-		blitBackbufferToWindow (copyRect);
+		blitBackbufferToWindow (damageRegion);
 		xcb_flush (RunLoop::instance ().getXcbConnection ());
 	}
 
@@ -162,14 +278,21 @@ private:
 	Cairo::SurfaceHandle backBuffer;
 	SharedPointer<Cairo::Context> drawContext;
 
-	void blitBackbufferToWindow (const CRect& rect)
+	void blitBackbufferToWindow (const Cairo::RegionHandle& region)
 	{
+		if (cairo_region_is_empty (region))
+			return;
+		// copy all damaged areas at once, the region does not contain overlapping rectangles
 		Cairo::ContextHandle windowContext (cairo_create (windowSurface));
-		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
+		for (auto i = 0, count = cairo_region_num_rectangles (region); i < count; ++i)
+		{
+			cairo_rectangle_int_t r;
+			cairo_region_get_rectangle (region, i, &r);
+			cairo_rectangle (windowContext, r.x, r.y, r.width, r.height);
+		}
 		cairo_clip (windowContext);
 		cairo_set_source_surface (windowContext, backBuffer, 0, 0);
-		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
-		cairo_fill (windowContext);
+		cairo_paint (windowContext);
 		cairo_surface_flush (windowSurface);
 	}
 };
@@ -255,16 +378,18 @@ struct Frame::Impl : IFrameEventHandler
 	DoubleClickDetector doubleClickDetector;
 	IPlatformFrameCallback* frame;
 	std::unique_ptr<GenericOptionMenuTheme> genericOptionMenuTheme;
-	SharedPointer<RedrawTimerHandler> redrawTimer;
+	SharedPointer<RedrawScheduler> redrawScheduler;
 	RectList dirtyRects;
+	RectList drawingRects;
 	CCursorType currentCursor {kCursorDefault};
 	uint32_t pointerGrabed {0};
 	XdndHandler dndHandler;
 
 	//------------------------------------------------------------------------
-	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame)
+	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame, uint32_t redrawRate)
 	: window (parent, size), drawHandler (window), frame (frame), dndHandler (&window, frame)
 	{
+		redrawScheduler = makeOwned<RedrawScheduler> (redrawRate, [this] () { redraw (); });
 		RunLoop::instance ().registerWindowEventHandler (window.getID (), this);
 	}
 
@@ -278,6 +403,7 @@ struct Frame::Impl : IFrameEventHandler
 		drawHandler.onSizeChanged (size.getSize ());
 		dirtyRects.clear ();
 		dirtyRects.add (size);
+		redrawScheduler->schedule ();
 	}
 
 	//------------------------------------------------------------------------
@@ -303,23 +429,21 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void redraw ()
 	{
-		drawHandler.draw (dirtyRects, [&] (CDrawContext* context, const CRect& rect) {
+		if (dirtyRects.data ().empty ())
+			return;
+		// views may invalidate while drawing, these rects are drawn in the next frame
+		std::swap (drawingRects, dirtyRects);
+		drawHandler.draw (drawingRects, [&] (CDrawContext* context, const CRect& rect) {
 			frame->platformDrawRect (context, rect);
 		});
-		dirtyRects.clear ();
+		drawingRects.clear ();
 	}
 
 	//------------------------------------------------------------------------
 	void invalidRect (CRect r)
 	{
 		dirtyRects.add (r);
-		if (redrawTimer)
-			return;
-		redrawTimer = makeOwned<RedrawTimerHandler> (16, [this] () {
-			if (dirtyRects.data ().empty ())
-				return;
-			redraw ();
-		});
+		redrawScheduler->schedule ();
 	}
 
 	//------------------------------------------------------------------------
@@ -446,9 +570,6 @@ struct Frame::Impl : IFrameEventHandler
 		buttons |= translateModifiers (event.state);
 		doubleClickDetector.onMouseMove (where, buttons, event.time);
 		frame->platformOnMouseMoved (where, buttons);
-		// make sure we get more motion events
-		auto xcb = RunLoop::instance ().getXcbConnection ();
-		xcb_get_motion_events (xcb, window.getID (), event.time, event.time + 10000000);
 	}
 
 	//------------------------------------------------------------------------
@@ -579,7 +700,8 @@ Frame::Frame (IPlatformFrameCallback* frame, const CRect& size, uint32_t parent,
 		RunLoop::init (cfg->runLoop);
 	}
 
-	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame));
+	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame,
+											cfg ? cfg->redrawRate : FrameConfig ().redrawRate));
 
 	frame->platformOnActivate (true);
 }
@@ -693,6 +815,12 @@ uint32_t Frame::getX11WindowID () const
 	return impl->window.getID ();
 }
 
+//------------------------------------------------------------------------
+RedrawStatistics Frame::getRedrawStatistics () const
+{
+	return impl->redrawScheduler->getStatistics ();
+}
+
 //------------------------------------------------------------------------
 SharedPointer<IPlatformTextEdit> Frame::createPlatformTextEdit (IPlatformTextEditCallback* textEdit)
 {
@@ -59,6 +59,7 @@ private:
 	bool setupGenericOptionMenu (bool use, GenericOptionMenuTheme* theme = nullptr) override;
 
 	uint32_t getX11WindowID () const override;
+	RedrawStatistics getRedrawStatistics () const override;
 
 	void optionMenuPopupStarted () override;
 	void optionMenuPopupStopped () override;
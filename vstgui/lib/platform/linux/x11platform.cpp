@@ -12,6 +12,7 @@
 #include <cassert>
 #include <chrono>
 #include <array>
+#include <deque>
 #include <dlfcn.h>
 #include <iostream>
 #include <locale>
@@ -119,6 +120,10 @@ struct RunLoop::Impl : IEventHandler
 	std::array<xcb_cursor_t, CCursorType::kCursorIBeam + 1> cursors {{XCB_CURSOR_NONE}};
 	VstKeyCode lastUnprocessedKeyEvent;
 	uint32_t lastUtf32KeyEventChar {0};
+	std::deque<xcb_generic_event_t*> pendingEvents;
+	MotionHistory motionHistory;
+	EventStatistics eventStatistics;
+	bool coalesceMotionEvents {true};
 
 	void init (const SharedPointer<IRunLoop>& inRunLoop)
 	{
@@ -171,6 +176,9 @@ struct RunLoop::Impl : IEventHandler
 
 			xcb_disconnect (xcbConnection);
 		}
+		for (auto event : pendingEvents)
+			std::free (event);
+		pendingEvents.clear ();
 		runLoop->unregisterEventHandler (this);
 		runLoop = nullptr;
 	}
@@ -234,10 +242,60 @@ struct RunLoop::Impl : IEventHandler
 		lastUnprocessedKeyEvent = code;
 	}
 
+	static bool isMotionEvent (const xcb_generic_event_t* event)
+	{
+		return (event->response_type & ~0x80) == XCB_MOTION_NOTIFY;
+	}
+
+	static void addToHistory (MotionHistory& history, const xcb_motion_notify_event_t& event)
+	{
+		history.push_back ({event.event_x, event.event_y, event.state, event.time});
+	}
+
+	/** merges the motion events following event in the queue into it */
+	xcb_generic_event_t* coalesceMotionEvent (xcb_generic_event_t* event)
+	{
+		auto ev = reinterpret_cast<xcb_motion_notify_event_t*> (event);
+		motionHistory.clear ();
+		addToHistory (motionHistory, *ev);
+		++eventStatistics.numMotionEvents;
+		while (coalesceMotionEvents && !pendingEvents.empty () &&
+			   isMotionEvent (pendingEvents.front ()))
+		{
+			auto next = reinterpret_cast<xcb_motion_notify_event_t*> (pendingEvents.front ());
+			if (next->event != ev->event)
+				break;
+			pendingEvents.pop_front ();
+			addToHistory (motionHistory, *next);
+			std::free (event);
+			event = reinterpret_cast<xcb_generic_event_t*> (next);
+			ev = next;
+			++eventStatistics.numMotionEvents;
+			++eventStatistics.numCoalescedMotionEvents;
+		}
+		return event;
+	}
+
 	void onEvent () override
 	{
+		// read all queued events first, so that motion events can be merged. The queue is a
+		// member as a handler may process events in a nested loop.
+		uint64_t queueLength = 0;
 		while (auto event = xcb_poll_for_event (xcbConnection))
 		{
+			pendingEvents.push_back (event);
+			++queueLength;
+		}
+		eventStatistics.numEvents += queueLength;
+		eventStatistics.maxQueueLength = std::max (eventStatistics.maxQueueLength, queueLength);
+		while (!pendingEvents.empty ())
+		{
+			auto event = pendingEvents.front ();
+			pendingEvents.pop_front ();
+			if (isMotionEvent (event))
+				event = coalesceMotionEvent (event);
+			else
+				motionHistory.clear ();
 			auto type = event->response_type & ~0x80;
 			switch (type)
 			{
@@ -335,6 +393,7 @@ struct RunLoop::Impl : IEventHandler
 			}
 			std::free (event);
 		}
+		motionHistory.clear ();
 		xcb_aux_sync (xcbConnection);
 		xcb_flush (xcbConnection);
 	}
@@ -389,6 +448,30 @@ void RunLoop::unregisterWindowEventHandler (uint32_t windowId)
 	impl->windowEventHandlerMap.erase (it);
 }
 
+//------------------------------------------------------------------------
+void RunLoop::setCoalesceMotionEvents (bool state)
+{
+	impl->coalesceMotionEvents = state;
+}
+
+//------------------------------------------------------------------------
+bool RunLoop::getCoalesceMotionEvents () const
+{
+	return impl->coalesceMotionEvents;
+}
+
+//------------------------------------------------------------------------
+auto RunLoop::getMotionHistory () const -> const MotionHistory&
+{
+	return impl->motionHistory;
+}
+
+//------------------------------------------------------------------------
+auto RunLoop::getEventStatistics () const -> const EventStatistics&
+{
+	return impl->eventStatistics;
+}
+
 //------------------------------------------------------------------------
 xcb_connection_t* RunLoop::getXcbConnection () const
 {
@@ -8,6 +8,7 @@
 #include "x11frame.h"
 #include <atomic>
 #include <memory>
+#include <vector>
 
 struct xcb_connection_t;	  // forward declaration
 struct xcb_key_press_event_t; // forward declaration
@@ -62,6 +63,34 @@ struct RunLoop
 	VstKeyCode getCurrentKeyEvent () const;
 	Optional<UTF8String> convertCurrentKeyEventToText () const;
 
+	/** a motion event merged into a later one */
+	struct MotionEvent
+	{
+		int16_t x;
+		int16_t y;
+		uint16_t state;
+		uint32_t time;
+	};
+	using MotionHistory = std::vector<MotionEvent>;
+
+	struct EventStatistics
+	{
+		uint64_t numEvents {0};
+		uint64_t numMotionEvents {0};
+		/** motion events not dispatched because a later one for the same window followed */
+		uint64_t numCoalescedMotionEvents {0};
+		/** maximum number of events read from the connection at once */
+		uint64_t maxQueueLength {0};
+	};
+
+	/** consecutive motion events for the same window are merged into the latest one (default) */
+	void setCoalesceMotionEvents (bool state);
+	bool getCoalesceMotionEvents () const;
+	/** all positions merged into the motion event currently dispatched, oldest first and
+	 *	including the dispatched event */
+	const MotionHistory& getMotionHistory () const;
+	const EventStatistics& getEventStatistics () const;
+
 	static RunLoop& instance ();
 
 private:
@@ -94,6 +94,7 @@ void CGDrawContext::endDraw ()
 			cgBitmap->setDirty ();
 	}
 	bitmapDrawCount.clear ();
+	COffscreenContext::endDraw ();
 }
 
 //-----------------------------------------------------------------------------
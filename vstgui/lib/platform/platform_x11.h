@@ -40,6 +40,26 @@ class FrameConfig : public IPlatformFrameConfig
 {
 public:
 	SharedPointer<IRunLoop> runLoop;
+	/** the target rate in frames per second the frame redraws invalidated areas with */
+	uint32_t redrawRate {60};
+};
+
+//------------------------------------------------------------------------
+struct RedrawStatistics
+{
+	/** number of frames drawn */
+	uint64_t numFrames {0};
+	/** number of frames skipped because drawing took longer than a frame or the run loop was
+	 *	late */
+	uint64_t numDroppedFrames {0};
+	/** number of invalidations which were combined into the drawn frames */
+	uint64_t numInvalidations {0};
+	/** time in milliseconds the last frame took to draw */
+	double lastFrameTime {0.};
+	/** average time in milliseconds of all drawn frames */
+	double averageFrameTime {0.};
+	/** maximum time in milliseconds a frame took to draw */
+	double maxFrameTime {0.};
 };
 
 //------------------------------------------------------------------------
@@ -47,6 +67,8 @@ class IX11Frame
 {
 public:
 	virtual uint32_t getX11WindowID () const = 0;
+	/** statistics of the redraws, empty if the frame does not record them */
+	virtual RedrawStatistics getRedrawStatistics () const { return {}; }
 };
 
 //------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "platformfactory.h"
+#include "iplatformbitmap.h"
 
 #if MAC
 #include "mac/macfactory.h"
@@ -47,5 +48,25 @@ const IPlatformFactory& getPlatformFactory ()
 	return *gPlatformFactory.get ();
 }
 
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr IPlatformFactory::createBitmapFromReader (
+	const BitmapDataReader& reader) const noexcept
+{
+	static constexpr uint32_t kChunkSize = 0x10000;
+	PNGBitmapBuffer buffer;
+	while (true)
+	{
+		auto size = buffer.size ();
+		buffer.resize (size + kChunkSize);
+		auto numBytes = reader (buffer.data () + size, kChunkSize);
+		if (numBytes > kChunkSize)
+			return nullptr;
+		buffer.resize (size + numBytes);
+		if (numBytes == 0)
+			break;
+	}
+	return createBitmapFromMemory (buffer.data (), static_cast<uint32_t> (buffer.size ()));
+}
+
 //-----------------------------------------------------------------------------
 } // VSTGUI
@@ -93,6 +93,12 @@ public:
 	 */
 	virtual PlatformBitmapPtr createBitmapFromMemory (const void* ptr,
 													  uint32_t memSize) const noexcept = 0;
+	/** Create a platform bitmap object from data which is read piece by piece, i.e. while it is
+	 *	decoded. The default implementation reads all data into memory first.
+	 *	@param reader called to read the next bytes of the bitmap data
+	 *	@return platform bitmap or nullptr on failure
+	 */
+	virtual PlatformBitmapPtr createBitmapFromReader (const BitmapDataReader& reader) const noexcept;
 	/** Create a memory representation of the platform bitmap in PNG format.
 	 *	@param bitmap the platform bitmap object
 	 *	@return memory buffer containing the PNG representation of the bitmap
@@ -19,6 +19,8 @@ namespace VSTGUI {
 
 using PNGBitmapBuffer = std::vector<uint8_t>;
 using FontFamilyCallback = std::function<bool (const std::string&)>;
+/** reads the next bytes into buffer and returns the number of bytes read, 0 at the end */
+using BitmapDataReader = std::function<uint32_t (uint8_t* buffer, uint32_t size)>;
 
 class LinuxFactory;
 class MacFactory;
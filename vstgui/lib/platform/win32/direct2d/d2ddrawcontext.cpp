@@ -229,6 +229,7 @@ void D2DDrawContext::endDraw ()
 			D2DBitmapCache::instance ()->removeBitmap (d2dBitmap);
 		}
 	}
+	COffscreenContext::endDraw ();
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,324 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "timerwheel.h"
+#include "platform/platformfactory.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+constexpr TimerWheel::Milliseconds TimerWheel::kNever;
+
+//------------------------------------------------------------------------
+void TimerWheel::List::pushBack (Entry& entry)
+{
+	entry.prev = head.prev;
+	entry.next = &head;
+	head.prev->next = &entry;
+	head.prev = &entry;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::List::takeFrom (List& other)
+{
+	vstgui_assert (empty ());
+	if (other.empty ())
+		return;
+	head.next = other.head.next;
+	head.prev = other.head.prev;
+	head.next->prev = &head;
+	head.prev->next = &head;
+	other.head.prev = other.head.next = &other.head;
+}
+
+//------------------------------------------------------------------------
+static thread_local std::unique_ptr<TimerWheel> currentWheel;
+
+//------------------------------------------------------------------------
+TimerWheel& TimerWheel::current ()
+{
+	if (!currentWheel)
+		currentWheel = std::unique_ptr<TimerWheel> (new TimerWheel (true));
+	return *currentWheel;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::releaseCurrent ()
+{
+	currentWheel = nullptr;
+}
+
+//------------------------------------------------------------------------
+TimerWheel::Milliseconds TimerWheel::now ()
+{
+	using namespace std::chrono;
+	return static_cast<Milliseconds> (
+	    duration_cast<milliseconds> (steady_clock::now ().time_since_epoch ()).count ());
+}
+
+//------------------------------------------------------------------------
+TimerWheel::TimerWheel (bool usePlatformTimer)
+: usePlatformTimer (usePlatformTimer)
+{
+	if (usePlatformTimer)
+		currentTime = now ();
+}
+
+//------------------------------------------------------------------------
+TimerWheel::~TimerWheel () noexcept
+{
+	if (platformTimer)
+		platformTimer->stop ();
+	auto release = [] (List& list) {
+		while (!list.empty ())
+			unlink (*list.head.next);
+	};
+	for (auto& list : level0)
+		release (list);
+	for (auto& list : level1)
+		release (list);
+	release (overflow);
+}
+
+//------------------------------------------------------------------------
+TimerWheel::Milliseconds TimerWheel::alignDueTime (Milliseconds due, uint32_t interval)
+{
+	Milliseconds grid = 1;
+	while (grid * 2 <= interval / 4 && grid * 2 <= 16)
+		grid *= 2;
+	return (due + grid - 1) & ~(grid - 1);
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::unlink (Entry& entry)
+{
+	entry.prev->next = entry.next;
+	entry.next->prev = entry.prev;
+	entry.prev = entry.next = nullptr;
+}
+
+//------------------------------------------------------------------------
+TimerWheel::Milliseconds TimerWheel::getMinDueTime (const List& list)
+{
+	auto result = kNever;
+	for (auto entry = list.head.next; entry != &list.head; entry = entry->next)
+		result = std::min (result, entry->due);
+	return result;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::insert (Entry& entry)
+{
+	vstgui_assert (entry.due > currentTime);
+	auto delta = entry.due - currentTime;
+	if (delta < kLevel0Size)
+		level0[entry.due & (kLevel0Size - 1)].pushBack (entry);
+	else if (delta < kLevel1Span)
+		level1[(entry.due >> kLevel0Bits) & (kLevel1Size - 1)].pushBack (entry);
+	else
+		overflow.pushBack (entry);
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::cascade (List& list)
+{
+	List entries;
+	entries.takeFrom (list);
+	while (!entries.empty ())
+	{
+		auto& entry = *entries.head.next;
+		unlink (entry);
+		insert (entry);
+	}
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::rebase (Milliseconds time)
+{
+	List entries;
+	auto collect = [&] (List& list) {
+		while (!list.empty ())
+		{
+			auto& entry = *list.head.next;
+			unlink (entry);
+			entries.pushBack (entry);
+		}
+	};
+	for (auto& list : level0)
+		collect (list);
+	for (auto& list : level1)
+		collect (list);
+	collect (overflow);
+	currentTime = time;
+	cascade (entries);
+}
+
+//------------------------------------------------------------------------
+bool TimerWheel::schedule (Entry& entry, uint32_t interval, Milliseconds time)
+{
+	if (entry.isScheduled ())
+		cancel (entry);
+	if (numEntries == 0)
+		currentTime = std::max (currentTime, time);
+	entry.interval = std::max<uint32_t> (interval, 1);
+	entry.due = alignDueTime (std::max (currentTime, time) + entry.interval, entry.interval);
+	insert (entry);
+	++numEntries;
+	if (usePlatformTimer && advanceDepth == 0)
+	{
+		if (!updatePlatformTimer (time))
+		{
+			cancel (entry);
+			return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::cancel (Entry& entry)
+{
+	if (!entry.isScheduled ())
+		return;
+	unlink (entry);
+	--numEntries;
+	if (usePlatformTimer && advanceDepth == 0)
+		updatePlatformTimer (now ());
+}
+
+//------------------------------------------------------------------------
+TimerWheel::Milliseconds TimerWheel::getNextDueTime () const
+{
+	if (numEntries == 0)
+		return kNever;
+	auto result = kNever;
+	for (auto i = 1u; i < kLevel0Size; ++i)
+	{
+		auto time = currentTime + i;
+		if (!level0[time & (kLevel0Size - 1)].empty ())
+		{
+			result = time;
+			break;
+		}
+	}
+	auto block = currentTime >> kLevel0Bits;
+	for (auto i = 1u; i <= kLevel1Size; ++i)
+	{
+		const auto& list = level1[(block + i) & (kLevel1Size - 1)];
+		if (!list.empty ())
+		{
+			result = std::min (result, getMinDueTime (list));
+			break;
+		}
+	}
+	return std::min (result, getMinDueTime (overflow));
+}
+
+//------------------------------------------------------------------------
+uint32_t TimerWheel::advance (Milliseconds time)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	uint32_t numFired = 0;
+	++advanceDepth;
+	while (currentTime < time && numEntries > 0)
+	{
+		// skip the empty slots up to the next due time
+		auto target = std::min (getNextDueTime (), time);
+		if (target - currentTime > kLevel0Size)
+			rebase (target - 1);
+		while (currentTime < target)
+		{
+			auto tick = currentTime + 1;
+			if ((tick & (kLevel0Size - 1)) == 0)
+			{
+				if ((tick & (kLevel1Span - 1)) == 0)
+					cascade (overflow);
+				cascade (level1[(tick >> kLevel0Bits) & (kLevel1Size - 1)]);
+			}
+			currentTime = tick;
+			auto& slot = level0[tick & (kLevel0Size - 1)];
+			if (slot.empty ())
+				continue;
+			List firing;
+			firing.takeFrom (slot);
+			while (!firing.empty ())
+			{
+				// the entry is scheduled again before it fires, so that its callback can stop it.
+				// The next due time follows the previous one, so that late wakeups do not
+				// lengthen the period. A wakeup later than a whole period fires only once like a
+				// platform timer and skips the missed periods.
+				auto& entry = *firing.head.next;
+				unlink (entry);
+				entry.due += entry.interval;
+				if (entry.due <= time)
+					entry.due += ((time - entry.due) / entry.interval + 1) * entry.interval;
+				insert (entry);
+				++numFired;
+				entry.callback->fire ();
+			}
+		}
+	}
+	if (numEntries == 0)
+		currentTime = std::max (currentTime, time);
+	--advanceDepth;
+	if (numFired)
+	{
+		auto duration = std::chrono::duration_cast<std::chrono::microseconds> (
+		    std::chrono::steady_clock::now () - startTime);
+		auto micros = static_cast<uint64_t> (duration.count ());
+		++statistics.numTicks;
+		statistics.numFired += numFired;
+		statistics.maxFiredPerTick = std::max<uint64_t> (statistics.maxFiredPerTick, numFired);
+		statistics.lastTickMicroseconds = micros;
+		statistics.maxTickMicroseconds = std::max (statistics.maxTickMicroseconds, micros);
+		statistics.totalTickMicroseconds += micros;
+	}
+	return numFired;
+}
+
+//------------------------------------------------------------------------
+void TimerWheel::fire ()
+{
+	auto time = now ();
+	advance (time);
+	updatePlatformTimer (time);
+}
+
+//------------------------------------------------------------------------
+bool TimerWheel::updatePlatformTimer (Milliseconds time)
+{
+	auto next = getNextDueTime ();
+	if (next == kNever)
+	{
+		if (platformTimer)
+		{
+			platformTimer->stop ();
+			platformTimer = nullptr;
+			platformTimerInterval = 0;
+		}
+		return true;
+	}
+	auto delay = static_cast<uint32_t> (
+	    std::min<Milliseconds> (next > time ? next - time : 1, std::numeric_limits<uint32_t>::max ()));
+	if (platformTimer && delay == platformTimerInterval)
+		return true;
+	if (platformTimer)
+		platformTimer->stop ();
+	else
+		platformTimer = getPlatformFactory ().createTimer (this);
+	if (!platformTimer || !platformTimer->start (delay))
+	{
+		platformTimer = nullptr;
+		platformTimerInterval = 0;
+		return false;
+	}
+	platformTimerInterval = delay;
+	++statistics.numRearms;
+	return true;
+}
+
+} // VSTGUI
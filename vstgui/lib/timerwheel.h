@@ -0,0 +1,141 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include "platform/iplatformtimer.h"
+#include <array>
+#include <limits>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+/** Hierarchical timer wheel
+ *
+ *	Schedules periodic timers with a resolution of one millisecond. The first level has a slot
+ *	per millisecond for the next 256 milliseconds, the second level a slot per 256 milliseconds
+ *	for the next 16 seconds, timers due later are kept in an overflow list.
+ *
+ *	The first due time of a timer is rounded up to a grid depending on its interval (a quarter of
+ *	the interval rounded down to a power of two, at most 16 milliseconds), so that timers with
+ *	similar intervals fire together in one wakeup even if they were started out of phase. The
+ *	following due times are a multiple of the interval after the first one.
+ *
+ *	CVSTGUITimer uses the wheel of the current thread which is driven by a single platform timer,
+ *	armed for the next due time.
+ */
+class TimerWheel final : public IPlatformTimerCallback
+{
+public:
+	using Milliseconds = uint64_t;
+	static constexpr Milliseconds kNever = std::numeric_limits<Milliseconds>::max ();
+
+	//------------------------------------------------------------------------
+	class Entry
+	{
+	public:
+		explicit Entry (IPlatformTimerCallback* callback) : callback (callback) {}
+		Entry (const Entry&) = delete;
+		Entry& operator= (const Entry&) = delete;
+
+		bool isScheduled () const { return next != nullptr; }
+		uint32_t getInterval () const { return interval; }
+		Milliseconds getDueTime () const { return due; }
+
+	private:
+		friend class TimerWheel;
+		IPlatformTimerCallback* callback;
+		uint32_t interval {0};
+		Milliseconds due {0};
+		Entry* prev {nullptr};
+		Entry* next {nullptr};
+	};
+
+	//------------------------------------------------------------------------
+	struct Statistics
+	{
+		/** number of advance calls which fired at least one timer */
+		uint64_t numTicks {0};
+		/** number of fired timers */
+		uint64_t numFired {0};
+		/** maximum number of timers fired in one tick */
+		uint64_t maxFiredPerTick {0};
+		/** number of times the platform timer was started with a new interval */
+		uint64_t numRearms {0};
+		uint64_t lastTickMicroseconds {0};
+		uint64_t maxTickMicroseconds {0};
+		uint64_t totalTickMicroseconds {0};
+	};
+
+	/** the wheel of the calling thread, driven by a platform timer */
+	static TimerWheel& current ();
+	/** destroy the wheel of the calling thread and stop its platform timer, called by
+	 *	VSTGUI::exit before the platform is released */
+	static void releaseCurrent ();
+	/** monotonic time in milliseconds */
+	static Milliseconds now ();
+
+	explicit TimerWheel (bool usePlatformTimer = false);
+	~TimerWheel () noexcept;
+
+	/** schedule entry to fire every interval milliseconds, reschedules an already scheduled
+	 *	entry. Returns false if the platform timer could not be started. */
+	bool schedule (Entry& entry, uint32_t interval, Milliseconds now);
+	/** remove entry from the wheel */
+	void cancel (Entry& entry);
+
+	/** fire all entries due until time now, returns the number of fired entries */
+	uint32_t advance (Milliseconds now);
+	/** earliest due time of all entries or kNever */
+	Milliseconds getNextDueTime () const;
+
+	size_t getNumEntries () const { return numEntries; }
+	const Statistics& getStatistics () const { return statistics; }
+	void resetStatistics () { statistics = {}; }
+
+private:
+	struct List
+	{
+		List () { head.prev = head.next = &head; }
+		List (const List&) = delete;
+		List& operator= (const List&) = delete;
+
+		bool empty () const { return head.next == &head; }
+		void pushBack (Entry& entry);
+		void takeFrom (List& other);
+
+		Entry head {nullptr};
+	};
+
+	static constexpr uint32_t kLevel0Bits = 8;
+	static constexpr uint32_t kLevel1Bits = 6;
+	static constexpr Milliseconds kLevel0Size = 1 << kLevel0Bits;
+	static constexpr Milliseconds kLevel1Size = 1 << kLevel1Bits;
+	static constexpr Milliseconds kLevel1Span = kLevel0Size * kLevel1Size;
+
+	static Milliseconds alignDueTime (Milliseconds due, uint32_t interval);
+	static void unlink (Entry& entry);
+	static Milliseconds getMinDueTime (const List& list);
+
+	void insert (Entry& entry);
+	void cascade (List& list);
+	void rebase (Milliseconds now);
+	void fire () override;
+	bool updatePlatformTimer (Milliseconds now);
+
+	std::array<List, kLevel0Size> level0;
+	std::array<List, kLevel1Size> level1;
+	List overflow;
+	Milliseconds currentTime {0};
+	size_t numEntries {0};
+	uint32_t advanceDepth {0};
+	Statistics statistics;
+
+	bool usePlatformTimer;
+	PlatformTimerPtr platformTimer;
+	uint32_t platformTimerInterval {0};
+};
+
+} // VSTGUI
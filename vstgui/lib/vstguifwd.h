@@ -170,6 +170,7 @@ class ITouchEvent;
 // classes
 class CBitmap;
 class CNinePartTiledBitmap;
+class CSpriteAtlas;
 class CResourceDescription;
 class CLineStyle;
 class CDrawContext;
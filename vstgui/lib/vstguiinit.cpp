@@ -2,6 +2,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "platform/platformfactory.h"
+#include "timerwheel.h"
 
 //-----------------------------------------------------------------------------
 namespace VSTGUI {
@@ -15,6 +16,7 @@ void init (PlatformInstanceHandle instance)
 //-----------------------------------------------------------------------------
 void exit ()
 {
+	TimerWheel::releaseCurrent ();
 	exitPlatform ();
 }
 
@@ -0,0 +1,103 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "workerpool.h"
+#include <algorithm>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+constexpr uint32_t WorkerPool::kMaxThreads;
+
+//------------------------------------------------------------------------
+std::shared_ptr<WorkerPool> WorkerPool::get ()
+{
+	static std::mutex mutex;
+	static std::weak_ptr<WorkerPool> instance;
+	std::lock_guard<std::mutex> guard (mutex);
+	auto pool = instance.lock ();
+	if (!pool)
+	{
+		pool = std::make_shared<WorkerPool> ();
+		instance = pool;
+	}
+	return pool;
+}
+
+//------------------------------------------------------------------------
+WorkerPool::WorkerPool ()
+{
+	auto numCores = std::max (std::thread::hardware_concurrency (), 1u);
+	auto numWorkers = std::min (numCores, kMaxThreads) - 1;
+	for (auto i = 0u; i < numWorkers; ++i)
+		workers.emplace_back ([this] () { workerLoop (); });
+}
+
+//------------------------------------------------------------------------
+WorkerPool::~WorkerPool () noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		stop = true;
+	}
+	wakeUp.notify_all ();
+	for (auto& worker : workers)
+		worker.join ();
+}
+
+//------------------------------------------------------------------------
+void WorkerPool::parallelFor (uint32_t count, uint32_t maxThreads, const Task& task)
+{
+	std::lock_guard<std::mutex> runGuard (runMutex);
+	Job job (task, count);
+	auto helpersWanted = std::min (std::min (maxThreads, count), getNumThreads ()) - 1;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		job.helpersWanted = helpersWanted;
+		currentJob = &job;
+		++generation;
+	}
+	if (helpersWanted)
+		wakeUp.notify_all ();
+	job.work ();
+	std::unique_lock<std::mutex> lock (mutex);
+	jobDone.wait (lock, [&] () { return job.activeHelpers == 0; });
+	currentJob = nullptr;
+}
+
+//------------------------------------------------------------------------
+void WorkerPool::Job::work ()
+{
+	uint32_t index;
+	while ((index = nextIndex.fetch_add (1)) < count)
+		task (index);
+}
+
+//------------------------------------------------------------------------
+void WorkerPool::workerLoop ()
+{
+	uint64_t seenGeneration = 0;
+	std::unique_lock<std::mutex> lock (mutex);
+	while (true)
+	{
+		wakeUp.wait (lock, [&] () {
+			return stop || (currentJob && generation != seenGeneration);
+		});
+		if (stop)
+			return;
+		seenGeneration = generation;
+		auto job = currentJob;
+		if (job->helpersWanted == 0)
+			continue;
+		--job->helpersWanted;
+		++job->activeHelpers;
+		lock.unlock ();
+		job->work ();
+		lock.lock ();
+		if (--job->activeHelpers == 0)
+			jobDone.notify_all ();
+	}
+}
+
+} // VSTGUI
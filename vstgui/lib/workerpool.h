@@ -0,0 +1,70 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguibase.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+/** Pool of worker threads
+ *
+ *	The pool is shared by all its users and destroyed together with the last user, so that no
+ *	thread is left running when the library is unloaded.
+ */
+class WorkerPool
+{
+public:
+	using Task = std::function<void (uint32_t index)>;
+
+	static constexpr uint32_t kMaxThreads = 8;
+
+	/** the shared pool */
+	static std::shared_ptr<WorkerPool> get ();
+
+	WorkerPool ();
+	~WorkerPool () noexcept;
+
+	/** number of threads working on a job including the calling thread */
+	uint32_t getNumThreads () const { return static_cast<uint32_t> (workers.size ()) + 1; }
+
+	/** call task for every index in [0, count) on the calling thread and at most maxThreads - 1
+	 *	workers, returns after all tasks are done. Must not be called from a task. */
+	void parallelFor (uint32_t count, uint32_t maxThreads, const Task& task);
+
+private:
+	struct Job
+	{
+		Job (const Task& task, uint32_t count) : task (task), count (count) {}
+
+		void work ();
+
+		const Task& task;
+		const uint32_t count;
+		std::atomic<uint32_t> nextIndex {0};
+		uint32_t helpersWanted {0};
+		uint32_t activeHelpers {0};
+	};
+
+	void workerLoop ();
+
+	std::vector<std::thread> workers;
+	std::mutex runMutex;
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::condition_variable jobDone;
+	Job* currentJob {nullptr};
+	uint64_t generation {0};
+	bool stop {false};
+};
+
+} // VSTGUI
@@ -2,7 +2,9 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
-#include "../../../include/iasync.h"
+#include "gdkasync.h"
+#include <glib.h>
+#include <thread>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -10,6 +12,33 @@ namespace Standalone {
 namespace Platform {
 namespace GDK {
 
+//------------------------------------------------------------------------
+static TaskExecutor& backgroundExecutor ()
+{
+	static TaskExecutor executor;
+	return executor;
+}
+
+//------------------------------------------------------------------------
+static void postToRunLoop (TaskExecutor::Task&& t)
+{
+	auto task = new TaskExecutor::Task (std::move (t));
+	auto source = g_idle_source_new ();
+	g_source_set_priority (source, G_PRIORITY_DEFAULT);
+	g_source_set_callback (source,
+						   [] (gpointer userData) -> gboolean {
+							   auto task = static_cast<TaskExecutor::Task*> (userData);
+							   (*task) ();
+							   return G_SOURCE_REMOVE;
+						   },
+						   task,
+						   [] (gpointer userData) {
+							   delete static_cast<TaskExecutor::Task*> (userData);
+						   });
+	g_source_attach (source, g_main_context_default ());
+	g_source_unref (source);
+}
+
 //------------------------------------------------------------------------
 } // GDK
 } // Platform
@@ -17,34 +46,79 @@ namespace GDK {
 //------------------------------------------------------------------------
 namespace Async {
 
+using Platform::GDK::TaskExecutor;
+
 //------------------------------------------------------------------------
 struct Queue
 {
-	void schedule (Task&& task)
+	virtual ~Queue () noexcept = default;
+
+	virtual void schedule (Task&& task) = 0;
+	virtual uint32_t cancelPending () = 0;
+	virtual TaskExecutor::Statistics getStatistics () const = 0;
+};
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+struct BackgroundQueue final : Queue
+{
+	void schedule (Task&& task) override
+	{
+		Platform::GDK::backgroundExecutor ().schedule (std::move (task));
+	}
+
+	uint32_t cancelPending () override
+	{
+		return Platform::GDK::backgroundExecutor ().cancelPending ();
+	}
+
+	TaskExecutor::Statistics getStatistics () const override
+	{
+		return Platform::GDK::backgroundExecutor ().getStatistics ();
+	}
+};
+
+//------------------------------------------------------------------------
+struct SerialQueue final : Queue
+{
+	explicit SerialQueue (std::shared_ptr<TaskExecutor::SerialQueue>&& queue)
+	: queue (std::move (queue))
 	{
-		// TODO: scheduling not implemented yet
-		task ();
 	}
+
+	void schedule (Task&& task) override { queue->schedule (std::move (task)); }
+	uint32_t cancelPending () override { return queue->cancelPending (); }
+	TaskExecutor::Statistics getStatistics () const override { return queue->getStatistics (); }
+
+private:
+	std::shared_ptr<TaskExecutor::SerialQueue> queue;
 };
 
+//------------------------------------------------------------------------
+} // anonymous
+
 //------------------------------------------------------------------------
 const QueuePtr& mainQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<SerialQueue> (
+		TaskExecutor::SerialQueue::make (Platform::GDK::postToRunLoop));
 	return q;
 }
 
 //------------------------------------------------------------------------
 const QueuePtr& backgroundQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<BackgroundQueue> ();
 	return q;
 }
 
 //------------------------------------------------------------------------
 QueuePtr makeSerialQueue (const char* name)
 {
-	return std::make_shared<Queue> ();
+	// the executor threads are not named per queue
+	return std::make_shared<SerialQueue> (Platform::GDK::backgroundExecutor ().makeSerialQueue ());
 }
 
 //------------------------------------------------------------------------
@@ -55,5 +129,36 @@ void schedule (QueuePtr queue, Task&& task)
 
 //------------------------------------------------------------------------
 } // Async
+
+//------------------------------------------------------------------------
+namespace Platform {
+namespace GDK {
+
+//------------------------------------------------------------------------
+void terminateAsyncHandling ()
+{
+	auto context = g_main_context_default ();
+	while (!backgroundExecutor ().isIdle () || Async::mainQueue ()->getStatistics ().queueDepth)
+	{
+		if (!g_main_context_iteration (context, false))
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+	}
+}
+
+//------------------------------------------------------------------------
+uint32_t cancelPendingTasks (const Async::QueuePtr& queue)
+{
+	return queue->cancelPending ();
+}
+
+//------------------------------------------------------------------------
+TaskExecutor::Statistics getQueueStatistics (const Async::QueuePtr& queue)
+{
+	return queue->getStatistics ();
+}
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
 } // Standalone
 } // VSTGUI
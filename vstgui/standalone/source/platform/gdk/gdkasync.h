@@ -0,0 +1,28 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../../include/iasync.h"
+#include "gdktaskexecutor.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Platform {
+namespace GDK {
+
+//------------------------------------------------------------------------
+/** perform the tasks of the main queue until all background tasks are done */
+void terminateAsyncHandling ();
+
+/** cancel the tasks of queue which have not started yet, returns the number of cancelled tasks */
+uint32_t cancelPendingTasks (const Async::QueuePtr& queue);
+TaskExecutor::Statistics getQueueStatistics (const Async::QueuePtr& queue);
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
+} // Standalone
+} // VSTGUI
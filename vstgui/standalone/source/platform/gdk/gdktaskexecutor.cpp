@@ -0,0 +1,341 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "gdktaskexecutor.h"
+#include <algorithm>
+#include <iterator>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Platform {
+namespace GDK {
+
+namespace {
+
+//------------------------------------------------------------------------
+thread_local const TaskExecutor* currentExecutor = nullptr;
+thread_local uint32_t currentWorkerIndex = 0;
+
+//------------------------------------------------------------------------
+template<typename T>
+void storeMax (std::atomic<T>& value, T newValue)
+{
+	auto current = value.load ();
+	while (current < newValue && !value.compare_exchange_weak (current, newValue))
+	{
+	}
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+bool TaskExecutor::Handle::cancel ()
+{
+	if (!state)
+		return false;
+	uint32_t expected = Pending;
+	if (state->compare_exchange_strong (expected, Cancelled))
+		return true;
+	return expected == Cancelled;
+}
+
+//------------------------------------------------------------------------
+bool TaskExecutor::Handle::isCancelled () const
+{
+	return state && *state == Cancelled;
+}
+
+//------------------------------------------------------------------------
+void TaskExecutor::Metrics::taskScheduled ()
+{
+	++numScheduled;
+	storeMax (maxQueueDepth, ++queueDepth);
+}
+
+//------------------------------------------------------------------------
+bool TaskExecutor::Metrics::taskStarting (const Item& item)
+{
+	--queueDepth;
+	uint32_t expected = Handle::Pending;
+	if (!item.state->compare_exchange_strong (expected, Handle::Started))
+	{
+		++numCancelled;
+		return false;
+	}
+	auto latency = static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::microseconds> (
+											  Clock::now () - item.scheduleTime)
+											  .count ());
+	lastLatency = latency;
+	totalLatency += latency;
+	storeMax (maxLatency, latency);
+	++numExecuted;
+	return true;
+}
+
+//------------------------------------------------------------------------
+void TaskExecutor::Metrics::tasksCancelled (uint32_t num)
+{
+	queueDepth -= num;
+	numCancelled += num;
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::Metrics::get () const -> Statistics
+{
+	Statistics statistics;
+	statistics.numScheduled = numScheduled;
+	statistics.numExecuted = numExecuted;
+	statistics.numCancelled = numCancelled;
+	statistics.queueDepth = queueDepth;
+	statistics.maxQueueDepth = maxQueueDepth;
+	statistics.lastLatencyMicroseconds = lastLatency;
+	statistics.maxLatencyMicroseconds = maxLatency;
+	statistics.totalLatencyMicroseconds = totalLatency;
+	return statistics;
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::SerialQueue::make (PostFunc&& post) -> std::shared_ptr<SerialQueue>
+{
+	return std::shared_ptr<SerialQueue> (new SerialQueue (std::move (post)));
+}
+
+//------------------------------------------------------------------------
+TaskExecutor::SerialQueue::SerialQueue (PostFunc&& post) : post (std::move (post))
+{
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::SerialQueue::schedule (Task&& task) -> Handle
+{
+	auto item = makeItem (std::move (task), false);
+	Handle handle (item.state);
+	bool doPost;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		metrics.taskScheduled ();
+		items.push_back (std::move (item));
+		doPost = !posted;
+		posted = true;
+	}
+	if (doPost)
+		post ([self = shared_from_this ()] () { self->performTasks (); });
+	return handle;
+}
+
+//------------------------------------------------------------------------
+void TaskExecutor::SerialQueue::performTasks ()
+{
+	// post again after some tasks so that a busy serial queue does not block a worker or the run
+	// loop for too long
+	constexpr uint32_t kMaxTasksPerPost = 32;
+
+	for (auto i = 0u; i <= kMaxTasksPerPost; ++i)
+	{
+		Item item;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			if (items.empty ())
+			{
+				posted = false;
+				return;
+			}
+			if (i == kMaxTasksPerPost)
+				break;
+			item = std::move (items.front ());
+			items.pop_front ();
+		}
+		if (metrics.taskStarting (item))
+			item.task ();
+	}
+	post ([self = shared_from_this ()] () { self->performTasks (); });
+}
+
+//------------------------------------------------------------------------
+uint32_t TaskExecutor::SerialQueue::cancelPending ()
+{
+	std::deque<Item> cancelled;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		cancelled.swap (items);
+	}
+	for (auto& item : cancelled)
+		item.state->store (Handle::Cancelled);
+	auto num = static_cast<uint32_t> (cancelled.size ());
+	metrics.tasksCancelled (num);
+	return num;
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::SerialQueue::getStatistics () const -> Statistics
+{
+	return metrics.get ();
+}
+
+//------------------------------------------------------------------------
+TaskExecutor::TaskExecutor (uint32_t numThreads)
+{
+	if (numThreads == 0)
+		numThreads = std::max (std::thread::hardware_concurrency (), 1u);
+	for (auto i = 0u; i < numThreads; ++i)
+		workers.emplace_back (std::unique_ptr<Worker> (new Worker));
+	for (auto i = 0u; i < numThreads; ++i)
+		workers[i]->thread = std::thread ([this, i] () { workerLoop (i); });
+}
+
+//------------------------------------------------------------------------
+TaskExecutor::~TaskExecutor () noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		stop = true;
+	}
+	wakeUp.notify_all ();
+	for (auto& worker : workers)
+		worker->thread.join ();
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::makeItem (Task&& task, bool internal) -> Item
+{
+	Item item;
+	item.task = std::move (task);
+	if (!internal)
+		item.state = std::make_shared<std::atomic<uint32_t>> (Handle::Pending);
+	item.scheduleTime = Clock::now ();
+	return item;
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::schedule (Task&& task) -> Handle
+{
+	auto item = makeItem (std::move (task), false);
+	Handle handle (item.state);
+	metrics.taskScheduled ();
+	post (std::move (item));
+	return handle;
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::makeSerialQueue () -> std::shared_ptr<SerialQueue>
+{
+	return SerialQueue::make ([this] (Task&& task) { post (makeItem (std::move (task), true)); });
+}
+
+//------------------------------------------------------------------------
+void TaskExecutor::post (Item&& item)
+{
+	++numUnfinished;
+	// counted before the item is visible to the workers, a worker seeing the count before the item
+	// was added just looks again
+	++numQueued;
+	auto index = currentExecutor == this ? currentWorkerIndex
+	                                     : nextWorker++ % static_cast<uint32_t> (workers.size ());
+	{
+		std::lock_guard<std::mutex> guard (workers[index]->mutex);
+		workers[index]->items.push_back (std::move (item));
+	}
+	{
+		// a worker checks numQueued and goes to sleep while holding the mutex, so the
+		// notification below cannot get lost
+		std::lock_guard<std::mutex> guard (mutex);
+	}
+	wakeUp.notify_one ();
+}
+
+//------------------------------------------------------------------------
+uint32_t TaskExecutor::cancelPending ()
+{
+	std::deque<Item> cancelled;
+	for (auto& worker : workers)
+	{
+		std::lock_guard<std::mutex> guard (worker->mutex);
+		auto it = std::stable_partition (worker->items.begin (), worker->items.end (),
+		                                 [] (const Item& item) { return item.state == nullptr; });
+		std::move (it, worker->items.end (), std::back_inserter (cancelled));
+		worker->items.erase (it, worker->items.end ());
+	}
+	for (auto& item : cancelled)
+		item.state->store (Handle::Cancelled);
+	auto num = static_cast<uint32_t> (cancelled.size ());
+	numQueued -= num;
+	metrics.tasksCancelled (num);
+	cancelled.clear ();
+	tasksFinished (num);
+	return num;
+}
+
+//------------------------------------------------------------------------
+void TaskExecutor::tasksFinished (uint32_t num)
+{
+	if (num == 0 || numUnfinished.fetch_sub (num) != num)
+		return;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+	}
+	idle.notify_all ();
+}
+
+//------------------------------------------------------------------------
+void TaskExecutor::waitUntilIdle ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	idle.wait (lock, [&] () { return numUnfinished == 0; });
+}
+
+//------------------------------------------------------------------------
+auto TaskExecutor::getStatistics () const -> Statistics
+{
+	return metrics.get ();
+}
+
+//------------------------------------------------------------------------
+bool TaskExecutor::takeItem (uint32_t workerIndex, Item& item)
+{
+	// the own queue first, then steal from the others
+	auto numWorkers = static_cast<uint32_t> (workers.size ());
+	for (auto i = 0u; i < numWorkers; ++i)
+	{
+		auto& worker = *workers[(workerIndex + i) % numWorkers];
+		std::lock_guard<std::mutex> guard (worker.mutex);
+		if (worker.items.empty ())
+			continue;
+		item = std::move (worker.items.front ());
+		worker.items.pop_front ();
+		--numQueued;
+		return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+void TaskExecutor::workerLoop (uint32_t workerIndex)
+{
+	currentExecutor = this;
+	currentWorkerIndex = workerIndex;
+	Item item;
+	while (true)
+	{
+		if (takeItem (workerIndex, item))
+		{
+			if (!item.state || metrics.taskStarting (item))
+				item.task ();
+			item.task = nullptr;
+			item.state = nullptr;
+			tasksFinished (1);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock (mutex);
+		if (stop && numQueued == 0)
+			return;
+		wakeUp.wait (lock, [&] () { return stop || numQueued > 0; });
+	}
+}
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
+} // Standalone
+} // VSTGUI
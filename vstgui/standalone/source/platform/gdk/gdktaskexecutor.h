@@ -0,0 +1,185 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../../../lib/vstguibase.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Platform {
+namespace GDK {
+
+//------------------------------------------------------------------------
+/** Work stealing pool of threads performing asynchronous tasks
+ *
+ *	Every worker thread has its own queue. Tasks scheduled from a worker are added to the queue of
+ *	that worker, other tasks are distributed round robin. A worker without tasks steals from the
+ *	queues of the other workers before it goes to sleep.
+ *
+ *	Serial queues perform their tasks one after the other in the order they were scheduled, either
+ *	on the executor or on a run loop (see SerialQueue::make).
+ *
+ *	Pending tasks are performed before the destructor returns.
+ */
+class TaskExecutor
+{
+public:
+	using Task = std::function<void ()>;
+	using Clock = std::chrono::steady_clock;
+
+	//------------------------------------------------------------------------
+	struct Statistics
+	{
+		uint64_t numScheduled {0};
+		uint64_t numExecuted {0};
+		uint64_t numCancelled {0};
+		/** number of tasks scheduled but not started or cancelled yet */
+		uint32_t queueDepth {0};
+		uint32_t maxQueueDepth {0};
+		/** time between scheduling and starting a task */
+		uint64_t lastLatencyMicroseconds {0};
+		uint64_t maxLatencyMicroseconds {0};
+		uint64_t totalLatencyMicroseconds {0};
+	};
+
+	//------------------------------------------------------------------------
+	class Handle
+	{
+	public:
+		Handle () = default;
+
+		/** prevent the task from running, returns false if the task has already started */
+		bool cancel ();
+		bool isCancelled () const;
+
+	private:
+		friend class TaskExecutor;
+		enum State : uint32_t { Pending, Started, Cancelled };
+		using StatePtr = std::shared_ptr<std::atomic<uint32_t>>;
+
+		explicit Handle (const StatePtr& state) : state (state) {}
+
+		StatePtr state;
+	};
+
+private:
+	struct Item
+	{
+		Task task;
+		/** nullptr for the internal tasks performing serial queues */
+		Handle::StatePtr state;
+		Clock::time_point scheduleTime;
+	};
+
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<Item> items;
+		std::thread thread;
+	};
+
+	struct Metrics
+	{
+		void taskScheduled ();
+		/** returns false if the task was cancelled */
+		bool taskStarting (const Item& item);
+		void tasksCancelled (uint32_t num);
+		Statistics get () const;
+
+		std::atomic<uint64_t> numScheduled {0};
+		std::atomic<uint64_t> numExecuted {0};
+		std::atomic<uint64_t> numCancelled {0};
+		std::atomic<uint32_t> queueDepth {0};
+		std::atomic<uint32_t> maxQueueDepth {0};
+		std::atomic<uint64_t> lastLatency {0};
+		std::atomic<uint64_t> maxLatency {0};
+		std::atomic<uint64_t> totalLatency {0};
+	};
+
+public:
+	//------------------------------------------------------------------------
+	class SerialQueue : public std::enable_shared_from_this<SerialQueue>
+	{
+	public:
+		/** posts the task which performs the queued tasks, e.g. to a run loop */
+		using PostFunc = std::function<void (Task&&)>;
+
+		/** a serial queue whose tasks are performed by the tasks passed to post */
+		static std::shared_ptr<SerialQueue> make (PostFunc&& post);
+
+		Handle schedule (Task&& task);
+		/** cancel all tasks which have not started yet, returns the number of cancelled tasks */
+		uint32_t cancelPending ();
+
+		Statistics getStatistics () const;
+
+	private:
+		explicit SerialQueue (PostFunc&& post);
+		void performTasks ();
+
+		PostFunc post;
+		mutable std::mutex mutex;
+		std::deque<Item> items;
+		Metrics metrics;
+		bool posted {false};
+	};
+
+	/** number of worker threads, zero for one per core */
+	explicit TaskExecutor (uint32_t numThreads = 0);
+	~TaskExecutor () noexcept;
+
+	uint32_t getNumThreads () const { return static_cast<uint32_t> (workers.size ()); }
+
+	/** schedule task to be performed on one of the worker threads */
+	Handle schedule (Task&& task);
+	/** cancel all tasks scheduled directly on the executor which have not started yet, returns
+	 *	the number of cancelled tasks */
+	uint32_t cancelPending ();
+
+	/** a serial queue performing its tasks on the worker threads. The executor must outlive the
+	 *	queue. */
+	std::shared_ptr<SerialQueue> makeSerialQueue ();
+
+	/** true if no task is scheduled or running, including the tasks of serial queues */
+	bool isIdle () const { return numUnfinished == 0; }
+	/** block until isIdle. Must not be called from a task. */
+	void waitUntilIdle ();
+
+	/** statistics of the tasks scheduled directly on the executor */
+	Statistics getStatistics () const;
+
+private:
+	static Item makeItem (Task&& task, bool internal);
+	void post (Item&& item);
+	void tasksFinished (uint32_t num);
+	bool takeItem (uint32_t workerIndex, Item& item);
+	void workerLoop (uint32_t workerIndex);
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	Metrics metrics;
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::condition_variable idle;
+	std::atomic<uint32_t> numQueued {0};
+	std::atomic<uint32_t> numUnfinished {0};
+	std::atomic<uint32_t> nextWorker {0};
+	bool stop {false};
+};
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
+} // Standalone
+} // VSTGUI
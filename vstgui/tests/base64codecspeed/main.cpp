@@ -5,10 +5,24 @@
 #include "vstgui/uidescription/base64codec.h"
 #include "vstgui/lib/malloc.h"
 
+#include <chrono>
+#include <cstdio>
 #include <random>
 
 using namespace VSTGUI;
 
+//------------------------------------------------------------------------
+template<typename Proc>
+static auto measure (const char* name, size_t numBytes, Proc proc) -> decltype (proc ())
+{
+	auto start = std::chrono::steady_clock::now ();
+	auto result = proc ();
+	auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () - start);
+	printf ("%s: %.0f ms, %.0f MB/s\n", name, duration.count () * 1000.,
+	        numBytes / duration.count () / (1024. * 1024.));
+	return result;
+}
+
 int main ()
 {
 	Buffer<uint8_t> origData;
@@ -17,8 +31,13 @@ int main ()
 	std::independent_bits_engine<std::default_random_engine, sizeof (uint16_t) * 8, uint16_t> rbe;
 	std::generate (origData.get (), origData.get () + origData.size (), std::ref (rbe));
 
-	auto encoderResult = Base64Codec::encode (origData.get (), origData.size ());
-	auto decoderResult = Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
+	auto encoderResult = measure ("encode", origData.size (), [&] () {
+		return Base64Codec::encode (origData.get (), origData.size ());
+	});
+	auto decoderResult = measure ("decode", origData.size (), [&] () {
+		return Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
+	});
+	printf ("SSSE3: %s\n", VSTGUI_BASE64_SSSE3 ? "yes" : "no");
 
 	if (origData.size () != decoderResult.dataSize)
 		return -1;
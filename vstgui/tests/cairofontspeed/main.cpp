@@ -0,0 +1,76 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/platform/platformfactory.h"
+#include "vstgui/lib/platform/linux/cairofont.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+static const std::vector<UTF8String> labels = {
+	"Cutoff", "Resonance", "Attack", "Decay", "Sustain", "Release", "Drive", "Mix",
+	"-12.5 dB", "0.0 dB", "+3.2 dB", "440 Hz", "1.25 kHz", "12.0 kHz", "35 %", "100 %",
+	"Osc 1", "Osc 2", "Filter", "Amp", "LFO 1", "LFO 2", "Mod Env", "FX"};
+
+//------------------------------------------------------------------------
+static double drawFrames (COffscreenContext* context, CFontDesc* font, uint32_t numFrames)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	for (auto frame = 0u; frame < numFrames; ++frame)
+	{
+		context->beginDraw ();
+		context->setFont (font);
+		context->setFontColor (kBlackCColor);
+		CRect r (0, 0, 80, 20);
+		for (const auto& label : labels)
+		{
+			context->drawString (label.getPlatformString (), r, kCenterText);
+			context->getStringWidth (label.getPlatformString ());
+			r.offset (0, 20);
+		}
+		context->endDraw ();
+	}
+	auto stop = std::chrono::high_resolution_clock::now ();
+	return std::chrono::duration<double, std::micro> (stop - start).count () / numFrames;
+}
+
+//------------------------------------------------------------------------
+int main ()
+{
+	VSTGUI::init (nullptr);
+
+	constexpr uint32_t numFrames = 600;
+	{
+		auto context = getPlatformFactory ().createOffscreenContext ({100, 500});
+		if (!context)
+			return -1;
+		auto font = makeOwned<CFontDesc> ("Arial", 12);
+
+		Cairo::Font::setLayoutCacheSize (0);
+		auto uncachedTime = drawFrames (context, font, numFrames);
+
+		Cairo::Font::setLayoutCacheSize (512);
+		auto cachedTime = drawFrames (context, font, numFrames);
+
+		auto stats = Cairo::Font::getLayoutCacheStatistics ();
+		printf ("%u strings per frame\n", static_cast<uint32_t> (labels.size ()));
+		printf ("without layout cache: %.2f us per frame\n", uncachedTime);
+		printf ("with layout cache:    %.2f us per frame\n", cachedTime);
+		printf ("cache hits: %llu, misses: %llu, entries: %zu\n",
+				static_cast<unsigned long long> (stats.hits),
+				static_cast<unsigned long long> (stats.misses), stats.numEntries);
+	}
+
+	VSTGUI::exit ();
+	return 0;
+}
@@ -0,0 +1,203 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdatabrowser.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/idatabrowserdelegate.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#endif
+
+#if WINDOWS
+#include <windows.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+constexpr int32_t kNumRows = 1000000;
+constexpr int32_t kNumColumns = 4;
+constexpr CCoord kRowHeight = 20.;
+constexpr CCoord kColumnWidth = 100.;
+
+//------------------------------------------------------------------------
+class Delegate : public DataBrowserDelegateAdapter
+{
+public:
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return kNumRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return kNumColumns; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return kRowHeight; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return kColumnWidth;
+	}
+	bool dbGetLineWidthAndColor (CCoord& width, CColor& color, CDataBrowser* browser) override
+	{
+		width = 1.;
+		color = kBlackCColor;
+		return true;
+	}
+	void dbDrawHeader (CDrawContext* context, const CRect& size, int32_t column, int32_t flags,
+	                   CDataBrowser* browser) override
+	{
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+		++numDrawnCells;
+		if (flags & kRowSelected)
+			++numSelectedCells;
+	}
+
+	uint32_t numDrawnCells {0};
+	uint32_t numSelectedCells {0};
+};
+
+//------------------------------------------------------------------------
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& r) : CDrawContext (r) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2, const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override {}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode, CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint, const CPoint& endPoint, bool evenOdd, CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center, CCoord radius, const CPoint& originOffset, bool evenOdd, CGraphicsTransform* transformation) override {}
+};
+
+//------------------------------------------------------------------------
+/** the previous implementation of the row loop as reference: every row is intersected with the
+ *	update rect and looked up in the selection, returns the number of selected cells to draw */
+uint32_t referenceDraw (const CRect& viewSize, const CRect& updateRect,
+                        const std::vector<int32_t>& selection)
+{
+	uint32_t numSelectedCells = 0;
+	CRect r (viewSize);
+	r.setHeight (kRowHeight);
+	for (int32_t row = 0; row < kNumRows; row++)
+	{
+		CRect testRect (r);
+		testRect.bound (updateRect);
+		if (testRect.isEmpty () == false)
+		{
+			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
+			for (int32_t col = 0; col < kNumColumns; col++)
+			{
+				r.setWidth (kColumnWidth);
+				testRect = r;
+				testRect.bound (updateRect);
+				if (testRect.isEmpty () == false && isSelected)
+					++numSelectedCells;
+				r.offset (kColumnWidth + 1., 0);
+			}
+		}
+		r.left = viewSize.left;
+		r.setWidth (viewSize.getWidth ());
+		r.offset (0, kRowHeight + 1.);
+	}
+	return numSelectedCells;
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	proc ();
+	auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () - start);
+	return duration.count () * 1000.;
+}
+
+//------------------------------------------------------------------------
+bool drawVisibleRows ()
+{
+	Delegate delegate;
+	auto style = CDataBrowser::kDrawRowLines | CDataBrowser::kDrawColumnLines |
+	             CDataBrowser::kMultiSelectionStyle;
+	auto browser = owned (new CDataBrowser (CRect (0, 0, 400, 600), &delegate, style, 0));
+	browser->recalculateLayout (true);
+	for (int32_t row = 5; row < 15; ++row)
+		browser->selectRow (row);
+	auto drawContext = owned (new NullDrawContext (CRect (0, 0, 400, 600)));
+	auto updateRect = browser->getViewSize ();
+	auto time = measure ([&] () { browser->drawRect (drawContext, updateRect); });
+	std::vector<int32_t> selection (browser->getSelection ());
+	uint32_t referenceSelectedCells = 0;
+	auto referenceTime = measure ([&] () {
+		referenceSelectedCells = referenceDraw (
+			CRect (0, 0, kNumColumns * (kColumnWidth + 1.), (kRowHeight + 1.) * kNumRows),
+			updateRect, selection);
+	});
+	printf ("draw %d rows: reference: %.2f ms, visible range: %.2f ms\n", kNumRows, referenceTime,
+	        time);
+	if (referenceSelectedCells == delegate.numSelectedCells)
+		return true;
+	printf ("draw %d rows: selected cells differ\n", kNumRows);
+	return false;
+}
+
+//------------------------------------------------------------------------
+bool selectRange ()
+{
+	Delegate delegate;
+	auto browser = owned (new CDataBrowser (CRect (0, 0, 400, 600), &delegate,
+	                                        CDataBrowser::kMultiSelectionStyle, 0));
+	const int32_t numSelected = 20000;
+	auto time = measure ([&] () {
+		for (int32_t row = 0; row < numSelected; ++row)
+			browser->selectRow (row);
+	});
+	std::vector<int32_t> selection;
+	auto referenceTime = measure ([&] () {
+		for (int32_t row = 0; row < numSelected; ++row)
+		{
+			if (std::find (selection.begin (), selection.end (), row) == selection.end ())
+				selection.emplace_back (row);
+		}
+	});
+	printf ("select %d rows: reference: %.2f ms, row set: %.2f ms\n", numSelected, referenceTime,
+	        time);
+	if (browser->getSelection () == selection)
+		return true;
+	printf ("select %d rows: selections differ\n", numSelected);
+	return false;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	bool success = true;
+	success &= drawVisibleRows ();
+	success &= selectRange ();
+	VSTGUI::exit ();
+	return success ? 0 : -1;
+}
@@ -9,6 +9,8 @@
 #include "vstgui/lib/cframe.h"
 #include "vstgui/lib/cgraphicstransform.h"
 #include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/controls/cknob.h"
+#include "vstgui/lib/cvstguitimer.h"
 #include "vstgui/lib/platform/iplatformbitmap.h"
 #include "vstgui/lib/platform/platformfactory.h"
 #include "vstgui/standalone/include/helpers/menubuilder.h"
@@ -21,6 +23,8 @@
 #include "vstgui/uidescription/delegationcontroller.h"
 #include "vstgui/uidescription/iuidescription.h"
 #include "vstgui/uidescription/uiattributes.h"
+#include <chrono>
+#include <cmath>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -320,6 +324,115 @@ public:
 	CColor color {kRedCColor};
 };
 
+//------------------------------------------------------------------------
+/** Redraws 500 corona knobs at 60 Hz and shows the average time needed to draw them.
+ *	A click toggles between changing the knob values every frame and redrawing unchanged knobs.
+ */
+class KnobRedrawTestView : public CViewContainer
+{
+public:
+	static constexpr int32_t kNumColumns = 25;
+	static constexpr int32_t kNumRows = 20;
+	static constexpr CCoord kKnobSize = 20.;
+
+	KnobRedrawTestView (const CRect& size) : CViewContainer (size)
+	{
+		setBackgroundColor (kWhiteCColor);
+		for (auto row = 0; row < kNumRows; ++row)
+		{
+			for (auto column = 0; column < kNumColumns; ++column)
+			{
+				CRect r (0, 0, kKnobSize, kKnobSize);
+				r.offset (column * kKnobSize, row * kKnobSize);
+				auto knob = new CKnob (r, nullptr, -1, nullptr, nullptr, CPoint (0, 0),
+				                       CKnob::kCoronaDrawing | CKnob::kCoronaOutline |
+				                           CKnob::kHandleCircleDrawing);
+				knob->setCoronaColor (kBlueCColor);
+				knob->setHandleLineWidth (2.);
+				knob->setCoronaInset (2.);
+				knobs.push_back (knob);
+				addView (knob);
+			}
+		}
+	}
+
+	bool attached (CView* parent) override
+	{
+		if (!CViewContainer::attached (parent))
+			return false;
+		timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { onFrame (); }, 16);
+		return true;
+	}
+
+	bool removed (CView* parent) override
+	{
+		timer = nullptr;
+		return CViewContainer::removed (parent);
+	}
+
+	CMouseEventResult onMouseDown (CPoint& where, const CButtonState& buttons) override
+	{
+		animateValues = !animateValues;
+		resetStatistics ();
+		return kMouseDownEventHandledButDontNeedMovedOrUpEvents;
+	}
+
+	void drawRect (CDrawContext* context, const CRect& updateRect) override
+	{
+		auto start = std::chrono::steady_clock::now ();
+		CViewContainer::drawRect (context, updateRect);
+		auto duration = std::chrono::steady_clock::now () - start;
+		totalDrawTime += std::chrono::duration_cast<std::chrono::microseconds> (duration);
+		++numDraws;
+
+		CRect textRect (getViewSize ().left, getViewSize ().bottom - 20, getViewSize ().right,
+		                getViewSize ().bottom);
+		context->setFillColor (MakeCColor (255, 255, 255, 200));
+		context->drawRect (textRect, kDrawFilled);
+		context->setFont (kNormalFont);
+		context->setFontColor (kBlackCColor);
+		context->drawString (statusText.data (), textRect, kLeftText);
+	}
+
+private:
+	void onFrame ()
+	{
+		if (animateValues)
+		{
+			phase += 0.05;
+			for (auto i = 0u; i < knobs.size (); ++i)
+				knobs[i]->setValueNormalized (
+				    static_cast<float> (0.5 + 0.5 * std::sin (phase + i * 0.1)));
+		}
+		invalid ();
+		if (numDraws >= 60)
+		{
+			auto average = totalDrawTime.count () / numDraws;
+			statusText = (animateValues ? "changing values" : "unchanged values");
+			statusText += ", " + std::to_string (knobs.size ()) + " knobs: ";
+			statusText += std::to_string (average) + " us per frame";
+#if DEBUG
+			DebugPrint ("KnobRedraw: %s\n", statusText.data ());
+#endif
+			resetStatistics ();
+		}
+	}
+
+	void resetStatistics ()
+	{
+		totalDrawTime = {};
+		numDraws = 0;
+	}
+
+	std::vector<CKnob*> knobs;
+	SharedPointer<CVSTGUITimer> timer;
+	std::chrono::microseconds totalDrawTime {};
+	int64_t numDraws {0};
+	double phase {0.};
+	bool animateValues {true};
+	std::string statusText {"measuring..."};
+};
+
 //------------------------------------------------------------------------
 class ViewCreator : public DelegationController
 {
@@ -343,6 +456,10 @@ public:
 			{
 				return new InvalidateRegionTestView (CRect (0, 0, 500, 500));
 			}
+			else if (*customViewName == "KnobsView")
+			{
+				return new KnobRedrawTestView (CRect (0, 0, 500, 420));
+			}
 		}
 		return DelegationController::createView (attributes, description);
 	}
@@ -372,7 +489,7 @@ void makeDrawDeviceTestsWindow ()
 
 	auto modelBinding = UIDesc::ModelBindingCallbacks::make ();
 	modelBinding->addValue (Value::makeStringListValue (
-	    "ViewSelector", {"Lines/Rects", "BitmapFilter", "InvalidRects"}));
+	    "ViewSelector", {"Lines/Rects", "BitmapFilter", "InvalidRects", "Knobs"}));
 
 	auto drawDeviceTestsCustomization = std::make_shared<DrawDeviceTestsCustomization> ();
 	drawDeviceTestsCustomization->addCreateViewControllerFunc (
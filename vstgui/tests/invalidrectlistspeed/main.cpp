@@ -0,0 +1,188 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cinvalidrectlist.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace VSTGUI;
+
+using Frame = std::vector<CRect>;
+using Trace = std::vector<Frame>;
+
+//------------------------------------------------------------------------
+/** the previous linear implementation of CInvalidRectList::add as reference */
+static bool referenceAdd (std::vector<CRect>& list, const CRect& r)
+{
+	for (auto it = list.begin (), end = list.end (); it != end; ++it)
+	{
+		if (*it == r)
+			return false;
+		if (it->rectInside (r))
+			return false;
+		if (r.rectInside (*it))
+		{
+			list.erase (it);
+			return referenceAdd (list, r);
+		}
+		auto area1 = r.getWidth () * r.getHeight ();
+		auto area2 = it->getWidth () * it->getHeight ();
+		CRect jr (*it);
+		jr.unite (r);
+		auto joinedArea = jr.getWidth () * jr.getHeight ();
+		if (joinedArea <= (area1 + area2))
+		{
+			list.erase (it);
+			return referenceAdd (list, jr);
+		}
+	}
+	list.emplace_back (r);
+	return true;
+}
+
+//------------------------------------------------------------------------
+/** a synthetic trace modelled after a mixer like editor: a grid of meters and animated controls
+ *	plus a few waveform strips, all invalidating every frame with varying sizes */
+static Trace makeMixerTrace (uint32_t numFrames, uint32_t numControls)
+{
+	Trace trace;
+	uint32_t seed = 0x1234567;
+	auto random = [&] () {
+		seed = seed * 1664525u + 1013904223u;
+		return (seed >> 8) & 0xffff;
+	};
+	const uint32_t columns = 25;
+	const CCoord cellWidth = 48.;
+	const CCoord cellHeight = 96.;
+	for (auto f = 0u; f < numFrames; ++f)
+	{
+		Frame frame;
+		for (auto i = 0u; i < numControls; ++i)
+		{
+			CRect cell (0, 0, cellWidth, cellHeight);
+			cell.offset ((i % columns) * (cellWidth + 4.), (i / columns) * (cellHeight + 4.));
+			if (i % 3 == 0)
+			{
+				// meter: only the changed part of the bar is invalidated
+				auto level = (random () % 90) + 2.;
+				CRect meter (cell);
+				meter.left += cellWidth - 8.;
+				meter.top = meter.bottom - level;
+				frame.emplace_back (meter);
+			}
+			else
+			{
+				// knob or label
+				CRect r (cell);
+				r.inset (4., 4. + (random () % 16));
+				frame.emplace_back (r);
+			}
+		}
+		for (auto w = 0u; w < 4; ++w)
+		{
+			// waveform strips invalidate a small moving window
+			auto x = static_cast<CCoord> ((f * 7 + w * 131) % 1200);
+			frame.emplace_back (CRect (x, 900. + w * 40., x + 24., 936. + w * 40.));
+		}
+		trace.emplace_back (std::move (frame));
+	}
+	return trace;
+}
+
+//------------------------------------------------------------------------
+/** reads a trace recorded as text, one frame per line with the rects as "left top right bottom"
+ *	separated by semicolons */
+static bool readTrace (const char* path, Trace& trace)
+{
+	auto file = fopen (path, "r");
+	if (!file)
+		return false;
+	Frame frame;
+	double l, t, r, b;
+	int c;
+	while ((c = fgetc (file)) != EOF)
+	{
+		if (c == '\n')
+		{
+			trace.emplace_back (std::move (frame));
+			frame.clear ();
+			continue;
+		}
+		ungetc (c, file);
+		if (fscanf (file, " %lf %lf %lf %lf ;", &l, &t, &r, &b) != 4)
+			break;
+		frame.emplace_back (CRect (l, t, r, b));
+	}
+	if (!frame.empty ())
+		trace.emplace_back (std::move (frame));
+	fclose (file);
+	return !trace.empty ();
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+static void measure (const char* name, Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	auto numRects = proc ();
+	auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () - start);
+	printf ("%s: %.2f ms (%zu rects)\n", name, duration.count () * 1000., numRects);
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	Trace trace;
+	if (argc > 1)
+	{
+		if (!readTrace (argv[1], trace))
+		{
+			printf ("could not read trace %s\n", argv[1]);
+			return -1;
+		}
+	}
+	else
+		trace = makeMixerTrace (60, 250);
+
+	measure ("reference", [&] () {
+		std::vector<CRect> reference;
+		size_t count = 0;
+		for (const auto& frame : trace)
+		{
+			reference.clear ();
+			for (const auto& r : frame)
+				referenceAdd (reference, r);
+			count += reference.size ();
+		}
+		return count;
+	});
+	measure ("CInvalidRectList", [&] () {
+		CInvalidRectList list;
+		size_t count = 0;
+		for (const auto& frame : trace)
+		{
+			list.clear ();
+			for (const auto& r : frame)
+				list.add (r);
+			count += list.size ();
+		}
+		return count;
+	});
+	measure ("CInvalidRectList with joinNearbyInvalidRects", [&] () {
+		CInvalidRectList list;
+		size_t count = 0;
+		for (const auto& frame : trace)
+		{
+			list.clear ();
+			for (const auto& r : frame)
+				list.add (r);
+			joinNearbyInvalidRects (list, 24.);
+			count += list.size ();
+		}
+		return count;
+	});
+	return 0;
+}
@@ -0,0 +1,163 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/pixelbuffer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace VSTGUI;
+
+static constexpr uint32_t kWidth = 1920;
+static constexpr uint32_t kHeight = 1080;
+static constexpr PixelBuffer::ComponentPositions kPositions (2, 1, 0, 3);
+
+//------------------------------------------------------------------------
+static std::vector<uint32_t> makeBitmap ()
+{
+	std::vector<uint32_t> pixels (kWidth * kHeight);
+	uint32_t seed = 0x1357bdf;
+	for (auto& p : pixels)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		// a skin bitmap has large areas with the same color
+		p = (seed >> 28) == 0 ? seed : 0xff102030;
+	}
+	return pixels;
+}
+
+//------------------------------------------------------------------------
+/** the previous implementation of the simple filters as reference: a virtual pixel accessor
+ *	and a process function called for every pixel */
+struct ReferenceAccessor
+{
+	virtual ~ReferenceAccessor () = default;
+	virtual void getColor (CColor& c) const
+	{
+		c.red = currentPos[kPositions.red];
+		c.green = currentPos[kPositions.green];
+		c.blue = currentPos[kPositions.blue];
+		c.alpha = currentPos[kPositions.alpha];
+	}
+	virtual void setColor (const CColor& c)
+	{
+		currentPos[kPositions.red] = c.red;
+		currentPos[kPositions.green] = c.green;
+		currentPos[kPositions.blue] = c.blue;
+		currentPos[kPositions.alpha] = c.alpha;
+	}
+	uint8_t* currentPos {nullptr};
+};
+
+using ReferenceProcessFunction = void (*) (CColor& color);
+
+//------------------------------------------------------------------------
+static void referenceRun (std::vector<uint32_t>& pixels, ReferenceProcessFunction proc)
+{
+	ReferenceAccessor accessor;
+	CColor color;
+	for (auto& p : pixels)
+	{
+		accessor.currentPos = reinterpret_cast<uint8_t*> (&p);
+		accessor.getColor (color);
+		proc (color);
+		accessor.setColor (color);
+	}
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+static double measure (Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	proc ();
+	auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () - start);
+	return duration.count () * 1000.;
+}
+
+//------------------------------------------------------------------------
+/** runs the reference and the row kernel on the same bitmap, returns false if the results
+ *	differ */
+template<typename ReferenceProc, typename KernelProc>
+static bool compare (const char* name, ReferenceProc referenceProc, KernelProc kernelProc)
+{
+	auto reference = makeBitmap ();
+	auto pixels = reference;
+	auto referenceTime = measure ([&] () { referenceProc (reference); });
+	auto kernelTime = measure ([&] () { kernelProc (pixels); });
+	printf ("%s %ux%u: reference: %.2f ms, row kernel: %.2f ms\n", name, kWidth, kHeight,
+	        referenceTime, kernelTime);
+	if (pixels == reference)
+		return true;
+	printf ("%s: results differ\n", name);
+	return false;
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+static void forEachRow (std::vector<uint32_t>& pixels, Proc proc)
+{
+	for (auto y = 0u; y < kHeight; ++y)
+		proc (reinterpret_cast<uint8_t*> (pixels.data () + y * kWidth));
+}
+
+//------------------------------------------------------------------------
+int main ()
+{
+	bool success = true;
+	success &= compare (
+		"SetColor",
+		[] (std::vector<uint32_t>& pixels) {
+			referenceRun (pixels, [] (CColor& color) {
+				CColor c (200, 100, 50);
+				c.alpha = color.alpha;
+				color = c;
+			});
+		},
+		[] (std::vector<uint32_t>& pixels) {
+			forEachRow (pixels, [] (uint8_t* row) {
+				PixelBuffer::setColor (kPositions, row, row, kWidth, CColor (200, 100, 50), true);
+			});
+		});
+	success &= compare (
+		"Grayscale",
+		[] (std::vector<uint32_t>& pixels) {
+			referenceRun (pixels, [] (CColor& color) {
+				color.red = color.green = color.blue = color.getLuma ();
+			});
+		},
+		[] (std::vector<uint32_t>& pixels) {
+			forEachRow (pixels, [] (uint8_t* row) {
+				PixelBuffer::grayscale (kPositions, row, row, kWidth);
+			});
+		});
+	success &= compare (
+		"ReplaceColor",
+		[] (std::vector<uint32_t>& pixels) {
+			referenceRun (pixels, [] (CColor& color) {
+				if (color == CColor (0x10, 0x20, 0x30, 0xff))
+					color = CColor (0xff, 0x80, 0x00, 0xff);
+			});
+		},
+		[] (std::vector<uint32_t>& pixels) {
+			forEachRow (pixels, [] (uint8_t* row) {
+				PixelBuffer::replaceColor (kPositions, row, row, kWidth,
+				                           CColor (0x10, 0x20, 0x30, 0xff),
+				                           CColor (0xff, 0x80, 0x00, 0xff));
+			});
+		});
+	success &= compare (
+		"ARGB to RGBA",
+		[] (std::vector<uint32_t>& pixels) {
+			for (auto& p : pixels)
+				p = (p << 8) | (p >> 24);
+		},
+		[] (std::vector<uint32_t>& pixels) {
+			PixelBuffer::convert (PixelBuffer::Format::ARGB, PixelBuffer::Format::RGBA,
+			                      reinterpret_cast<uint8_t*> (pixels.data ()), kWidth * 4, kWidth,
+			                      kHeight);
+		});
+	return success ? 0 : -1;
+}
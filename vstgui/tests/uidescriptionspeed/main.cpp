@@ -0,0 +1,164 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+#include "vstgui/uidescription/uidescription.h"
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#endif
+
+#if WINDOWS
+#include <windows.h>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+struct SaveUIDescription : public UIDescription
+{
+	SaveUIDescription (IContentProvider* contentProvider) : UIDescription (contentProvider) {}
+
+	using UIDescription::saveToStream;
+};
+
+//------------------------------------------------------------------------
+/** a description of a multi page editor: control tags, colors and templates with rows of knobs
+ *	and labels */
+std::string makeEditorUIDesc (uint32_t numTemplates, uint32_t numViews)
+{
+	std::string str = R"({"vstgui-ui-description": {"version": "1", "control-tags": {)";
+	for (auto i = 0u; i < numTemplates * numViews / 2; ++i)
+	{
+		if (i)
+			str += ", ";
+		str += "\"Param" + std::to_string (i) + "\": \"" + std::to_string (i) + "\"";
+	}
+	str += R"(}, "colors": {)";
+	for (auto i = 0u; i < 32; ++i)
+	{
+		if (i)
+			str += ", ";
+		str += "\"Color" + std::to_string (i) + "\": \"#" + std::to_string (100000 + i) + "ff\"";
+	}
+	str += R"(}, "templates": {)";
+	for (auto t = 0u; t < numTemplates; ++t)
+	{
+		if (t)
+			str += ", ";
+		str += "\"Page" + std::to_string (t) +
+		       R"(": {"attributes": {"class": "CViewContainer", "origin": "0, 0", "size": "800, 600", "background-color": "Color0"}, "children": {)";
+		for (auto v = 0u; v < numViews; ++v)
+		{
+			auto tag = "Param" + std::to_string ((t * numViews + v) / 2);
+			auto origin = std::to_string ((v % 10) * 80) + ", " + std::to_string ((v / 10) * 60);
+			if (v)
+				str += ", ";
+			if (v % 2)
+				str += R"("CTextLabel": {"attributes": {"class": "CTextLabel", "origin": ")" + origin +
+				       R"(", "size": "70, 20", "font-color": "Color1", "title": "Label", "transparent": "true"}})";
+			else
+				str += R"("CKnob": {"attributes": {"class": "CKnob", "control-tag": ")" + tag +
+				       R"(", "origin": ")" + origin +
+				       R"(", "size": "40, 40", "corona-color": "Color2", "handle-color": "Color3", "min-value": "0", "max-value": "1", "default-value": "0.5"}})";
+		}
+		str += "}}";
+	}
+	str += "}}}";
+	return str;
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+double measure (Proc proc)
+{
+	auto start = std::chrono::steady_clock::now ();
+	proc ();
+	auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () - start);
+	return duration.count () * 1000.;
+}
+
+//------------------------------------------------------------------------
+std::string saveToString (SaveUIDescription& desc, int32_t flags)
+{
+	CMemoryStream stream (1024, 1024, false);
+	if (!desc.saveToStream (stream, flags))
+		return {};
+	stream.end ();
+	return reinterpret_cast<const char*> (stream.getBuffer ());
+}
+
+//------------------------------------------------------------------------
+/** parses desc saved with flags and compares the result with desc, returns false if saving or
+ *	parsing failed or the parsed description differs */
+bool measureFormat (const char* name, SaveUIDescription& desc, int32_t flags,
+                    bool lazyTemplates = false)
+{
+	constexpr uint32_t kIterations = 10;
+
+	CMemoryStream stream (1024, 1024, false);
+	if (!desc.saveToStream (stream, flags))
+	{
+		printf ("%s: not available\n", name);
+		return true;
+	}
+	auto size = static_cast<uint32_t> (stream.tell ());
+	bool success = true;
+	auto time = measure ([&] () {
+		for (auto i = 0u; i < kIterations; ++i)
+		{
+			MemoryContentProvider provider (stream.getBuffer (), size);
+			UIDescription parsedDesc (&provider);
+			parsedDesc.setLazyTemplates (lazyTemplates);
+			success &= parsedDesc.parse ();
+		}
+	});
+	printf ("%s: %.2f ms (%u bytes)\n", name, time / kIterations, size);
+
+	MemoryContentProvider provider (stream.getBuffer (), size);
+	SaveUIDescription parsedDesc (&provider);
+	parsedDesc.setLazyTemplates (lazyTemplates);
+	if (success && parsedDesc.parse () && saveToString (parsedDesc, 0) == saveToString (desc, 0))
+		return true;
+	printf ("%s: parsing failed or the result differs\n", name);
+	return false;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	bool success = false;
+	{
+		auto json = makeEditorUIDesc (20, 100);
+		MemoryContentProvider provider (json.data (), static_cast<uint32_t> (json.size ()));
+		SaveUIDescription desc (&provider);
+		if (desc.parse ())
+		{
+			success = true;
+			success &= measureFormat ("JSON", desc, 0);
+			success &= measureFormat ("XML", desc, UIDescription::kWriteAsXML);
+			success &= measureFormat ("binary", desc, UIDescription::kWriteAsBinary);
+			success &= measureFormat ("binary with lazy templates", desc,
+			                          UIDescription::kWriteAsBinary, true);
+		}
+	}
+	VSTGUI::exit ();
+	return success ? 0 : -1;
+}
@@ -0,0 +1,155 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/blurengine.h"
+#include "../unittests.h"
+#include <cmath>
+#include <vector>
+
+namespace VSTGUI {
+using namespace BitmapFilter;
+
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<uint8_t> makeImage (uint32_t bytesPerRow, uint32_t height)
+{
+	std::vector<uint8_t> image (bytesPerRow * height);
+	uint32_t seed = 0x13579b;
+	for (auto& b : image)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		b = static_cast<uint8_t> (seed >> 24);
+	}
+	return image;
+}
+
+//------------------------------------------------------------------------
+BlurEngine::Options makeOptions (BlurEngine::Mode mode, double radius, uint32_t planeMask)
+{
+	BlurEngine::Options options;
+	options.mode = mode;
+	options.radius = radius;
+	options.planeMask = planeMask;
+	return options;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE (BlurEngineTest,
+
+	TEST (uniformImageIsUnchanged,
+		BlurEngine engine;
+		std::vector<uint8_t> image (300 * 4 * 200, 0x7f);
+		auto expected = image;
+		auto options = makeOptions (BlurEngine::Mode::Box, 5, 0x0F);
+		options.boxPasses = 3;
+		engine.run (image.data (), 300 * 4, 300, 200, options);
+		EXPECT (image == expected);
+		engine.run (image.data (), 300 * 4, 300, 200,
+					makeOptions (BlurEngine::Mode::Gaussian, 4.5, 0x0F));
+		EXPECT (image == expected);
+	);
+
+	TEST (boxBlurAveragesNeighbours,
+		BlurEngine engine;
+		std::vector<uint8_t> image (9 * 4, 0);
+		image[4 * 4 + 1] = 90;
+		engine.run (image.data (), 9 * 4, 9, 1, makeOptions (BlurEngine::Mode::Box, 1, 0x02));
+		for (auto x = 0u; x < 9; ++x)
+		{
+			auto expected = (x >= 3 && x <= 5) ? 30 : 0;
+			EXPECT (image[x * 4 + 1] == expected);
+		}
+	);
+
+	TEST (onlySelectedPlanesChange,
+		BlurEngine engine;
+		auto image = makeImage (64 * 4, 64);
+		auto original = image;
+		engine.run (image.data (), 64 * 4, 64, 64,
+					makeOptions (BlurEngine::Mode::Gaussian, 3, 0x08));
+		bool alphaChanged = false;
+		for (auto i = 0u; i < image.size (); ++i)
+		{
+			if (i % 4 == 3)
+				alphaChanged |= image[i] != original[i];
+			else
+				EXPECT (image[i] == original[i]);
+		}
+		EXPECT (alphaChanged);
+	);
+
+	TEST (rowPaddingIsUntouched,
+		BlurEngine engine;
+		const uint32_t bytesPerRow = 40 * 4;
+		auto image = makeImage (bytesPerRow, 30);
+		auto original = image;
+		engine.run (image.data (), bytesPerRow, 37, 30, makeOptions (BlurEngine::Mode::Box, 2, 0x0F));
+		for (auto y = 0u; y < 30; ++y)
+		{
+			for (auto x = 37u * 4; x < bytesPerRow; ++x)
+				EXPECT (image[y * bytesPerRow + x] == original[y * bytesPerRow + x]);
+		}
+	);
+
+	TEST (gaussianIsSymmetric,
+		BlurEngine engine;
+		std::vector<uint8_t> image (31 * 31 * 4, 0);
+		image[(15 * 31 + 15) * 4] = 255;
+		engine.run (image.data (), 31 * 4, 31, 31,
+					makeOptions (BlurEngine::Mode::Gaussian, 2.5, 0x01));
+		auto value = [&] (uint32_t x, uint32_t y) { return image[(y * 31 + x) * 4]; };
+		EXPECT (value (15, 15) > value (16, 15));
+		EXPECT (value (16, 15) > value (17, 15));
+		for (auto y = 0u; y < 31; ++y)
+		{
+			for (auto x = 0u; x < 31; ++x)
+			{
+				EXPECT (value (x, y) == value (x, 30 - y));
+				EXPECT (value (x, y) == value (30 - x, y));
+			}
+		}
+	);
+
+	TEST (largeGaussianIsApproximatedClosely,
+		BlurEngine engine;
+		// a step from 0 to 255, the exact result is 255 * Phi (x / sigma)
+		const uint32_t width = 401;
+		const double sigma = 20.;
+		std::vector<uint8_t> image (width * 4, 0);
+		for (auto x = width / 2 + 1; x < width; ++x)
+			image[x * 4] = 255;
+		engine.run (image.data (), width * 4, width, 1,
+					makeOptions (BlurEngine::Mode::Gaussian, sigma, 0x01));
+		for (auto x = 0u; x < width; ++x)
+		{
+			auto distance = static_cast<double> (x) - width / 2 - 0.5;
+			auto exact = 255. * 0.5 * (1. + std::erf (distance / (sigma * std::sqrt (2.))));
+			EXPECT (std::abs (image[x * 4] - exact) <= 4.);
+		}
+	);
+
+	TEST (threadsProduceSameResult,
+		BlurEngine engine;
+		const uint32_t width = 301;
+		const uint32_t height = 257;
+		auto image = makeImage (width * 4, height);
+		auto singleThreaded = image;
+		auto options = makeOptions (BlurEngine::Mode::Box, 3, 0x0F);
+		options.boxPasses = 3;
+		engine.run (image.data (), width * 4, width, height, options);
+		options.maxThreads = 1;
+		engine.run (singleThreaded.data (), width * 4, width, height, options);
+		EXPECT (image == singleThreaded);
+		options.mode = BlurEngine::Mode::Gaussian;
+		engine.run (singleThreaded.data (), width * 4, width, height, options);
+		options.maxThreads = 0;
+		engine.run (image.data (), width * 4, width, height, options);
+		EXPECT (image == singleThreaded);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,171 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdatabrowser.h"
+#include "../../../lib/cdrawcontext.h"
+#include "../../../lib/idatabrowserdelegate.h"
+#include "../unittests.h"
+#include <set>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class Delegate : public DataBrowserDelegateAdapter
+{
+public:
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return numRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 2; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 20.; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override { return 100.; }
+	bool dbGetLineWidthAndColor (CCoord& width, CColor& color, CDataBrowser* browser) override
+	{
+		width = 1.;
+		color = kBlackCColor;
+		return true;
+	}
+	void dbDrawHeader (CDrawContext* context, const CRect& size, int32_t column, int32_t flags,
+	                   CDataBrowser* browser) override
+	{
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+	                 int32_t flags, CDataBrowser* browser) override
+	{
+		drawnRows.insert (row);
+		if (flags & kRowSelected)
+			selectedRows.insert (row);
+	}
+	void dbSelectionChanged (CDataBrowser* browser) override { ++numSelectionChanges; }
+
+	int32_t numRows {1000};
+	std::set<int32_t> drawnRows;
+	std::set<int32_t> selectedRows;
+	uint32_t numSelectionChanges {0};
+};
+
+//------------------------------------------------------------------------
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& r) : CDrawContext (r) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2, const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override {}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode, CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint, const CPoint& endPoint, bool evenOdd, CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center, CCoord radius, const CPoint& originOffset, bool evenOdd, CGraphicsTransform* transformation) override {}
+};
+
+//------------------------------------------------------------------------
+SharedPointer<CDataBrowser> makeBrowser (Delegate& delegate, int32_t style)
+{
+	auto browser = owned (new CDataBrowser (CRect (0, 0, 300, 400), &delegate, style, 0));
+	browser->recalculateLayout (true);
+	return browser;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(CDataBrowserTest,
+
+	TEST(drawOnlyRowsInUpdateRect,
+		Delegate delegate;
+		auto browser = makeBrowser (delegate, CDataBrowser::kDrawRowLines | CDataBrowser::kMultiSelectionStyle);
+		browser->selectRow (10);
+		browser->selectRow (500);
+		auto drawContext = owned (new NullDrawContext (CRect (0, 0, 300, 400)));
+		// the rows are 21 pixels high including the row line
+		browser->drawRect (drawContext, CRect (0, 210, 300, 252));
+		EXPECT (delegate.drawnRows == std::set<int32_t> ({10, 11}));
+		EXPECT (delegate.selectedRows == std::set<int32_t> ({10}));
+	);
+
+	TEST(drawVisibleRows,
+		Delegate delegate;
+		auto browser = makeBrowser (delegate, CDataBrowser::kDrawRowLines);
+		auto drawContext = owned (new NullDrawContext (CRect (0, 0, 300, 400)));
+		browser->drawRect (drawContext, browser->getViewSize ());
+		EXPECT (delegate.drawnRows.empty () == false);
+		EXPECT (*delegate.drawnRows.begin () == 0);
+		// the rows hidden by the scrollbar are not drawn, the visible rows are drawn without gaps
+		auto lastRow = *delegate.drawnRows.rbegin ();
+		EXPECT (lastRow >= 300 / 21);
+		EXPECT (lastRow <= 400 / 21);
+		EXPECT (delegate.drawnRows.size () == static_cast<size_t> (lastRow + 1));
+		EXPECT (delegate.selectedRows.empty ());
+	);
+
+	TEST(selectRows,
+		Delegate delegate;
+		auto browser = makeBrowser (delegate, CDataBrowser::kMultiSelectionStyle);
+		browser->selectRow (7);
+		browser->selectRow (3);
+		browser->selectRow (999);
+		browser->selectRow (3);
+		EXPECT (delegate.numSelectionChanges == 3);
+		EXPECT (browser->getSelection () == CDataBrowser::Selection ({7, 3, 999}));
+		EXPECT (browser->getSelectedRow () == 7);
+		EXPECT (browser->isRowSelected (3));
+		EXPECT (browser->isRowSelected (4) == false);
+		EXPECT (browser->isRowSelected (999));
+		EXPECT (browser->isRowSelected (-1) == false);
+		EXPECT (browser->isRowSelected (5000) == false);
+		browser->unselectRow (3);
+		EXPECT (browser->isRowSelected (3) == false);
+		EXPECT (browser->getSelection () == CDataBrowser::Selection ({7, 999}));
+		browser->unselectAll ();
+		EXPECT (browser->getSelection ().empty ());
+		EXPECT (browser->isRowSelected (7) == false);
+		EXPECT (browser->isRowSelected (999) == false);
+	);
+
+	TEST(setSelectedRowReplacesSelection,
+		Delegate delegate;
+		auto browser = makeBrowser (delegate, 0);
+		browser->selectRow (5);
+		browser->selectRow (6);
+		EXPECT (browser->getSelection () == CDataBrowser::Selection ({6}));
+		EXPECT (browser->isRowSelected (5) == false);
+		browser->setSelectedRow (2000);
+		EXPECT (browser->getSelectedRow () == 999);
+		EXPECT (browser->isRowSelected (999));
+		EXPECT (browser->isRowSelected (6) == false);
+		browser->setSelectedRow (CDataBrowser::kNoSelection);
+		EXPECT (browser->getSelection ().empty ());
+		EXPECT (browser->isRowSelected (999) == false);
+	);
+
+	TEST(rowsRemovedFromSelectionWhenRowCountShrinks,
+		Delegate delegate;
+		auto browser = makeBrowser (delegate, CDataBrowser::kMultiSelectionStyle);
+		browser->selectRow (10);
+		browser->selectRow (900);
+		delegate.numSelectionChanges = 0;
+		delegate.numRows = 100;
+		browser->recalculateLayout (true);
+		EXPECT (delegate.numSelectionChanges == 1);
+		EXPECT (browser->getSelection () == CDataBrowser::Selection ({10}));
+		EXPECT (browser->isRowSelected (10));
+		delegate.numRows = 1000;
+		browser->recalculateLayout (true);
+		EXPECT (browser->isRowSelected (900) == false);
+		browser->selectRow (900);
+		EXPECT (browser->isRowSelected (900));
+		EXPECT (browser->getSelection () == CDataBrowser::Selection ({10, 900}));
+	);
+);
+
+} // VSTGUI
@@ -4,9 +4,89 @@
 
 #include "../unittests.h"
 #include "../../../lib/cinvalidrectlist.h"
+#include <cmath>
+#include <vector>
 
 namespace VSTGUI {
 
+namespace {
+
+//------------------------------------------------------------------------
+/** true if the list would join the rects when both are added */
+bool canMerge (const CRect& r1, const CRect& r2)
+{
+	if (r1.rectInside (r2) || r2.rectInside (r1))
+		return true;
+	CRect joined (r1);
+	joined.unite (r2);
+	return joined.getWidth () * joined.getHeight () <=
+	       r1.getWidth () * r1.getHeight () + r2.getWidth () * r2.getHeight ();
+}
+
+//------------------------------------------------------------------------
+/** adds pseudo random rects with integral coordinates to a list, every tenth rect is wide enough
+ *	to span many tiles. Returns true if no two rects of the result could be merged any further
+ *	and the result covers all added rects. */
+bool addKeepsInvariants (uint32_t seed, uint32_t numRects)
+{
+	static constexpr auto gridWidth = 1000u;
+	static constexpr auto gridHeight = 500u;
+	auto random = [&] () {
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<CCoord> ((seed >> 8) & 0xffff);
+	};
+	CInvalidRectList list;
+	std::vector<CRect> added;
+	for (auto i = 0u; i < numRects; ++i)
+	{
+		auto x = std::fmod (random (), 600.);
+		auto y = std::fmod (random (), 400.);
+		auto width = 4. + std::fmod (random (), i % 10 == 0 ? 300. : 60.);
+		auto height = 4. + std::fmod (random (), 60.);
+		CRect r (x, y, x + width, y + height);
+		list.add (r);
+		added.emplace_back (r);
+	}
+	const auto& result = list.data ();
+	for (auto i = 0u; i < result.size (); ++i)
+	{
+		for (auto j = i + 1; j < result.size (); ++j)
+		{
+			if (canMerge (result[i], result[j]))
+				return false;
+		}
+	}
+	std::vector<uint8_t> covered (gridWidth * gridHeight, 0);
+	auto forEachPixel = [] (const CRect& r, auto proc) {
+		for (auto y = static_cast<size_t> (r.top); y < static_cast<size_t> (r.bottom); ++y)
+		{
+			for (auto x = static_cast<size_t> (r.left); x < static_cast<size_t> (r.right); ++x)
+			{
+				if (!proc (y * gridWidth + x))
+					return false;
+			}
+		}
+		return true;
+	};
+	for (const auto& r : result)
+	{
+		if (r.right > gridWidth || r.bottom > gridHeight)
+			return false;
+		forEachPixel (r, [&] (size_t index) {
+			covered[index] = 1;
+			return true;
+		});
+	}
+	for (const auto& r : added)
+	{
+		if (!forEachPixel (r, [&] (size_t index) { return covered[index] != 0; }))
+			return false;
+	}
+	return true;
+}
+
+} // anonymous
+
 TESTCASE(CInvalidRectListTest,
 
 	TEST(rectEqual,
@@ -37,6 +117,96 @@ TESTCASE(CInvalidRectListTest,
 		EXPECT (list.data ().size () == 1u);
 	);
 
+	TEST(addTouchingOne,
+		CInvalidRectList list;
+		EXPECT (list.add ({0, 0, 64, 100}));
+		EXPECT (list.add ({64, 0, 128, 100}));
+		EXPECT (list.data ().size () == 1u);
+		EXPECT (*list.begin () == CRect (0, 0, 128, 100));
+	);
+
+	TEST(addDistantOnes,
+		CInvalidRectList list;
+		for (auto i = 0; i < 100; ++i)
+			EXPECT (list.add ({i * 20., 0, i * 20. + 10, 10}));
+		EXPECT (list.data ().size () == 100u);
+	);
+
+	TEST(addBiggerOneContainingMany,
+		CInvalidRectList list;
+		for (auto i = 0; i < 100; ++i)
+			EXPECT (list.add ({i * 20., 0, i * 20. + 10, 10}));
+		EXPECT (list.add ({0, 0, 2000, 10}));
+		EXPECT (list.data ().size () == 1u);
+		EXPECT (list.add ({500, 0, 600, 10}) == false);
+	);
+
+	TEST(addChainedJoin,
+		CInvalidRectList list;
+		EXPECT (list.add ({0, 0, 10, 10}));
+		EXPECT (list.add ({20, 0, 30, 10}));
+		EXPECT (list.data ().size () == 2u);
+		EXPECT (list.add ({10, 0, 20, 10}));
+		EXPECT (list.data ().size () == 1u);
+		EXPECT (*list.begin () == CRect (0, 0, 30, 10));
+	);
+
+	TEST(erase,
+		CInvalidRectList list;
+		EXPECT (list.add ({0, 0, 10, 10}));
+		EXPECT (list.add ({100, 0, 110, 10}));
+		EXPECT (list.add ({200, 0, 210, 10}));
+		list.erase (list.begin ());
+		EXPECT (list.data ().size () == 2u);
+		EXPECT (list.add ({0, 0, 10, 10}));
+		EXPECT (list.add ({200, 0, 210, 10}) == false);
+		EXPECT (list.data ().size () == 3u);
+	);
+
+	TEST(clear,
+		CInvalidRectList list;
+		EXPECT (list.add ({0, 0, 10, 10}));
+		list.clear ();
+		EXPECT (list.data ().empty ());
+		EXPECT (list.add ({0, 0, 10, 10}));
+		EXPECT (list.data ().size () == 1u);
+	);
+
+	TEST(joinNearbyVertical,
+		CInvalidRectList list;
+		EXPECT (list.add ({0, 0, 10, 10}));
+		EXPECT (list.add ({0, 20, 10, 30}));
+		EXPECT (list.add ({0, 60, 10, 70}));
+		joinNearbyInvalidRects (list, 10.);
+		EXPECT (list.data ().size () == 2u);
+		EXPECT (list.data ()[0] == CRect (0, 0, 10, 30));
+		EXPECT (list.data ()[1] == CRect (0, 60, 10, 70));
+	);
+
+	TEST(joinNearbyHorizontal,
+		CInvalidRectList list;
+		EXPECT (list.add ({0, 0, 10, 10}));
+		EXPECT (list.add ({20, 0, 30, 10}));
+		EXPECT (list.add ({40, 0, 50, 10}));
+		joinNearbyInvalidRects (list, 10.);
+		EXPECT (list.data ().size () == 1u);
+		EXPECT (list.data ()[0] == CRect (0, 0, 50, 10));
+		EXPECT (list.add ({20, 0, 30, 10}) == false);
+	);
+
+	TEST(joinNearbyNeedsSameExtent,
+		CInvalidRectList list;
+		EXPECT (list.add ({0, 0, 10, 10}));
+		EXPECT (list.add ({0, 15, 12, 25}));
+		joinNearbyInvalidRects (list, 10.);
+		EXPECT (list.data ().size () == 2u);
+	);
+
+	TEST(mergeKeepsInvariants,
+		for (auto seed = 1u; seed < 100; ++seed)
+			EXPECT (addKeepsInvariants (seed, 60));
+	);
+
 );
 
 } // VSTGUI
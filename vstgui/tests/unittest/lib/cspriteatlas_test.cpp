@@ -0,0 +1,161 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/ccolor.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/cspriteatlas.h"
+#include "../../../lib/platform/iplatformbitmap.h"
+#include "../../../lib/platform/platformfactory.h"
+#include "../unittests.h"
+#include <cstring>
+#include <iterator>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+const CColor frameColors[] = {kRedCColor, kGreenCColor, kBlueCColor, kWhiteCColor};
+
+//------------------------------------------------------------------------
+void fillFilmStrip (CBitmap& bitmap, uint32_t frameHeight)
+{
+	if (auto accessor = owned (CBitmapPixelAccess::create (&bitmap)))
+	{
+		do
+		{
+			accessor->setColor (frameColors[accessor->getY () / frameHeight]);
+		} while (++(*accessor));
+	}
+}
+
+//------------------------------------------------------------------------
+/** change the pixels without a CBitmapPixelAccess, like drawing into the bitmap does */
+void fillPlatformBitmap (CBitmap& bitmap, uint8_t value)
+{
+	auto platformBitmap = bitmap.getPlatformBitmap ();
+	if (auto access = platformBitmap->lockPixels (true))
+	{
+		auto height = static_cast<uint32_t> (platformBitmap->getSize ().y);
+		std::memset (access->getAddress (), value, access->getBytesPerRow () * height);
+	}
+}
+
+//------------------------------------------------------------------------
+bool frameHasColor (CBitmap* frame, const CColor& color)
+{
+	auto accessor = owned (CBitmapPixelAccess::create (frame));
+	if (!accessor)
+		return false;
+	do
+	{
+		CColor c;
+		accessor->getColor (c);
+		if (c != color)
+			return false;
+	} while (++(*accessor));
+	return true;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE (CSpriteAtlasTest,
+
+	TEST (slicesFrames,
+		CBitmap bitmap (10, 40);
+		fillFilmStrip (bitmap, 10);
+		auto atlas = bitmap.getSpriteAtlas (10);
+		EXPECT (atlas);
+		EXPECT (atlas->getNumFrames () == 4);
+		for (auto i = 0u; i < 4; ++i)
+		{
+			auto frame = atlas->getFrame (i);
+			EXPECT (frame);
+			EXPECT (frame->getWidth () == 10);
+			EXPECT (frame->getHeight () == 10);
+			EXPECT (frameHasColor (frame, frameColors[i]));
+		}
+		EXPECT (atlas->getFrame (4) == nullptr);
+	);
+
+	TEST (atlasIsReusedForSameFrameHeight,
+		CBitmap bitmap (10, 40);
+		auto atlas = bitmap.getSpriteAtlas (10);
+		EXPECT (bitmap.getSpriteAtlas (10) == atlas);
+		EXPECT (bitmap.getSpriteAtlas (20)->getNumFrames () == 2);
+	);
+
+	TEST (pixelChangesAreReflected,
+		CBitmap bitmap (10, 40);
+		fillFilmStrip (bitmap, 10);
+		EXPECT (frameHasColor (bitmap.getSpriteAtlas (10)->getFrame (0), kRedCColor));
+		fillFilmStrip (bitmap, 20);
+		EXPECT (frameHasColor (bitmap.getSpriteAtlas (10)->getFrame (1), kRedCColor));
+		EXPECT (frameHasColor (bitmap.getSpriteAtlas (10)->getFrame (2), kGreenCColor));
+	);
+
+	TEST (offscreenDrawingIsReflected,
+		auto offscreen = COffscreenContext::create ({10, 40});
+		EXPECT (offscreen);
+		auto bitmap = offscreen->getBitmap ();
+		auto atlas = bitmap->getSpriteAtlas (10);
+		offscreen->beginDraw ();
+		fillPlatformBitmap (*bitmap, 0x00);
+		offscreen->endDraw ();
+		EXPECT (frameHasColor (atlas->getFrame (0), CColor (0, 0, 0, 0)));
+		auto revision = bitmap->getContentRevision ();
+		offscreen->beginDraw ();
+		fillPlatformBitmap (*bitmap, 0xff);
+		offscreen->endDraw ();
+		EXPECT (bitmap->getContentRevision () != revision);
+		EXPECT (frameHasColor (atlas->getFrame (0), kWhiteCColor));
+	);
+
+	TEST (onlyTheUsedScaleFactorIsSliced,
+		CBitmap bitmap (10, 40);
+		auto platformBitmap = getPlatformFactory ().createBitmap (CPoint (20, 80));
+		EXPECT (platformBitmap);
+		platformBitmap->setScaleFactor (2.);
+		EXPECT (bitmap.addBitmap (platformBitmap));
+		auto usage = CSpriteAtlas::getMemoryUsage ();
+		auto frame = bitmap.getSpriteAtlas (10)->getFrame (0, 2.);
+		EXPECT (frame);
+		EXPECT (frame->getPlatformBitmap ()->getScaleFactor () == 2.);
+		EXPECT (std::distance (frame->begin (), frame->end ()) == 1);
+		EXPECT (CSpriteAtlas::getMemoryUsage () == usage + 20 * 20 * 4 * 4);
+		frame = bitmap.getSpriteAtlas (10)->getFrame (0, 1.);
+		EXPECT (frame);
+		EXPECT (frame->getPlatformBitmap ()->getScaleFactor () == 1.);
+		EXPECT (CSpriteAtlas::getMemoryUsage () == usage + 10 * 10 * 4 * 4);
+	);
+
+	TEST (memoryIsLimited,
+		// four frames of 10x10 pixels
+		constexpr size_t atlasSize = 10 * 10 * 4 * 4;
+		auto memoryLimit = CSpriteAtlas::getMemoryLimit ();
+		CSpriteAtlas::setMemoryLimit (atlasSize);
+		CBitmap bitmap1 (10, 40);
+		CBitmap bitmap2 (10, 40);
+		auto atlas1 = bitmap1.getSpriteAtlas (10);
+		auto atlas2 = bitmap2.getSpriteAtlas (10);
+		EXPECT (atlas1->getFrame (0));
+		EXPECT (CSpriteAtlas::getMemoryUsage () == atlasSize);
+		// the least recently drawn atlas releases its frames
+		EXPECT (atlas2->getFrame (0));
+		EXPECT (CSpriteAtlas::getMemoryUsage () == atlasSize);
+		EXPECT (atlas1->getFrame (0));
+		EXPECT (CSpriteAtlas::getMemoryUsage () == atlasSize);
+		// an atlas larger than the limit is not sliced
+		CSpriteAtlas::setMemoryLimit (atlasSize - 1);
+		EXPECT (CSpriteAtlas::getMemoryUsage () == 0);
+		EXPECT (atlas1->getFrame (0) == nullptr);
+		EXPECT (CSpriteAtlas::getMemoryUsage () == 0);
+		CSpriteAtlas::setMemoryLimit (memoryLimit);
+		EXPECT (atlas1->getFrame (0));
+	);
+);
+
+} // VSTGUI
@@ -3,6 +3,10 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../lib/cframe.h"
+#include "../../../lib/cdrawcontext.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/cscrollview.h"
+#include "../../../lib/csplitview.h"
 #include "../../../lib/iviewlistener.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/dragging.h"
@@ -107,6 +111,41 @@ public:
 	
  };
 
+class DrawCountView : public CView
+{
+public:
+	DrawCountView (const CRect& r) : CView (r) {}
+
+	void drawRect (CDrawContext* context, const CRect& updateRect) override
+	{
+		++drawCount;
+		CView::drawRect (context, updateRect);
+	}
+
+	uint32_t drawCount {0};
+};
+
+class NullDrawContext : public CDrawContext
+{
+public:
+	NullDrawContext (const CRect& r) : CDrawContext (r) { init (); }
+
+	void drawLine (const LinePair& line) override {}
+	void drawLines (const LineList& lines) override {}
+	void drawPolygon (const PointList& polygonPointList, const CDrawStyle drawStyle) override {}
+	void drawRect (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawArc (const CRect& rect, const float startAngle1, const float endAngle2, const CDrawStyle drawStyle) override {}
+	void drawEllipse (const CRect& rect, const CDrawStyle drawStyle) override {}
+	void drawPoint (const CPoint& point, const CColor& color) override {}
+	void drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha) override {}
+	void clearRect (const CRect& rect) override {}
+	CGraphicsPath* createGraphicsPath () override { return nullptr; }
+	CGraphicsPath* createTextPath (const CFontRef font, UTF8StringPtr text) override { return nullptr; }
+	void drawGraphicsPath (CGraphicsPath* path, PathDrawMode mode, CGraphicsTransform* transformation) override {}
+	void fillLinearGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& startPoint, const CPoint& endPoint, bool evenOdd, CGraphicsTransform* transformation) override {}
+	void fillRadialGradient (CGraphicsPath* path, const CGradient& gradient, const CPoint& center, CCoord radius, const CPoint& originOffset, bool evenOdd, CGraphicsTransform* transformation) override {}
+};
+
 } // anonymous
 
 TESTCASE(CViewContainerTest,
@@ -543,6 +582,254 @@ TESTCASE(CViewContainerTest,
 		res = container->getContainerAt (CPoint(0, 0), GetViewOptions (GetViewOptions::kDeep | GetViewOptions::kMouseEnabled));
 		EXPECT(res == c1);
 	);
+
+	TEST(opaqueViewCoversViewsBelow,
+		auto context = owned (new NullDrawContext (CRect (0, 0, 200, 200)));
+		auto view = new DrawCountView (CRect (10, 10, 50, 50));
+		auto cover = new CViewContainer (CRect (0, 0, 100, 100));
+		container->addView (view);
+		container->addView (cover);
+		EXPECT(cover->isOpaque () == false);
+		cover->setOpaque (true);
+		EXPECT(cover->isOpaque ());
+	#if DEBUG
+		CViewContainer::resetNumCulledDraws ();
+	#endif
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 0);
+	#if DEBUG
+		EXPECT(CViewContainer::getNumCulledDraws () == 1);
+	#endif
+		cover->setTransparency (true);
+		EXPECT(cover->isOpaque () == false);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 1);
+		cover->setTransparency (false);
+		cover->setAlphaValue (0.5f);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 2);
+		cover->setAlphaValue (1.f);
+		cover->setViewSize (CRect (0, 0, 30, 30));
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 3);
+		// only the part of the view inside the update rect needs to be covered
+		container->drawRect (context, CRect (0, 0, 20, 20));
+		EXPECT(view->drawCount == 3);
+	);
+
+	TEST(opaqueViewsCoverViewBelowTogether,
+		auto context = owned (new NullDrawContext (CRect (0, 0, 200, 200)));
+		auto view = new DrawCountView (CRect (10, 10, 50, 50));
+		auto cover1 = new CViewContainer (CRect (0, 0, 30, 100));
+		auto cover2 = new CViewContainer (CRect (30, 0, 60, 100));
+		auto top = new DrawCountView (CRect (0, 0, 100, 100));
+		cover1->setOpaque (true);
+		cover2->setOpaque (true);
+		container->addView (view);
+		container->addView (cover1);
+		container->addView (cover2);
+		container->addView (top);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 0);
+		EXPECT(top->drawCount == 1);
+		cover2->setViewSize (CRect (31, 0, 60, 100));
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 1);
+	);
+
+	TEST(opaqueContainerWithTransparentViewsOnTop,
+		auto context = owned (new NullDrawContext (CRect (0, 0, 200, 200)));
+		auto view = new DrawCountView (CRect (10, 10, 50, 50));
+		auto cover = new CViewContainer (CRect (0, 0, 100, 100));
+		auto child = new DrawCountView (CRect (0, 0, 100, 100));
+		auto top = new DrawCountView (CRect (0, 0, 100, 100));
+		child->setTransparency (true);
+		top->setTransparency (true);
+		cover->setOpaque (true);
+		cover->addView (child);
+		container->addView (view);
+		container->addView (cover);
+		container->addView (top);
+		EXPECT(cover->isOpaque ());
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 0);
+		EXPECT(child->drawCount == 1);
+		EXPECT(top->drawCount == 1);
+	);
+
+	TEST(renderCacheFallsBackToDirectDrawing,
+		auto context = owned (new NullDrawContext (CRect (0, 0, 200, 200)));
+		auto view = new DrawCountView (CRect (10, 10, 50, 50));
+		container->addView (view);
+		container->setRenderCacheEnabled (true);
+		EXPECT(container->isRenderCacheEnabled ());
+		auto limit = CViewContainer::getRenderCacheMemoryLimit ();
+		// a cache for this container would not fit
+		CViewContainer::setRenderCacheMemoryLimit (1000);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 1);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 2);
+		EXPECT(CViewContainer::getRenderCacheMemoryUsage () <= 1000);
+		CViewContainer::setRenderCacheMemoryLimit (limit);
+		EXPECT(CViewContainer::getRenderCacheMemoryLimit () == limit);
+	);
+
+	TEST(renderCacheIsUsedUntilInvalidated,
+		// the platform may not support offscreen drawing
+		if (!COffscreenContext::create ({1., 1.}))
+			return true;
+		auto context = owned (new NullDrawContext (CRect (0, 0, 200, 200)));
+		auto view = new DrawCountView (CRect (10, 10, 50, 50));
+		container->addView (view);
+		container->setRenderCacheEnabled (true);
+		auto usage = CViewContainer::getRenderCacheMemoryUsage ();
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 1);
+		EXPECT(CViewContainer::getRenderCacheMemoryUsage () > usage);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 1);
+
+		container->invalid ();
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 2);
+
+		auto other = new CView (CRect (60, 60, 70, 70));
+		container->addView (other);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 3);
+		container->changeViewZOrder (other, 0);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 4);
+		container->removeView (other);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 5);
+
+		container->setTransparency (true);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 6);
+
+		container->setRenderCacheEnabled (false);
+		EXPECT(CViewContainer::getRenderCacheMemoryUsage () == usage);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 7);
+	);
+
+	TEST(containerSubclassesAreNotOpaqueByDefault,
+		auto context = owned (new NullDrawContext (CRect (0, 0, 200, 200)));
+		auto view = new DrawCountView (CRect (10, 10, 50, 50));
+		auto scrollView = new CScrollView (CRect (0, 0, 100, 100), CRect (0, 0, 100, 100), 0);
+		auto splitView = new CSplitView (CRect (0, 0, 100, 100));
+		container->addView (view);
+		container->addView (scrollView);
+		container->addView (splitView);
+		EXPECT(scrollView->isOpaque () == false);
+		EXPECT(splitView->isOpaque () == false);
+		container->drawRect (context, CRect (0, 0, 200, 200));
+		EXPECT(view->drawCount == 1);
+	);
+
+	TEST(hitTestIndexMatchesLinearSearch,
+		auto parent = owned (new CViewContainer (CRect (0, 0, 200, 200)));
+		for (auto i = 0; i < 100; ++i)
+		{
+			CRect r (0, 0, 15 + (i % 7) * 10, 15 + (i % 5) * 10);
+			r.offset ((i % 10) * 17, (i / 10) * 17);
+			auto view = (i % 9 == 0) ? new CViewContainer (r) : new CView (r);
+			view->setVisible (i % 11 != 0);
+			view->setMouseEnabled (i % 13 != 0);
+			container->addView (view);
+		}
+		container->addView (new CView (CRect (-10, -10, 1000, 1000)), container->getView (50));
+		container->addView (new CView (CRect (-20, -20, 900, 900)), container->getView (20));
+		container->addView (new CView (CRect (100, -20, 900, 900)));
+		std::vector<GetViewOptions> options;
+		options.emplace_back (GetViewOptions::kNone);
+		options.emplace_back (GetViewOptions::kMouseEnabled);
+		options.emplace_back (GetViewOptions::kDeep|GetViewOptions::kIncludeViewContainer);
+		options.emplace_back (GetViewOptions::kIncludeInvisible|GetViewOptions::kIncludeViewContainer);
+		std::vector<CView*> expectedViews;
+		std::vector<size_t> expectedCounts;
+		auto query = [&] (std::vector<CView*>& foundViews, std::vector<size_t>& counts) {
+			for (auto y = -5; y < 200; y += 3)
+			{
+				for (auto x = -5; x < 200; x += 3)
+				{
+					for (const auto& o : options)
+					{
+						foundViews.emplace_back (container->getViewAt (CPoint (x, y), o));
+						CViewContainer::ViewList views;
+						container->getViewsAt (CPoint (x, y), views, o);
+						counts.emplace_back (views.size ());
+						if (!views.empty ())
+							foundViews.emplace_back (views.back ());
+					}
+				}
+			}
+		};
+		query (expectedViews, expectedCounts);
+		container->setHitTestIndexEnabled (true);
+		container->attached (parent);
+		std::vector<CView*> foundViews;
+		std::vector<size_t> counts;
+		query (foundViews, counts);
+		EXPECT(foundViews == expectedViews);
+		EXPECT(counts == expectedCounts);
+		container->removed (parent);
+	);
+
+	TEST(hitTestIndexZOrder,
+		auto parent = owned (new CViewContainer (CRect (0, 0, 200, 200)));
+		container->setHitTestIndexEnabled (true);
+		container->attached (parent);
+		auto v1 = new CView (CRect (0, 0, 50, 50));
+		auto v2 = new CView (CRect (10, 10, 60, 60));
+		auto v3 = new CView (CRect (20, 20, 70, 70));
+		container->addView (v1);
+		container->addView (v2);
+		EXPECT(container->getViewAt (CPoint (30, 30)) == v2);
+		container->addView (v3, v2);
+		EXPECT(container->getViewAt (CPoint (30, 30)) == v2);
+		EXPECT(container->getViewAt (CPoint (65, 65)) == v3);
+		container->changeViewZOrder (v1, 2);
+		EXPECT(container->getViewAt (CPoint (30, 30)) == v1);
+		CViewContainer::ViewList views;
+		container->getViewsAt (CPoint (30, 30), views);
+		EXPECT(views.size () == 3);
+		EXPECT(views.front () == v1);
+		EXPECT(views.back () == v3);
+		container->removeView (v1);
+		EXPECT(container->getViewAt (CPoint (30, 30)) == v2);
+		container->removeAll ();
+		EXPECT(container->getViewAt (CPoint (30, 30)) == nullptr);
+		container->removed (parent);
+	);
+
+	TEST(hitTestIndexFollowsGeometryChanges,
+		auto parent = owned (new CViewContainer (CRect (0, 0, 200, 200)));
+		container->setHitTestIndexEnabled (true);
+		container->attached (parent);
+		auto view = new CView (CRect (0, 0, 10, 10));
+		container->addView (view);
+		EXPECT(container->getViewAt (CPoint (5, 5)) == view);
+		view->setViewSize (CRect (150, 150, 160, 160));
+		EXPECT(container->getViewAt (CPoint (5, 5)) == nullptr);
+		EXPECT(container->getViewAt (CPoint (155, 155)) == view);
+		view->setMouseableArea (CRect (100, 0, 190, 40));
+		EXPECT(container->getViewAt (CPoint (155, 155)) == nullptr);
+		EXPECT(container->getViewAt (CPoint (180, 10)) == view);
+		container->removed (parent);
+		view->setMouseableArea (CRect (0, 0, 10, 10));
+		container->attached (parent);
+		EXPECT(container->getViewAt (CPoint (5, 5)) == view);
+		container->setHitTestIndexEnabled (false);
+		EXPECT(container->getViewAt (CPoint (5, 5)) == view);
+		container->removed (parent);
+	);
 	
 ); // TESTCASE
 
@@ -4,10 +4,39 @@
 
 #include "../../../lib/pixelbuffer.h"
 #include "../unittests.h"
+#include <vector>
 
 namespace VSTGUI {
 using namespace PixelBuffer;
 
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<uint32_t> makePixels (size_t count)
+{
+	std::vector<uint32_t> pixels (count);
+	uint32_t seed = 0x2468ace;
+	for (auto& p : pixels)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		p = seed;
+	}
+	return pixels;
+}
+
+//------------------------------------------------------------------------
+CColor getColor (const ComponentPositions& pos, const uint32_t& pixel)
+{
+	auto bytes = reinterpret_cast<const uint8_t*> (&pixel);
+	return CColor (bytes[pos.red], bytes[pos.green], bytes[pos.blue], bytes[pos.alpha]);
+}
+
+//------------------------------------------------------------------------
+constexpr ComponentPositions kBGRAPositions (2, 1, 0, 3);
+constexpr ComponentPositions kARGBPositions (1, 2, 3, 0);
+
+} // anonymous
+
 TESTCASE (PixelBufferTest,
 
 		  TEST (ARGB_2_RGBA, uint32_t pixel = 0x11223344;
@@ -58,4 +87,87 @@ TESTCASE (PixelBufferTest,
 				convert (Format::BGRA, Format::ARGB, reinterpret_cast<uint8_t*> (&pixel), 4, 1, 1);
 				EXPECT (pixel == 0x44332211)););
 
+TESTCASE (PixelBufferRowKernelTest,
+
+		  TEST (convertRowsWithPadding, const uint32_t width = 37; const uint32_t stride = 40;
+				auto pixels = makePixels (stride * 3); auto original = pixels;
+				convert (Format::ARGB, Format::RGBA, reinterpret_cast<uint8_t*> (pixels.data ()),
+						 stride * 4, width, 3);
+				for (auto i = 0u; i < pixels.size (); ++i) {
+					auto p = original[i];
+					auto expected = i % stride < width ? (p << 8) | (p >> 24) : p;
+					EXPECT (pixels[i] == expected);
+				});
+
+		  TEST (setColor, auto pixels = makePixels (21); auto src = pixels;
+				CColor color (10, 20, 30, 40);
+				setColor (kBGRAPositions, reinterpret_cast<const uint8_t*> (src.data ()),
+						  reinterpret_cast<uint8_t*> (pixels.data ()), 21, color, false);
+				for (auto p : pixels) EXPECT (getColor (kBGRAPositions, p) == color););
+
+		  TEST (setColorIgnoreAlpha, auto pixels = makePixels (21); auto src = pixels;
+				setColor (kARGBPositions, reinterpret_cast<const uint8_t*> (src.data ()),
+						  reinterpret_cast<uint8_t*> (pixels.data ()), 21, CColor (10, 20, 30, 40),
+						  true);
+				for (auto i = 0u; i < pixels.size (); ++i) {
+					auto expected = CColor (10, 20, 30, getColor (kARGBPositions, src[i]).alpha);
+					EXPECT (getColor (kARGBPositions, pixels[i]) == expected);
+				});
+
+		  TEST (grayscaleMatchesLuma, auto pixels = makePixels (1027); auto src = pixels;
+				grayscale (kBGRAPositions, reinterpret_cast<const uint8_t*> (src.data ()),
+						   reinterpret_cast<uint8_t*> (pixels.data ()), 1027);
+				for (auto i = 0u; i < pixels.size (); ++i) {
+					auto expected = getColor (kBGRAPositions, src[i]);
+					expected.red = expected.green = expected.blue = expected.getLuma ();
+					EXPECT (getColor (kBGRAPositions, pixels[i]) == expected);
+				});
+
+		  TEST (replaceColor, auto pixels = makePixels (19); CColor color (1, 2, 3, 4);
+				CColor replacement (5, 6, 7, 8);
+				auto target = reinterpret_cast<uint8_t*> (&pixels[4]);
+				target[2] = 1; target[1] = 2; target[0] = 3; target[3] = 4;
+				pixels[17] = pixels[4]; auto src = pixels;
+				replaceColor (kBGRAPositions, reinterpret_cast<uint8_t*> (pixels.data ()),
+							  reinterpret_cast<uint8_t*> (pixels.data ()), 19, color, replacement);
+				for (auto i = 0u; i < pixels.size (); ++i) {
+					auto replaced = i == 4 || i == 17;
+					EXPECT ((getColor (kBGRAPositions, pixels[i]) == replacement) == replaced);
+					EXPECT (replaced || pixels[i] == src[i]);
+				});
+
+		  TEST (kernelsHandleAllRowLengths, CColor color (0x10, 0x20, 0x30, 0xff);
+				CColor replacement (0xff, 0x80, 0x00, 0xff);
+				for (auto width = 1u; width < 68; ++width) {
+					// a skin like row with many pixels of the replaced color
+					auto src = makePixels (width);
+					for (auto i = 0u; i < width; i += 3)
+						src[i] = 0xff102030;
+					auto pixels = src;
+					replaceColor (kBGRAPositions, reinterpret_cast<const uint8_t*> (src.data ()),
+								  reinterpret_cast<uint8_t*> (pixels.data ()), width, color,
+								  replacement);
+					for (auto i = 0u; i < width; ++i) {
+						auto expected = getColor (kBGRAPositions, src[i]);
+						if (expected == color)
+							expected = replacement;
+						EXPECT (getColor (kBGRAPositions, pixels[i]) == expected);
+					}
+					grayscale (kBGRAPositions, reinterpret_cast<const uint8_t*> (src.data ()),
+							   reinterpret_cast<uint8_t*> (pixels.data ()), width);
+					for (auto i = 0u; i < width; ++i) {
+						auto expected = getColor (kBGRAPositions, src[i]);
+						expected.red = expected.green = expected.blue = expected.getLuma ();
+						EXPECT (getColor (kBGRAPositions, pixels[i]) == expected);
+					}
+					setColor (kBGRAPositions, reinterpret_cast<const uint8_t*> (src.data ()),
+							  reinterpret_cast<uint8_t*> (pixels.data ()), width,
+							  CColor (200, 100, 50), true);
+					for (auto i = 0u; i < width; ++i) {
+						auto expected =
+							CColor (200, 100, 50, getColor (kBGRAPositions, src[i]).alpha);
+						EXPECT (getColor (kBGRAPositions, pixels[i]) == expected);
+					}
+				}););
+
 } // namespace VSTGUI
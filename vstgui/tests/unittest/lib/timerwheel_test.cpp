@@ -0,0 +1,190 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/timerwheel.h"
+#include "../unittests.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct Callback : IPlatformTimerCallback
+{
+	void fire () override
+	{
+		fireTimes.emplace_back (*time);
+		if (onFire)
+			onFire ();
+	}
+
+	const TimerWheel::Milliseconds* time {nullptr};
+	std::vector<TimerWheel::Milliseconds> fireTimes;
+	std::function<void ()> onFire;
+};
+
+//------------------------------------------------------------------------
+TimerWheel::Milliseconds expectedFirstDueTime (TimerWheel::Milliseconds time, uint32_t interval)
+{
+	TimerWheel::Milliseconds grid = 1;
+	while (grid * 2 <= interval / 4 && grid * 2 <= 16)
+		grid *= 2;
+	time += interval;
+	return ((time + grid - 1) / grid) * grid;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(TimerWheelTest,
+
+	TEST(firesPeriodically,
+		TimerWheel wheel;
+		TimerWheel::Milliseconds time = 0;
+		Callback callback;
+		callback.time = &time;
+		TimerWheel::Entry entry (&callback);
+		EXPECT (wheel.schedule (entry, 10, time));
+		EXPECT (wheel.getNextDueTime () == 10);
+		time = 9;
+		EXPECT (wheel.advance (time) == 0);
+		time = 10;
+		EXPECT (wheel.advance (time) == 1);
+		time = 20;
+		EXPECT (wheel.advance (time) == 1);
+		time = 30;
+		EXPECT (wheel.advance (time) == 1);
+		EXPECT (callback.fireTimes == std::vector<TimerWheel::Milliseconds> ({10, 20, 30}));
+		wheel.cancel (entry);
+		EXPECT (entry.isScheduled () == false);
+		EXPECT (wheel.getNumEntries () == 0);
+		EXPECT (wheel.getNextDueTime () == TimerWheel::kNever);
+	);
+
+	TEST(timersStartedOutOfPhaseFireTogether,
+		TimerWheel wheel;
+		TimerWheel::Milliseconds time = 0;
+		Callback callback1;
+		Callback callback2;
+		callback1.time = callback2.time = &time;
+		TimerWheel::Entry entry1 (&callback1);
+		TimerWheel::Entry entry2 (&callback2);
+		wheel.schedule (entry1, 33, 0);
+		wheel.schedule (entry2, 33, 5);
+		EXPECT (entry1.getDueTime () == entry2.getDueTime ());
+		time = entry1.getDueTime ();
+		EXPECT (wheel.advance (time) == 2);
+		EXPECT (wheel.getStatistics ().numTicks == 1);
+		EXPECT (wheel.getStatistics ().maxFiredPerTick == 2);
+		EXPECT (wheel.getStatistics ().numFired == 2);
+		wheel.cancel (entry1);
+		wheel.cancel (entry2);
+	);
+
+	TEST(allLevelsFireInTime,
+		TimerWheel wheel;
+		TimerWheel::Milliseconds time = 0;
+		const std::vector<uint32_t> intervals ({1, 7, 33, 300, 5000, 20000});
+		std::vector<std::unique_ptr<Callback>> callbacks;
+		std::vector<std::unique_ptr<TimerWheel::Entry>> entries;
+		for (auto interval : intervals)
+		{
+			callbacks.emplace_back (new Callback);
+			callbacks.back ()->time = &time;
+			entries.emplace_back (new TimerWheel::Entry (callbacks.back ().get ()));
+			wheel.schedule (*entries.back (), interval, time);
+		}
+		for (time = 1; time <= 45000; ++time)
+			wheel.advance (time);
+		for (auto i = 0u; i < intervals.size (); ++i)
+		{
+			const auto& fireTimes = callbacks[i]->fireTimes;
+			EXPECT (fireTimes.empty () == false);
+			auto expected = expectedFirstDueTime (0, intervals[i]);
+			for (auto fireTime : fireTimes)
+			{
+				EXPECT (fireTime == expected);
+				expected += intervals[i];
+			}
+			EXPECT (expected > 45000);
+			wheel.cancel (*entries[i]);
+		}
+	);
+
+	TEST(lateWakeupFiresOnce,
+		TimerWheel wheel;
+		TimerWheel::Milliseconds time = 0;
+		Callback callback;
+		callback.time = &time;
+		TimerWheel::Entry entry (&callback);
+		wheel.schedule (entry, 10, time);
+		time = 100000;
+		EXPECT (wheel.advance (time) == 1);
+		EXPECT (entry.getDueTime () == 100010);
+		wheel.cancel (entry);
+	);
+
+	TEST(lateWakeupsDoNotLengthenThePeriod,
+		TimerWheel wheel;
+		TimerWheel::Milliseconds time = 0;
+		Callback callback;
+		callback.time = &time;
+		TimerWheel::Entry entry (&callback);
+		wheel.schedule (entry, 16, time);
+		// every wakeup arrives a little after the due time, like a platform timer
+		for (auto i = 0; i < 60; ++i)
+		{
+			time = entry.getDueTime () + 1 + i % 3;
+			EXPECT (wheel.advance (time) == 1);
+		}
+		EXPECT (callback.fireTimes.size () == 60);
+		auto first = expectedFirstDueTime (0, 16);
+		for (auto i = 0u; i < callback.fireTimes.size (); ++i)
+			EXPECT (callback.fireTimes[i] == first + i * 16 + 1 + i % 3);
+		EXPECT (entry.getDueTime () == first + 60 * 16);
+		wheel.cancel (entry);
+	);
+
+	TEST(lateWakeupSkipsMissedPeriods,
+		TimerWheel wheel;
+		TimerWheel::Milliseconds time = 0;
+		Callback callback;
+		callback.time = &time;
+		TimerWheel::Entry entry (&callback);
+		wheel.schedule (entry, 10, time);
+		time = 35;
+		EXPECT (wheel.advance (time) == 1);
+		EXPECT (entry.getDueTime () == 40);
+		time = 40;
+		EXPECT (wheel.advance (time) == 1);
+		EXPECT (entry.getDueTime () == 50);
+		wheel.cancel (entry);
+	);
+
+	TEST(callbackCanStopTimers,
+		TimerWheel wheel;
+		TimerWheel::Milliseconds time = 0;
+		Callback callback1;
+		Callback callback2;
+		callback1.time = callback2.time = &time;
+		TimerWheel::Entry entry1 (&callback1);
+		TimerWheel::Entry entry2 (&callback2);
+		callback1.onFire = [&] () {
+			wheel.cancel (entry1);
+			wheel.cancel (entry2);
+		};
+		wheel.schedule (entry1, 10, 0);
+		wheel.schedule (entry2, 10, 0);
+		time = 100;
+		EXPECT (wheel.advance (time) == 1);
+		EXPECT (callback1.fireTimes.size () == 1);
+		EXPECT (callback2.fireTimes.empty ());
+		EXPECT (wheel.getNumEntries () == 0);
+	);
+);
+
+} // VSTGUI
@@ -0,0 +1,114 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../standalone/source/platform/gdk/gdkasync.h"
+#include "../unittests.h"
+#include <glib.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+using namespace Standalone;
+using namespace Standalone::Platform::GDK;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** perform the pending main queue tasks, returns the number of dispatched sources */
+uint32_t performMainContext ()
+{
+	uint32_t result = 0;
+	while (g_main_context_iteration (g_main_context_default (), false))
+		++result;
+	return result;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(GDKAsyncTest,
+
+	TEST(mainQueueRunsOnMainContext,
+		performMainContext ();
+		auto mainThread = std::this_thread::get_id ();
+		std::vector<uint32_t> order;
+		bool otherThread = false;
+		for (auto i = 0u; i < 3; ++i)
+		{
+			Async::schedule (Async::mainQueue (), [&, i] () {
+				if (std::this_thread::get_id () != mainThread)
+					otherThread = true;
+				order.emplace_back (i);
+			});
+		}
+		EXPECT (order.empty ());
+		EXPECT (getQueueStatistics (Async::mainQueue ()).queueDepth == 3);
+		EXPECT (performMainContext () > 0);
+		EXPECT (order.size () == 3);
+		EXPECT (order[0] == 0);
+		EXPECT (order[2] == 2);
+		EXPECT (otherThread == false);
+		EXPECT (getQueueStatistics (Async::mainQueue ()).queueDepth == 0);
+	);
+
+	TEST(backgroundQueueRunsOnWorkerThreads,
+		auto mainThread = std::this_thread::get_id ();
+		std::atomic<uint32_t> counter {0};
+		std::atomic<bool> onMainThread {false};
+		auto numExecuted = getQueueStatistics (Async::backgroundQueue ()).numExecuted;
+		for (auto i = 0; i < 100; ++i)
+		{
+			Async::schedule (Async::backgroundQueue (), [&] () {
+				if (std::this_thread::get_id () == mainThread)
+					onMainThread = true;
+				++counter;
+			});
+		}
+		terminateAsyncHandling ();
+		EXPECT (counter == 100);
+		EXPECT (onMainThread == false);
+		EXPECT (getQueueStatistics (Async::backgroundQueue ()).numExecuted == numExecuted + 100);
+	);
+
+	TEST(serialQueueKeepsOrder,
+		auto queue = Async::makeSerialQueue ("test");
+		std::vector<uint32_t> order;
+		for (auto i = 0u; i < 100; ++i)
+			Async::schedule (queue, [&order, i] () { order.emplace_back (i); });
+		terminateAsyncHandling ();
+		EXPECT (order.size () == 100);
+		for (auto i = 0u; i < order.size (); ++i)
+			EXPECT (order[i] == i);
+		EXPECT (getQueueStatistics (queue).numExecuted == 100);
+	);
+
+	TEST(terminatePerformsMainQueueTasksOfBackgroundTasks,
+		performMainContext ();
+		std::atomic<uint32_t> counter {0};
+		for (auto i = 0; i < 10; ++i)
+		{
+			Async::schedule (Async::backgroundQueue (), [&] () {
+				Async::schedule (Async::mainQueue (), [&] () { ++counter; });
+			});
+		}
+		terminateAsyncHandling ();
+		EXPECT (counter == 10);
+		EXPECT (getQueueStatistics (Async::mainQueue ()).queueDepth == 0);
+	);
+
+	TEST(cancelPendingMainQueueTasks,
+		performMainContext ();
+		uint32_t counter = 0;
+		auto numCancelled = getQueueStatistics (Async::mainQueue ()).numCancelled;
+		for (auto i = 0; i < 5; ++i)
+			Async::schedule (Async::mainQueue (), [&] () { ++counter; });
+		EXPECT (cancelPendingTasks (Async::mainQueue ()) == 5);
+		performMainContext ();
+		EXPECT (counter == 0);
+		EXPECT (getQueueStatistics (Async::mainQueue ()).numCancelled == numCancelled + 5);
+	);
+);
+
+} // VSTGUI
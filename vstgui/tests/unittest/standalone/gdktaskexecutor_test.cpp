@@ -0,0 +1,265 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../standalone/source/platform/gdk/gdktaskexecutor.h"
+#include "../unittests.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace VSTGUI {
+using namespace Standalone::Platform::GDK;
+
+namespace {
+
+//------------------------------------------------------------------------
+struct Gate
+{
+	void open ()
+	{
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			isOpen = true;
+		}
+		cond.notify_all ();
+	}
+
+	/** returns false if the gate was not opened within a second */
+	bool wait ()
+	{
+		std::unique_lock<std::mutex> lock (mutex);
+		return cond.wait_for (lock, std::chrono::seconds (1), [this] () { return isOpen; });
+	}
+
+	std::mutex mutex;
+	std::condition_variable cond;
+	bool isOpen {false};
+};
+
+//------------------------------------------------------------------------
+/** a serial queue performing its tasks when perform is called, like a run loop */
+struct ManualRunLoop
+{
+	ManualRunLoop ()
+	{
+		queue = TaskExecutor::SerialQueue::make (
+			[this] (TaskExecutor::Task&& task) { tasks.emplace_back (std::move (task)); });
+	}
+
+	uint32_t perform ()
+	{
+		auto current = std::move (tasks);
+		tasks.clear ();
+		for (auto& task : current)
+			task ();
+		return static_cast<uint32_t> (current.size ());
+	}
+
+	std::vector<TaskExecutor::Task> tasks;
+	std::shared_ptr<TaskExecutor::SerialQueue> queue;
+};
+
+//------------------------------------------------------------------------
+void scheduleRecursive (TaskExecutor& executor, std::atomic<uint32_t>& counter, uint32_t depth)
+{
+	++counter;
+	if (depth == 0)
+		return;
+	for (auto i = 0; i < 2; ++i)
+		executor.schedule (
+			[&executor, &counter, depth] () { scheduleRecursive (executor, counter, depth - 1); });
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(TaskExecutorTest,
+
+	TEST(performsAllTasks,
+		TaskExecutor executor (4);
+		EXPECT (executor.getNumThreads () == 4);
+		std::atomic<uint32_t> counter {0};
+		for (auto i = 0; i < 1000; ++i)
+			executor.schedule ([&] () { ++counter; });
+		executor.waitUntilIdle ();
+		EXPECT (executor.isIdle ());
+		EXPECT (counter == 1000);
+		auto statistics = executor.getStatistics ();
+		EXPECT (statistics.numScheduled == 1000);
+		EXPECT (statistics.numExecuted == 1000);
+		EXPECT (statistics.numCancelled == 0);
+		EXPECT (statistics.queueDepth == 0);
+		EXPECT (statistics.maxQueueDepth >= 1);
+		EXPECT (statistics.maxLatencyMicroseconds >= statistics.lastLatencyMicroseconds);
+		EXPECT (statistics.totalLatencyMicroseconds >= statistics.maxLatencyMicroseconds);
+	);
+
+	TEST(defaultsToOneThreadPerCore,
+		TaskExecutor executor;
+		EXPECT (executor.getNumThreads () >= std::thread::hardware_concurrency ());
+	);
+
+	TEST(tasksScheduledFromTasks,
+		TaskExecutor executor (3);
+		std::atomic<uint32_t> counter {0};
+		executor.schedule ([&] () { scheduleRecursive (executor, counter, 8); });
+		executor.waitUntilIdle ();
+		EXPECT (counter == 511);
+	);
+
+	TEST(tasksRunConcurrently,
+		TaskExecutor executor (2);
+		Gate first;
+		Gate second;
+		std::atomic<uint32_t> numOpened {0};
+		executor.schedule ([&] () {
+			first.open ();
+			if (second.wait ())
+				++numOpened;
+		});
+		executor.schedule ([&] () {
+			second.open ();
+			if (first.wait ())
+				++numOpened;
+		});
+		executor.waitUntilIdle ();
+		EXPECT (numOpened == 2);
+	);
+
+	TEST(pendingTasksArePerformedOnDestruction,
+		std::atomic<uint32_t> counter {0};
+		{
+			TaskExecutor executor (1);
+			for (auto i = 0; i < 100; ++i)
+				executor.schedule ([&] () { ++counter; });
+		}
+		EXPECT (counter == 100);
+	);
+
+	TEST(cancel,
+		TaskExecutor executor (1);
+		Gate gate;
+		Gate started;
+		bool cancelledTaskPerformed = false;
+		auto blocking = executor.schedule ([&] () {
+			started.open ();
+			gate.wait ();
+		});
+		auto cancelled = executor.schedule ([&] () { cancelledTaskPerformed = true; });
+		EXPECT (started.wait ());
+		EXPECT (blocking.cancel () == false);
+		EXPECT (cancelled.cancel ());
+		EXPECT (cancelled.isCancelled ());
+		EXPECT (blocking.isCancelled () == false);
+		gate.open ();
+		executor.waitUntilIdle ();
+		EXPECT (cancelledTaskPerformed == false);
+		auto statistics = executor.getStatistics ();
+		EXPECT (statistics.numExecuted == 1);
+		EXPECT (statistics.numCancelled == 1);
+		EXPECT (statistics.queueDepth == 0);
+	);
+
+	TEST(cancelPending,
+		TaskExecutor executor (1);
+		Gate gate;
+		Gate started;
+		std::atomic<uint32_t> counter {0};
+		executor.schedule ([&] () {
+			started.open ();
+			gate.wait ();
+		});
+		EXPECT (started.wait ());
+		for (auto i = 0; i < 10; ++i)
+			executor.schedule ([&] () { ++counter; });
+		EXPECT (executor.getStatistics ().queueDepth == 10);
+		EXPECT (executor.cancelPending () == 10);
+		EXPECT (executor.getStatistics ().queueDepth == 0);
+		gate.open ();
+		executor.waitUntilIdle ();
+		EXPECT (counter == 0);
+		EXPECT (executor.getStatistics ().numCancelled == 10);
+	);
+
+	TEST(serialQueueKeepsOrder,
+		TaskExecutor executor (4);
+		auto queue = executor.makeSerialQueue ();
+		std::vector<uint32_t> order;
+		std::atomic<uint32_t> numRunning {0};
+		std::atomic<bool> overlapped {false};
+		for (auto i = 0u; i < 1000; ++i)
+		{
+			queue->schedule ([&, i] () {
+				if (++numRunning != 1)
+					overlapped = true;
+				order.emplace_back (i);
+				--numRunning;
+			});
+		}
+		executor.waitUntilIdle ();
+		EXPECT (overlapped == false);
+		EXPECT (order.size () == 1000);
+		for (auto i = 0u; i < order.size (); ++i)
+			EXPECT (order[i] == i);
+		EXPECT (queue->getStatistics ().numExecuted == 1000);
+		EXPECT (executor.getStatistics ().numScheduled == 0);
+	);
+
+	TEST(serialQueueOnRunLoop,
+		ManualRunLoop runLoop;
+		std::vector<uint32_t> order;
+		for (auto i = 0u; i < 3; ++i)
+			runLoop.queue->schedule ([&order, i] () { order.emplace_back (i); });
+		EXPECT (runLoop.tasks.size () == 1);
+		EXPECT (order.empty ());
+		EXPECT (runLoop.queue->getStatistics ().queueDepth == 3);
+		EXPECT (runLoop.perform () == 1);
+		EXPECT (order.size () == 3);
+		EXPECT (order[0] == 0);
+		EXPECT (order[2] == 2);
+		EXPECT (runLoop.queue->getStatistics ().queueDepth == 0);
+		EXPECT (runLoop.queue->getStatistics ().maxQueueDepth == 3);
+		EXPECT (runLoop.perform () == 0);
+	);
+
+	TEST(serialQueuePostsAgainWhenBusy,
+		ManualRunLoop runLoop;
+		uint32_t counter = 0;
+		for (auto i = 0; i < 100; ++i)
+			runLoop.queue->schedule ([&] () { ++counter; });
+		uint32_t numPosts = 0;
+		while (runLoop.perform ())
+			++numPosts;
+		EXPECT (counter == 100);
+		EXPECT (numPosts > 1);
+	);
+
+	TEST(serialQueueCancel,
+		ManualRunLoop runLoop;
+		std::vector<uint32_t> order;
+		runLoop.queue->schedule ([&] () { order.emplace_back (0); });
+		auto handle = runLoop.queue->schedule ([&] () { order.emplace_back (1); });
+		runLoop.queue->schedule ([&] () { order.emplace_back (2); });
+		EXPECT (handle.cancel ());
+		runLoop.perform ();
+		EXPECT (order.size () == 2);
+		EXPECT (order[1] == 2);
+		EXPECT (handle.cancel ());
+		for (auto i = 0; i < 5; ++i)
+			runLoop.queue->schedule ([&] () { order.emplace_back (3); });
+		EXPECT (runLoop.queue->cancelPending () == 5);
+		runLoop.perform ();
+		EXPECT (order.size () == 2);
+		auto statistics = runLoop.queue->getStatistics ();
+		EXPECT (statistics.numScheduled == 8);
+		EXPECT (statistics.numExecuted == 2);
+		EXPECT (statistics.numCancelled == 6);
+		EXPECT (statistics.queueDepth == 0);
+	);
+
+);
+
+} // VSTGUI
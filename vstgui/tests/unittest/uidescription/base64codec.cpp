@@ -5,6 +5,7 @@
 #include "../unittests.h"
 #include "../../../uidescription/base64codec.h"
 #include <string>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -69,6 +70,43 @@ TESTCASE(Base64CodecTest,
 		 EXPECT (ptr[4] == 0x0D);
 		 EXPECT (ptr[5] == 0x0A);
 	);
+
+	TEST(encodeSingleByte,
+		 uint8_t binary = 0x89;
+		 auto result = Base64Codec::encode (&binary, 1);
+		 EXPECT (result.dataSize == 4);
+		 EXPECT (std::string (reinterpret_cast<const char*> (result.data.get ()), 4) == "iQ==");
+	);
+
+	TEST(roundTrip,
+		 // long enough to use the vector paths if they are available
+		 for (auto size = 0u; size < 200u; ++size)
+		 {
+			 std::vector<uint8_t> data (size);
+			 for (auto i = 0u; i < size; ++i)
+				 data[i] = static_cast<uint8_t> (i * 7 + size);
+			 auto encoded = Base64Codec::encode (data.data (), data.size ());
+			 EXPECT (encoded.dataSize == (size + 2) / 3 * 4);
+			 auto decoded = Base64Codec::decode (encoded.data.get (), encoded.dataSize);
+			 EXPECT (decoded.dataSize == size);
+			 EXPECT (std::equal (data.begin (), data.end (), decoded.data.get ()));
+		 }
+	);
+
+	TEST(streamDecode,
+		 std::string test ("iVBORw0KGgoAAAANSUhEUgAAAAwAAAAMCAYAAABWdVznAAAB");
+		 auto expected = Base64Codec::decode (test);
+		 for (auto bufferSize = 1u; bufferSize < 40u; ++bufferSize)
+		 {
+			 Base64Codec::Decoder decoder (test);
+			 std::vector<uint8_t> result;
+			 std::vector<uint8_t> buffer (bufferSize);
+			 while (auto numBytes = decoder.read (buffer.data (), buffer.size ()))
+				 result.insert (result.end (), buffer.begin (), buffer.begin () + numBytes);
+			 EXPECT (result.size () == expected.dataSize);
+			 EXPECT (std::equal (result.begin (), result.end (), expected.data.get ()));
+		 }
+	);
 );
 
 }
@@ -0,0 +1,282 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../unittests.h"
+#include "../../../uidescription/cstream.h"
+#include "../../../uidescription/detail/bitmapfiltercache.h"
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/platform/iplatformbitmap.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#if !WINDOWS
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#if !WINDOWS
+
+namespace VSTGUI {
+using namespace Detail;
+
+namespace {
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> makeBitmap (uint32_t seed)
+{
+	auto bitmap = makeOwned<CBitmap> (CPoint (13, 7));
+	if (auto platformBitmap = bitmap->getPlatformBitmap ())
+	{
+		if (auto pixelAccess = platformBitmap->lockPixels (false))
+		{
+			for (auto y = 0u; y < 7; ++y)
+			{
+				auto row = pixelAccess->getAddress () + y * pixelAccess->getBytesPerRow ();
+				for (auto x = 0u; x < 13 * 4; ++x)
+				{
+					seed = seed * 1664525u + 1013904223u;
+					row[x] = static_cast<uint8_t> (seed >> 24);
+				}
+			}
+		}
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+bool pixelsEqual (IPlatformBitmap* b1, IPlatformBitmap* b2)
+{
+	if (!b1 || !b2 || b1->getSize () != b2->getSize ())
+		return false;
+	auto access1 = b1->lockPixels (false);
+	auto access2 = b2->lockPixels (false);
+	if (!access1 || !access2)
+		return false;
+	auto width = static_cast<uint32_t> (b1->getSize ().x);
+	for (auto y = 0u; y < static_cast<uint32_t> (b1->getSize ().y); ++y)
+	{
+		auto row1 = access1->getAddress () + y * access1->getBytesPerRow ();
+		auto row2 = access2->getAddress () + y * access2->getBytesPerRow ();
+		if (memcmp (row1, row2, width * 4) != 0)
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+BitmapFilterCache::Source makeSource (const std::string& bitmapName, uint64_t revision)
+{
+	BitmapFilterCache::Source source;
+	source.bitmapName = bitmapName;
+	source.path = "source.png";
+	source.revision = revision;
+	return source;
+}
+
+//------------------------------------------------------------------------
+/** a temporary cache directory, removed with its files */
+struct CacheDirectory
+{
+	CacheDirectory ()
+	{
+		char buffer[] = "/tmp/vstgui_bitmapfiltercache_XXXXXX";
+		if (mkdtemp (buffer))
+			path = buffer;
+	}
+
+	~CacheDirectory () noexcept
+	{
+		for (const auto& file : files ())
+			remove (file.data ());
+		rmdir (path.data ());
+	}
+
+	std::vector<std::string> files () const
+	{
+		std::vector<std::string> result;
+		if (auto dir = opendir (path.data ()))
+		{
+			while (auto entry = readdir (dir))
+			{
+				std::string name (entry->d_name);
+				if (name != "." && name != "..")
+					result.emplace_back (path + "/" + name);
+			}
+			closedir (dir);
+		}
+		return result;
+	}
+
+	std::string path;
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TESTCASE(BitmapFilterCacheTest,
+
+	TEST(miss,
+		CacheDirectory directory;
+		EXPECT(directory.path.empty () == false);
+		auto source = makeBitmap (1);
+		if (!source->getPlatformBitmap ())
+			return true; // the platform can not create bitmaps
+		BitmapFilterCache::Key key;
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "filter", source, key));
+		EXPECT(BitmapFilterCache::load (directory.path, key) == nullptr);
+	);
+
+	TEST(hit,
+		CacheDirectory directory;
+		auto source = makeBitmap (1);
+		if (!source->getPlatformBitmap ())
+			return true;
+		auto result = makeBitmap (2);
+		BitmapFilterCache::Key key;
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "filter", source, key));
+		EXPECT(BitmapFilterCache::store (directory.path, key, result));
+		auto loaded = BitmapFilterCache::load (directory.path, key);
+		EXPECT(loaded);
+		EXPECT(pixelsEqual (loaded, result->getPlatformBitmap ()));
+		// the entry was renamed from its temporary file
+		EXPECT(directory.files ().size () == 1);
+	);
+
+	TEST(keyDoesNotDependOnSourcePixels,
+		auto source1 = makeBitmap (1);
+		auto source2 = makeBitmap (2);
+		if (!source1->getPlatformBitmap ())
+			return true;
+		BitmapFilterCache::Key key1;
+		BitmapFilterCache::Key key2;
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "filter", source1, key1));
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "filter", source2, key2));
+		EXPECT(key1.slot == key2.slot);
+		EXPECT(key1.value == key2.value);
+	);
+
+	TEST(parameterChangeInvalidates,
+		CacheDirectory directory;
+		auto source = makeBitmap (1);
+		if (!source->getPlatformBitmap ())
+			return true;
+		auto result = makeBitmap (2);
+		BitmapFilterCache::Key key;
+		BitmapFilterCache::Key changedFilterKey;
+		BitmapFilterCache::Key changedRevisionKey;
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "filter=1", source, key));
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "filter=2", source, changedFilterKey));
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 2), "filter=1", source, changedRevisionKey));
+		EXPECT(BitmapFilterCache::store (directory.path, key, result));
+		EXPECT(BitmapFilterCache::load (directory.path, changedFilterKey) == nullptr);
+		EXPECT(BitmapFilterCache::load (directory.path, changedRevisionKey) == nullptr);
+
+		// the new result replaces the entry of the source
+		auto changedResult = makeBitmap (3);
+		EXPECT(BitmapFilterCache::store (directory.path, changedFilterKey, changedResult));
+		EXPECT(directory.files ().size () == 1);
+		EXPECT(BitmapFilterCache::load (directory.path, key) == nullptr);
+		auto loaded = BitmapFilterCache::load (directory.path, changedFilterKey);
+		EXPECT(pixelsEqual (loaded, changedResult->getPlatformBitmap ()));
+	);
+
+	TEST(bitmapsOfTheSameSourceUseDifferentEntries,
+		CacheDirectory directory;
+		auto source = makeBitmap (1);
+		if (!source->getPlatformBitmap ())
+			return true;
+		auto result1 = makeBitmap (2);
+		auto result2 = makeBitmap (3);
+		BitmapFilterCache::Key key1;
+		BitmapFilterCache::Key key2;
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "blur", source, key1));
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b2", 1), "tint", source, key2));
+		EXPECT(key1.slot != key2.slot);
+		EXPECT(BitmapFilterCache::store (directory.path, key1, result1));
+		EXPECT(BitmapFilterCache::store (directory.path, key2, result2));
+		EXPECT(directory.files ().size () == 2);
+		EXPECT(pixelsEqual (BitmapFilterCache::load (directory.path, key1), result1->getPlatformBitmap ()));
+		EXPECT(pixelsEqual (BitmapFilterCache::load (directory.path, key2), result2->getPlatformBitmap ()));
+	);
+
+	TEST(changedSourceFileInvalidates,
+		CacheDirectory directory;
+		auto source = makeBitmap (1);
+		if (!source->getPlatformBitmap ())
+			return true;
+		auto filePath = directory.path + "/source.png";
+		auto writeFile = [&] (uint8_t value, uint32_t size) {
+			std::vector<uint8_t> content (size, value);
+			CFileStream stream;
+			return stream.open (filePath.data (), CFileStream::kWriteMode |
+			                                           CFileStream::kTruncateMode |
+			                                           CFileStream::kBinaryMode) &&
+			       stream.writeRaw (content.data (), size) == size;
+		};
+		EXPECT(writeFile (1, 100));
+		CResourceDescription resource (filePath.data ());
+		auto sourceInfo = makeSource ("b1", 1);
+		if (!BitmapFilterCache::hashContent (resource, sourceInfo.contentHash))
+		{
+			remove (filePath.data ());
+			return true; // the platform does not read resources from absolute paths
+		}
+		BitmapFilterCache::Key key;
+		EXPECT(BitmapFilterCache::makeKey (sourceInfo, "filter", source, key));
+		EXPECT(writeFile (2, 100));
+		EXPECT(BitmapFilterCache::hashContent (resource, sourceInfo.contentHash));
+		BitmapFilterCache::Key changedContentKey;
+		EXPECT(BitmapFilterCache::makeKey (sourceInfo, "filter", source, changedContentKey));
+		EXPECT(writeFile (2, 101));
+		EXPECT(BitmapFilterCache::hashContent (resource, sourceInfo.contentHash));
+		BitmapFilterCache::Key changedSizeKey;
+		EXPECT(BitmapFilterCache::makeKey (sourceInfo, "filter", source, changedSizeKey));
+		remove (filePath.data ());
+		EXPECT(key.slot == changedContentKey.slot);
+		EXPECT(key.value != changedContentKey.value);
+		EXPECT(changedContentKey.value != changedSizeKey.value);
+	);
+
+	TEST(corruptEntry,
+		CacheDirectory directory;
+		auto source = makeBitmap (1);
+		if (!source->getPlatformBitmap ())
+			return true;
+		auto result = makeBitmap (2);
+		BitmapFilterCache::Key key;
+		EXPECT(BitmapFilterCache::makeKey (makeSource ("b1", 1), "filter", source, key));
+		EXPECT(BitmapFilterCache::store (directory.path, key, result));
+		auto files = directory.files ();
+		EXPECT(files.size () == 1);
+		// truncated in the middle of the pixels
+		std::vector<uint8_t> content (64);
+		{
+			CFileStream stream;
+			EXPECT(stream.open (files[0].data (), CFileStream::kReadMode | CFileStream::kBinaryMode));
+			EXPECT(stream.readRaw (content.data (), 64) == 64);
+		}
+		{
+			CFileStream stream;
+			EXPECT(stream.open (files[0].data (), CFileStream::kWriteMode |
+			                                          CFileStream::kTruncateMode |
+			                                          CFileStream::kBinaryMode));
+			EXPECT(stream.writeRaw (content.data (), 64) == 64);
+		}
+		EXPECT(BitmapFilterCache::load (directory.path, key) == nullptr);
+		{
+			CFileStream stream;
+			EXPECT(stream.open (files[0].data (), CFileStream::kWriteMode |
+			                                          CFileStream::kTruncateMode |
+			                                          CFileStream::kBinaryMode));
+			std::vector<uint8_t> garbage (4096, 0x5a);
+			EXPECT(stream.writeRaw (garbage.data (), 4096) == 4096);
+		}
+		EXPECT(BitmapFilterCache::load (directory.path, key) == nullptr);
+	);
+);
+
+} // VSTGUI
+
+#endif // !WINDOWS
@@ -4,6 +4,13 @@
 
 #include "../unittests.h"
 #include "../../../uidescription/cstream.h"
+#include "../../../uidescription/uicontentprovider.h"
+#include "../../../lib/platform/common/mappedfileresourceinputstream.h"
+#include <cstdio>
+#include <cstring>
+#if !WINDOWS
+#include <unistd.h>
+#endif
 
 namespace VSTGUI {
 
@@ -38,6 +45,7 @@ TESTCASE(CMemoryStreamTests,
 		EXPECT(s.seek (0, CMemoryStream::kSeekEnd) == 32);
 		EXPECT(s.seek (-2, CMemoryStream::kSeekCurrent) == 30);
 		EXPECT(s.seek (15, CMemoryStream::kSeekSet) == 15);
+		EXPECT(s.seek (0, CMemoryStream::kSeekSet) == 0);
 	);
 	
 	TEST(readWriteValueLittleEndian,
@@ -136,4 +144,64 @@ TESTCASE(CMemoryStreamTests,
 	
 );
 
+#if !WINDOWS
+TESTCASE(MappedFileResourceInputStreamTests,
+
+	TEST(readSeek,
+		char path[] = "/tmp/vstgui_mappedfile_XXXXXX";
+		auto fd = mkstemp (path);
+		EXPECT(fd >= 0);
+		close (fd);
+		{
+			CFileStream fileStream;
+			EXPECT(fileStream.open (path, CFileStream::kWriteMode | CFileStream::kTruncateMode));
+			EXPECT(fileStream.writeRaw ("0123456789", 10) == 10);
+		}
+		auto stream = MappedFileResourceInputStream::create (path);
+		remove (path);
+		EXPECT(stream);
+		uint64_t size = 0;
+		auto memory = stream->getMemory (size);
+		EXPECT(memory);
+		EXPECT(size == 10);
+		EXPECT(memcmp (memory, "0123456789", 10) == 0);
+
+		char buffer[8];
+		EXPECT(stream->readRaw (buffer, 4) == 4);
+		EXPECT(memcmp (buffer, "0123", 4) == 0);
+		EXPECT(stream->tell () == 4);
+		EXPECT(stream->seek (-2, SeekMode::End) == 8);
+		EXPECT(stream->readRaw (buffer, 8) == 2);
+		EXPECT(memcmp (buffer, "89", 2) == 0);
+		EXPECT(stream->readRaw (buffer, 8) == 0);
+		EXPECT(stream->seek (11, SeekMode::Set) == kStreamSeekError);
+		EXPECT(stream->seek (-1, SeekMode::Current) == 9);
+	);
+
+	TEST(missingFile,
+		EXPECT(MappedFileResourceInputStream::create ("/tmp/vstgui_mappedfile_missing") == nullptr);
+	);
+
+	TEST(contentProvider,
+		char path[] = "/tmp/vstgui_mappedfile_XXXXXX";
+		auto fd = mkstemp (path);
+		EXPECT(fd >= 0);
+		EXPECT(write (fd, "<tag/>", 6) == 6);
+		close (fd);
+		auto stream = MappedFileResourceInputStream::create (path);
+		remove (path);
+		EXPECT(stream);
+		uint64_t size = 0;
+		auto memory = stream->getMemory (size);
+		MemoryContentProvider provider (memory, static_cast<uint32_t> (size));
+		int8_t buffer[2];
+		EXPECT(provider.readRawData (buffer, 2) == 2);
+		uint32_t contentSize = 0;
+		auto content = provider.getContent (contentSize);
+		EXPECT(contentSize == 4);
+		EXPECT(content == reinterpret_cast<const int8_t*> (memory) + 2);
+	);
+);
+#endif
+
 } // VSTGUI
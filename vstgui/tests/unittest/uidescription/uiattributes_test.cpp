@@ -97,6 +97,98 @@ TESTCASE(UIAttributesTest,
 		EXPECT(array == array2);
 	);
 
+	TEST(parsedValueCache,
+		UIAttributes a;
+		a.enableParsedValueCache ();
+		a.setRectAttribute ("Key", CRect (10, 20, 30, 40));
+		a.setAttribute ("Number", "5");
+		CRect r;
+		EXPECT(a.getRectAttribute ("Key", r));
+		EXPECT(r == CRect (10, 20, 30, 40));
+		EXPECT(a.getRectAttribute ("Key", r));
+		EXPECT(r == CRect (10, 20, 30, 40));
+		int32_t i;
+		double d;
+		bool b;
+		EXPECT(a.getIntegerAttribute ("Number", i));
+		EXPECT(i == 5);
+		EXPECT(a.getDoubleAttribute ("Number", d));
+		EXPECT(d == 5.);
+		EXPECT(a.getBooleanAttribute ("Number", b) == false);
+		a.setRectAttribute ("Key", CRect (1, 2, 3, 4));
+		EXPECT(a.getRectAttribute ("Key", r));
+		EXPECT(r == CRect (1, 2, 3, 4));
+	);
+
+	TEST(revision,
+		UIAttributes a;
+		auto revision = a.getRevision ();
+		a.setAttribute ("Key", "Value");
+		EXPECT(a.getRevision () != revision);
+		revision = a.getRevision ();
+		a.removeAttribute ("Key");
+		EXPECT(a.getRevision () != revision);
+		UIAttributes copy (a);
+		EXPECT(copy.getRevision () != a.getRevision ());
+	);
+
+	TEST(parsedValuesOfDifferentTypes,
+		UIAttributes a;
+		a.enableParsedValueCache ();
+		a.setAttribute ("Value", "16777217");
+		a.setPointAttribute ("Point", CPoint (10, 20));
+		int32_t i;
+		double d;
+		CPoint p;
+		CRect r;
+		EXPECT(a.getIntegerAttribute ("Value", i));
+		EXPECT(i == 16777217);
+		EXPECT(a.getDoubleAttribute ("Value", d));
+		EXPECT(d == 16777217.);
+		EXPECT(a.getIntegerAttribute ("Value", i));
+		EXPECT(i == 16777217);
+		EXPECT(a.getPointAttribute ("Point", p));
+		EXPECT(p == CPoint (10, 20));
+		EXPECT(a.getRectAttribute ("Point", r) == false);
+		EXPECT(a.getPointAttribute ("Point", p));
+		EXPECT(p == CPoint (10, 20));
+	);
+
+	TEST(derivedData,
+		struct Data : UIAttributes::DerivedData
+		{
+			bool* destroyed;
+			~Data () noexcept override { *destroyed = true; }
+		};
+		bool destroyed = false;
+		UIAttributes a;
+		auto data = new Data;
+		data->destroyed = &destroyed;
+		a.setDerivedData (std::unique_ptr<UIAttributes::DerivedData> (data));
+		EXPECT(a.getDerivedData () == data);
+		UIAttributes copy (a);
+		EXPECT(copy.getDerivedData () == nullptr);
+		a.setAttribute ("Key", "Value");
+		EXPECT(destroyed);
+		EXPECT(a.getDerivedData () == nullptr);
+	);
+
+	TEST(assign,
+		UIAttributes a;
+		a.enableParsedValueCache ();
+		a.setRectAttribute ("Key", CRect (10, 20, 30, 40));
+		CRect r;
+		EXPECT(a.getRectAttribute ("Key", r));
+		UIAttributes b;
+		b.setRectAttribute ("Key", CRect (1, 2, 3, 4));
+		auto revision = a.getRevision ();
+		a = b;
+		EXPECT(a.getRevision () != revision);
+		EXPECT(a.getRevision () != b.getRevision ());
+		EXPECT(a.getRectAttribute ("Key", r));
+		EXPECT(r == CRect (1, 2, 3, 4));
+	);
+
 	TEST(removeAll,
 		UIAttributes a;
 		a.setRectAttribute ("Key1", CRect (10, 20, 30, 40));
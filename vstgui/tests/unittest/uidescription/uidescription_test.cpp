@@ -9,11 +9,14 @@
 #include "../../../uidescription/icontroller.h"
 #include "../../../uidescription/uicontentprovider.h"
 #include "../../../uidescription/xmlparser.h"
+#include "../../../uidescription/detail/uidescformat.h"
+#include "../../../uidescription/detail/uinode.h"
 #include "../../../uidescription/detail/uiviewcreatorattributes.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/cbitmap.h"
 #include "../../../lib/cgradient.h"
 #include "../../../lib/cviewcontainer.h"
+#include "../../../lib/platform/platformfactory.h"
 
 namespace VSTGUI {
 
@@ -105,6 +108,24 @@ constexpr auto variableNodesUIDesc = R"(
 </vstgui-ui-description>
 )";
 
+constexpr auto dependentVariableNodesUIDesc = R"(
+<vstgui-ui-description version="1">
+	<variables>
+		<var name="width" value="10"/>
+		<var name="width2" value="var.width * 2"/>
+		<var name="total" value="var.width2 + var.width"/>
+		<var name="other" value="var.width2 / 4"/>
+		<var name="cycle1" value="var.cycle2 + 1"/>
+		<var name="cycle2" value="var.cycle1"/>
+		<var name="tagged" value="tag.t1"/>
+		<var name="indirect" value="var.tagged * 2"/>
+	</variables>
+	<control-tags>
+		<control-tag name="t1" tag="100"/>
+	</control-tags>
+</vstgui-ui-description>
+)";
+
 constexpr auto withAllNodesUIDesc = R"(<?xml version="1.0" encoding="UTF-8"?>
 <vstgui-ui-description version="1">
 	<colors>
@@ -160,6 +181,33 @@ constexpr auto createViewUIDesc = R"(
 </vstgui-ui-description>
 )";
 
+constexpr auto prefetchUIDesc = R"(
+<vstgui-ui-description version="1">
+	<bitmaps>
+		<bitmap name="b1" path="b1.png"/>
+		<bitmap name="b1#2.0x" path="b1#2.0x.png" scale-factor="2"/>
+		<bitmap name="b2" path="b2.png"/>
+	</bitmaps>
+	<fonts>
+		<font font-name="Arial" name="f1" size="8"/>
+		<font font-name="Arial" name="f2" size="8"/>
+	</fonts>
+	<gradients>
+		<gradient name="g1">
+			<color-stop rgba="#000000ff" start="0"/>
+			<color-stop rgba="#ffffffff" start="1"/>
+		</gradient>
+	</gradients>
+	<template background-image="b1" class="CViewContainer" name="view" origin="0, 0" size="400, 235">
+		<view class="CTextLabel" font="f1" origin="4, 10" size="392, 40"/>
+		<view origin="4, 60" size="392, 40" template="sub"/>
+	</template>
+	<template class="CViewContainer" name="sub" origin="0, 0" size="392, 40">
+		<view class="CGradientView" gradient="g1" origin="0, 0" size="392, 40"/>
+	</template>
+</vstgui-ui-description>
+)";
+
 constexpr auto restoreViewUIDesc = R"(
 <vstgui-ui-description version="1">
 	<template background-color="~ TransparentCColor" background-color-draw-style="filled and stroked" class="CViewContainer" mouse-enabled="true" name="view" opacity="1" origin="0, 0" size="400, 235" transparent="false">
@@ -418,6 +466,27 @@ constexpr auto gradientNodesUIDesc = R"(
 }
 )";
 
+constexpr auto dependentVariableNodesUIDesc = R"(
+{
+	"vstgui-ui-description": {
+		"version": "1",
+		"variables": {
+			"width": "10",
+			"width2": "var.width * 2",
+			"total": "var.width2 + var.width",
+			"other": "var.width2 / 4",
+			"cycle1": "var.cycle2 + 1",
+			"cycle2": "var.cycle1",
+			"tagged": "tag.t1",
+			"indirect": "var.tagged * 2"
+		},
+		"control-tags": {
+			"t1": "100"
+		}
+	}
+}
+)";
+
 constexpr auto variableNodesUIDesc = R"(
 {
 	"vstgui-ui-description": {
@@ -530,6 +599,92 @@ constexpr auto createViewUIDesc = R"(
 }
 )";
 
+constexpr auto prefetchUIDesc = R"(
+{
+	"vstgui-ui-description": {
+		"version": "1",
+		"bitmaps": {
+			"b1": {
+				"path": "b1.png"
+			},
+			"b1#2.0x": {
+				"path": "b1#2.0x.png",
+				"scale-factor": "2"
+			},
+			"b2": {
+				"path": "b2.png"
+			}
+		},
+		"fonts": {
+			"f1": {
+				"font-name": "Arial",
+				"size": "8"
+			},
+			"f2": {
+				"font-name": "Arial",
+				"size": "8"
+			}
+		},
+		"gradients": {
+			"g1": [
+				{
+					"rgba": "#000000ff",
+					"start": "0"
+				},
+				{
+					"rgba": "#ffffffff",
+					"start": "1"
+				}
+			]
+		},
+		"templates": {
+			"view": {
+				"attributes": {
+					"background-image": "b1",
+					"class": "CViewContainer",
+					"origin": "0, 0",
+					"size": "400, 235"
+				},
+				"children": {
+					"CTextLabel": {
+						"attributes": {
+							"class": "CTextLabel",
+							"font": "f1",
+							"origin": "4, 10",
+							"size": "392, 40"
+						}
+					},
+					"view": {
+						"attributes": {
+							"origin": "4, 60",
+							"size": "392, 40",
+							"template": "sub"
+						}
+					}
+				}
+			},
+			"sub": {
+				"attributes": {
+					"class": "CViewContainer",
+					"origin": "0, 0",
+					"size": "392, 40"
+				},
+				"children": {
+					"CGradientView": {
+						"attributes": {
+							"class": "CGradientView",
+							"gradient": "g1",
+							"origin": "0, 0",
+							"size": "392, 40"
+						}
+					}
+				}
+			}
+		}
+	}
+}
+)";
+
 constexpr auto restoreViewUIDesc = R"(
 {
 	"vstgui-ui-description": {
@@ -1428,8 +1583,74 @@ struct SaveUIDescription : public UIDescription
 	: UIDescription (xmlContentProvider) {}
 
 	using UIDescription::saveToStream;
+	using UIDescription::setContentProvider;
 };
 
+//------------------------------------------------------------------------
+/** a description of a multi page editor: control tags, colors and templates with rows of knobs
+ *	and labels */
+std::string makeEditorUIDesc (uint32_t numTemplates, uint32_t numViews)
+{
+	std::string str = R"({"vstgui-ui-description": {"version": "1", "control-tags": {)";
+	for (auto i = 0u; i < numTemplates * numViews / 2; ++i)
+	{
+		if (i)
+			str += ", ";
+		str += "\"Param" + std::to_string (i) + "\": \"" + std::to_string (i) + "\"";
+	}
+	str += R"(}, "colors": {)";
+	for (auto i = 0u; i < 8; ++i)
+	{
+		if (i)
+			str += ", ";
+		str += "\"Color" + std::to_string (i) + "\": \"#" + std::to_string (100000 + i) + "ff\"";
+	}
+	str += R"(}, "templates": {)";
+	for (auto t = 0u; t < numTemplates; ++t)
+	{
+		if (t)
+			str += ", ";
+		str += "\"Page" + std::to_string (t) +
+		       R"(": {"attributes": {"class": "CViewContainer", "origin": "0, 0", "size": "800, 600", "background-color": "Color0"}, "children": {)";
+		for (auto v = 0u; v < numViews; ++v)
+		{
+			auto tag = "Param" + std::to_string ((t * numViews + v) / 2);
+			auto origin = std::to_string ((v % 10) * 80) + ", " + std::to_string ((v / 10) * 60);
+			if (v)
+				str += ", ";
+			if (v % 2)
+				str += R"("CTextLabel": {"attributes": {"class": "CTextLabel", "origin": ")" + origin +
+				       R"(", "size": "70, 20", "font-color": "Color1", "title": "Label", "transparent": "true"}})";
+			else
+				str += R"("CKnob": {"attributes": {"class": "CKnob", "control-tag": ")" + tag +
+				       R"(", "origin": ")" + origin +
+				       R"(", "size": "40, 40", "corona-color": "Color2", "handle-color": "Color3"}})";
+		}
+		str += "}}";
+	}
+	str += "}}}";
+	return str;
+}
+
+//------------------------------------------------------------------------
+/** desc saved with flags, parsed again and saved as JSON, empty if saving or parsing failed */
+std::string saveAndParse (SaveUIDescription& desc, int32_t flags, bool lazyTemplates)
+{
+	CMemoryStream stream (1024, 1024, false);
+	if (!desc.saveToStream (stream, flags))
+		return {};
+	MemoryContentProvider provider (stream.getBuffer (), static_cast<uint32_t> (stream.tell ()));
+	SaveUIDescription parsedDesc (&provider);
+	parsedDesc.setLazyTemplates (lazyTemplates);
+	if (!parsedDesc.parse ())
+		return {};
+	CMemoryStream outputStream (1024, 1024, false);
+	if (!parsedDesc.saveToStream (outputStream, 0))
+		return {};
+	outputStream.end ();
+	return reinterpret_cast<const char*> (outputStream.getBuffer ());
+}
+
 struct Controller : public IController
 {
 	void valueChanged (CControl* pControl) override {};
@@ -1526,6 +1747,29 @@ private:
 	uint32_t called;
 };
 
+//------------------------------------------------------------------------
+/** the name of font "f6" ("bla" with the alternatives "Arial, Courier") */
+std::string expectedAlternativeFontName ()
+{
+#if MAC || WINDOWS
+	return "Arial";
+#else
+	// Arial is not installed on every Linux system. Then the next installed alternative is used,
+	// and if neither Arial nor Courier is installed the font keeps its own name "bla"
+	std::vector<std::string> fontFamilies;
+	getPlatformFactory ().getAllFontFamilies ([&] (const std::string& name) {
+		fontFamilies.emplace_back (name);
+		return true;
+	});
+	for (const auto& name : {"Arial", "Courier"})
+	{
+		if (std::find (fontFamilies.begin (), fontFamilies.end (), name) != fontFamilies.end ())
+			return name;
+	}
+	return "bla";
+#endif
+}
+
 } // anonymous
 
 using StringPtrList = std::list<const std::string*>;
@@ -1613,7 +1857,7 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(font->getSize() == 8);
 		EXPECT(font->getStyle() == kStrikethroughFace);
 		font = desc.getFont("f6");
-		EXPECT(font->getName () == std::string ("Arial"));
+		EXPECT(font->getName () == expectedAlternativeFontName ());
 		EXPECT(font->getSize() == 8);
 		std::string altFontNames;
 		EXPECT(desc.getAlternativeFontNames("f5", altFontNames) == false);
@@ -1672,6 +1916,35 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(dynamic_cast<CNinePartTiledBitmap*>(bitmap) == nullptr);
 	);
 	
+	TEST(lookupBitmapNameLoadsNoOtherBitmaps,
+		MemoryContentProvider provider (prefetchUIDesc, static_cast<uint32_t> (strlen(prefetchUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto bitmap = desc.getBitmap ("b2");
+		EXPECT(bitmap);
+		EXPECT(desc.lookupBitmapName (bitmap) == std::string ("b2"));
+		auto foreignBitmap = owned (new CBitmap (CResourceDescription ("b1.png")));
+		EXPECT(desc.lookupBitmapName (foreignBitmap) == nullptr);
+		auto bitmapsNode = desc.getRootNode ()->getChildren ().findChildNode ("bitmaps");
+		EXPECT(bitmapsNode);
+		uint32_t numLoaded = 0;
+		for (auto& node : bitmapsNode->getChildren ())
+		{
+			if (auto bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (node))
+			{
+				if (bitmapNode->hasBitmap ())
+					++numLoaded;
+			}
+		}
+		EXPECT(numLoaded == 1);
+		SharedPointer<CBitmap> oldBitmap (bitmap);
+		desc.changeBitmap ("b2", "b3.png", nullptr);
+		EXPECT(desc.lookupBitmapName (oldBitmap) == nullptr);
+		bitmap = desc.getBitmap ("b2");
+		EXPECT(bitmap != oldBitmap);
+		EXPECT(desc.lookupBitmapName (bitmap) == std::string ("b2"));
+	);
+
 	TEST(tags,
 		MemoryContentProvider provider (tagNodesUIDesc, static_cast<uint32_t> (strlen(tagNodesUIDesc)));
 		UIDescription desc (&provider);
@@ -1698,6 +1971,43 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(desc.getTagForName ("new control tag") == 4);
 	);
 
+	TEST(lookupTagNameFollowsChanges,
+		MemoryContentProvider provider (tagNodesUIDesc, static_cast<uint32_t> (strlen(tagNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		EXPECT(desc.lookupControlTagName (1234) == std::string ("t1"));
+		EXPECT(desc.lookupControlTagName (4321) == std::string ("t2"));
+		desc.changeControlTagString ("t2", "1000 + 1");
+		EXPECT(desc.lookupControlTagName (4321) == nullptr);
+		EXPECT(desc.lookupControlTagName (1001) == std::string ("t2"));
+		desc.changeTagName ("t1", "t0");
+		EXPECT(desc.lookupControlTagName (1234) == std::string ("t0"));
+		desc.removeTag ("t0");
+		EXPECT(desc.lookupControlTagName (1234) == nullptr);
+		desc.changeControlTagString ("t4", "1234", true);
+		EXPECT(desc.lookupControlTagName (1234) == std::string ("t4"));
+	);
+
+	TEST(lookupColorNameFollowsChanges,
+		MemoryContentProvider provider (colorNodesUIDesc, static_cast<uint32_t> (strlen(colorNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		EXPECT(desc.lookupColorName (CColor (255, 0, 0, 100)) == std::string ("c3"));
+		desc.changeColor ("c3", CColor (1, 2, 3, 4));
+		EXPECT(desc.lookupColorName (CColor (255, 0, 0, 100)) == nullptr);
+		EXPECT(desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("c3"));
+		// the first color in list order wins if more than one has the same value
+		desc.changeColor ("c4", CColor (1, 2, 3, 4));
+		EXPECT(desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("c3"));
+		desc.removeColor ("c3");
+		EXPECT(desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("c4"));
+		desc.changeColorName ("c4", "c0");
+		EXPECT(desc.lookupColorName (CColor (1, 2, 3, 4)) == std::string ("c0"));
+		CColor c;
+		EXPECT(desc.getColor ("c0", c));
+		EXPECT(desc.getColor ("c4", c) == false);
+	);
+
 	TEST(lookupTagsCalculateTag,
 		MemoryContentProvider provider (calculateTagNodesUIDesc, static_cast<uint32_t> (strlen(calculateTagNodesUIDesc)));
 		UIDescription desc (&provider);
@@ -1761,6 +2071,19 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(strValue == "");
 	);
 	
+	TEST(resourceRevision,
+		MemoryContentProvider provider (variableNodesUIDesc, static_cast<uint32_t> (strlen(variableNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		auto revision = desc.getResourceRevision ();
+		EXPECT(revision != 0);
+		double value;
+		EXPECT(desc.getVariable ("v1", value));
+		EXPECT(desc.getResourceRevision () == revision);
+		desc.changeColor ("c1", kRedCColor);
+		EXPECT(desc.getResourceRevision () != revision);
+	);
+
 	TEST(calculations,
 		MemoryContentProvider provider (tagNodesUIDesc, static_cast<uint32_t> (strlen(tagNodesUIDesc)));
 		UIDescription desc (&provider);
@@ -1782,6 +2105,74 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(desc.calculateStringValue ("unknown", value) == false);
 	);
 
+	TEST(calculationsPrecedence,
+		MemoryContentProvider provider (tagNodesUIDesc, static_cast<uint32_t> (strlen(tagNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		double value;
+		EXPECT(desc.calculateStringValue ("2 + 3 * 4", value));
+		EXPECT(value == 14.);
+		EXPECT(desc.calculateStringValue ("8 / 2 / 2", value));
+		EXPECT(value == 2.);
+		EXPECT(desc.calculateStringValue ("10 - 4 - 3", value));
+		EXPECT(value == 3.);
+		EXPECT(desc.calculateStringValue ("- 2 * 3 + 1", value));
+		EXPECT(value == -5.);
+		EXPECT(desc.calculateStringValue ("2 * (tag.t2 - 4321 + 3)", value));
+		EXPECT(value == 6.);
+		EXPECT(desc.calculateStringValue ("2 * * 3", value) == false);
+		EXPECT(desc.calculateStringValue ("2 3", value) == false);
+		EXPECT(desc.calculateStringValue ("(2))", value) == false);
+		// evaluating a compiled expression a second time gives the same result
+		EXPECT(desc.calculateStringValue ("2 + 3 * 4", value));
+		EXPECT(value == 14.);
+	);
+
+	TEST(expressionCacheClearedDuringEvaluation,
+		MemoryContentProvider provider (variableNodesUIDesc, static_cast<uint32_t> (strlen(variableNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		double value;
+		// fill the cache of compiled expressions, so that compiling the expression of v5 while
+		// the expression below is evaluated clears it
+		for (auto i = 0; i < 4095; ++i)
+			EXPECT(desc.calculateStringValue (("1+" + std::to_string (i)).data (), value));
+		EXPECT(desc.calculateStringValue ("var.v5 + 1", value));
+		EXPECT(value == 21.);
+		EXPECT(desc.calculateStringValue ("var.v5 + 1", value));
+		EXPECT(value == 21.);
+	);
+
+	TEST(dependentVariables,
+		MemoryContentProvider provider (dependentVariableNodesUIDesc, static_cast<uint32_t> (strlen(dependentVariableNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		double value;
+		EXPECT(desc.getVariable ("total", value));
+		EXPECT(value == 30.);
+		EXPECT(desc.getVariable ("other", value));
+		EXPECT(value == 5.);
+		EXPECT(desc.getVariable ("cycle1", value) == false);
+		EXPECT(desc.getVariable ("cycle2", value) == false);
+		EXPECT(desc.calculateStringValue ("var.total + var.width", value));
+		EXPECT(value == 40.);
+		EXPECT(desc.getVariable ("unknown", value) == false);
+	);
+
+	TEST(variablesIndirectlyDependingOnControlTags,
+		MemoryContentProvider provider (dependentVariableNodesUIDesc, static_cast<uint32_t> (strlen(dependentVariableNodesUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		double value;
+		EXPECT(desc.getVariable ("indirect", value));
+		EXPECT(value == 200.);
+		desc.changeControlTagString ("t1", "150");
+		EXPECT(desc.getVariable ("tagged", value));
+		EXPECT(value == 150.);
+		EXPECT(desc.getVariable ("indirect", value));
+		EXPECT(value == 300.);
+	);
+
 	TEST(writeToStream,
 		std::string str (withAllNodesUIDesc);
 		MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
@@ -1795,6 +2186,177 @@ TESTCASE(UIDescriptionTests,
 		EXPECT(result == str);
 	);
 
+	TEST(writeBinaryToStream,
+		std::string str (withAllNodesUIDesc);
+		MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream binaryStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (binaryStream, UIDescription::kWriteAsBinary | defaultSafeFlags));
+		auto binarySize = static_cast<uint32_t> (binaryStream.tell ());
+
+		MemoryContentProvider binaryProvider (binaryStream.getBuffer (), binarySize);
+		SaveUIDescription binaryDesc (&binaryProvider);
+		EXPECT(binaryDesc.parse () == true);
+		CMemoryStream outputStream (1024, 1024, false);
+		EXPECT(binaryDesc.saveToStream (outputStream, defaultSafeFlags));
+		outputStream.end ();
+		std::string result (reinterpret_cast<const char*> (outputStream.getBuffer ()));
+		EXPECT(result == str);
+	);
+
+	TEST(parseTruncatedBinary,
+		MemoryContentProvider provider (createViewUIDesc, static_cast<uint32_t> (strlen(createViewUIDesc)));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream binaryStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (binaryStream, UIDescription::kWriteAsBinary));
+		auto binarySize = static_cast<uint32_t> (binaryStream.tell ());
+		for (auto size = 0u; size < binarySize; size += 7)
+		{
+			MemoryContentProvider binaryProvider (binaryStream.getBuffer (), size);
+			UIDescription binaryDesc (&binaryProvider);
+			EXPECT(binaryDesc.parse () == false);
+		}
+		MemoryContentProvider binaryProvider (binaryStream.getBuffer (), binarySize);
+		UIDescription binaryDesc (&binaryProvider);
+		EXPECT(binaryDesc.parse () == true);
+		EXPECT(binaryDesc.getViewAttributes ("view") != nullptr);
+	);
+
+	TEST(lazyTemplates,
+		MemoryContentProvider provider (prefetchUIDesc, static_cast<uint32_t> (strlen (prefetchUIDesc)));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream binaryStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (binaryStream, UIDescription::kWriteAsBinary));
+
+		std::vector<int8_t> content (binaryStream.getBuffer (), binaryStream.getBuffer () + binaryStream.tell ());
+		MemoryContentProvider binaryProvider (content.data (), static_cast<uint32_t> (content.size ()));
+		SaveUIDescription lazyDesc (&binaryProvider);
+		lazyDesc.setLazyTemplates (true);
+		EXPECT(lazyDesc.parse () == true);
+		// without an owner of the content the templates are read from a copy
+		std::fill (content.begin (), content.end (), 0);
+		auto& templates = lazyDesc.getRootNode ()->getChildren ();
+		auto view = dynamic_cast<Detail::UILazyNode*> (templates.findChildNodeWithAttributeValue ("name", "view"));
+		auto sub = dynamic_cast<Detail::UILazyNode*> (templates.findChildNodeWithAttributeValue ("name", "sub"));
+		EXPECT(view != nullptr);
+		EXPECT(sub != nullptr);
+		EXPECT(lazyDesc.getViewAttributes ("view") != nullptr);
+		EXPECT(view->childrenCreated () == false);
+		EXPECT(view->getChildren ().size () == 2);
+		EXPECT(view->childrenCreated () == true);
+		EXPECT(sub->childrenCreated () == false);
+
+		CMemoryStream eagerStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (eagerStream, defaultSafeFlags));
+		eagerStream.end ();
+		CMemoryStream lazyStream (1024, 1024, false);
+		EXPECT(lazyDesc.saveToStream (lazyStream, defaultSafeFlags));
+		lazyStream.end ();
+		EXPECT(sub->childrenCreated () == true);
+		std::string eager (reinterpret_cast<const char*> (eagerStream.getBuffer ()));
+		std::string lazy (reinterpret_cast<const char*> (lazyStream.getBuffer ()));
+		EXPECT(eager == lazy);
+	);
+
+	TEST(lazyTemplatesKeepContentOwner,
+		MemoryContentProvider provider (prefetchUIDesc, static_cast<uint32_t> (strlen (prefetchUIDesc)));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream binaryStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (binaryStream, UIDescription::kWriteAsBinary));
+
+		auto content = std::make_shared<std::vector<int8_t>> (binaryStream.getBuffer (), binaryStream.getBuffer () + binaryStream.tell ());
+		std::weak_ptr<std::vector<int8_t>> contentRef (content);
+		{
+			SaveUIDescription lazyDesc (nullptr);
+			lazyDesc.setLazyTemplates (true);
+			{
+				MemoryContentProvider binaryProvider (content->data (), static_cast<uint32_t> (content->size ()), content);
+				content = nullptr;
+				lazyDesc.setContentProvider (&binaryProvider);
+				EXPECT(lazyDesc.parse () == true);
+				lazyDesc.setContentProvider (nullptr);
+			}
+			// the lazy templates read from the content in place and keep it alive
+			EXPECT(contentRef.expired () == false);
+			auto view = dynamic_cast<Detail::UILazyNode*> (lazyDesc.getRootNode ()->getChildren ().findChildNodeWithAttributeValue ("name", "view"));
+			EXPECT(view != nullptr);
+			EXPECT(view->getChildren ().size () == 2);
+
+			CMemoryStream eagerStream (1024, 1024, false);
+			EXPECT(desc.saveToStream (eagerStream, defaultSafeFlags));
+			eagerStream.end ();
+			CMemoryStream lazyStream (1024, 1024, false);
+			EXPECT(lazyDesc.saveToStream (lazyStream, defaultSafeFlags));
+			lazyStream.end ();
+			std::string eager (reinterpret_cast<const char*> (eagerStream.getBuffer ()));
+			std::string lazy (reinterpret_cast<const char*> (lazyStream.getBuffer ()));
+			EXPECT(eager == lazy);
+		}
+		EXPECT(contentRef.expired ());
+	);
+
+	TEST(allFormatsParseToTheSameDescription,
+		auto json = makeEditorUIDesc (4, 20);
+		MemoryContentProvider provider (json.data (), static_cast<uint32_t> (json.size ()));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		CMemoryStream stream (1024, 1024, false);
+		EXPECT(desc.saveToStream (stream, 0));
+		stream.end ();
+		std::string expected (reinterpret_cast<const char*> (stream.getBuffer ()));
+		EXPECT(saveAndParse (desc, 0, false) == expected);
+		EXPECT(saveAndParse (desc, UIDescription::kWriteAsBinary, false) == expected);
+		EXPECT(saveAndParse (desc, UIDescription::kWriteAsBinary, true) == expected);
+		if (defaultSafeFlags & UIDescription::kWriteAsXML)
+		{
+			EXPECT(saveAndParse (desc, UIDescription::kWriteAsXML, false) == expected);
+		}
+	);
+
+	TEST(detectFormat,
+		using Format = UIDescription::Format;
+		EXPECT(Detail::detectUIDescFormat ("\r\n\t {\"vstgui-ui-description\"", 27) == Format::JSON);
+		EXPECT(Detail::detectUIDescFormat ("\xEF\xBB\xBF<?xml", 8) == Format::XML);
+		EXPECT(Detail::detectUIDescFormat ("\xFF\xFE<\0", 4) == Format::XML);
+		EXPECT(Detail::detectUIDescFormat ("uidescrp", 8) == Format::Compressed);
+		EXPECT(Detail::detectUIDescFormat ("vgub", 4) == Format::Binary);
+		EXPECT(Detail::detectUIDescFormat ("vgu", 3) == Format::Unknown);
+		EXPECT(Detail::detectUIDescFormat ("   ", 3) == Format::Unknown);
+		EXPECT(Detail::detectUIDescFormat ("", 0) == Format::Unknown);
+
+		CMemoryStream stream (reinterpret_cast<const int8_t*> (emptyUIDesc), static_cast<uint32_t> (strlen (emptyUIDesc)), false);
+		InputStreamContentProvider provider (stream);
+		auto format = Detail::detectUIDescFormat (provider);
+		EXPECT(format == Format::JSON || format == Format::XML);
+		EXPECT(stream.tell () == 0);
+	);
+
+	TEST(parseStatistics,
+		std::string json = R"({"vstgui-ui-description": {"version": "1"}})";
+		MemoryContentProvider provider (json.data (), static_cast<uint32_t> (json.size ()));
+		SaveUIDescription desc (&provider);
+		EXPECT(desc.getParseStatistics ().format == UIDescription::Format::Unknown);
+		EXPECT(desc.parse () == true);
+		EXPECT(desc.getParseStatistics ().format == UIDescription::Format::JSON);
+
+		CMemoryStream binaryStream (1024, 1024, false);
+		EXPECT(desc.saveToStream (binaryStream, UIDescription::kWriteAsBinary));
+		MemoryContentProvider binaryProvider (binaryStream.getBuffer (), static_cast<uint32_t> (binaryStream.tell ()));
+		UIDescription binaryDesc (&binaryProvider);
+		EXPECT(binaryDesc.parse () == true);
+		EXPECT(binaryDesc.getParseStatistics ().format == UIDescription::Format::Binary);
+
+		std::string compressed = "uidescrp";
+		MemoryContentProvider compressedProvider (compressed.data (), static_cast<uint32_t> (compressed.size ()));
+		UIDescription compressedDesc (&compressedProvider);
+		EXPECT(compressedDesc.parse () == false);
+		EXPECT(compressedDesc.getParseStatistics ().format == UIDescription::Format::Compressed);
+	);
+
 	TEST(getViewAttributes,
 		 MemoryContentProvider provider (createViewUIDesc, static_cast<uint32_t> (strlen(createViewUIDesc)));
 		 UIDescription desc (&provider);
@@ -2094,6 +2656,26 @@ TESTCASE(UIDescriptionTests,
 
 		desc.setSharedResources (nullptr);
 	);
+	TEST(prefetchTemplateResources,
+		MemoryContentProvider provider (prefetchUIDesc, static_cast<uint32_t> (strlen(prefetchUIDesc)));
+		UIDescription desc (&provider);
+		EXPECT(desc.parse () == true);
+		desc.setPrefetchTemplateResources (true);
+		auto view = owned (desc.createView ("view", nullptr));
+		EXPECT(view);
+		const auto& statistics = desc.getCreateViewStatistics ();
+		EXPECT(statistics.numPrefetchedBitmaps == 2);
+		EXPECT(statistics.numPrefetchedFonts == 1);
+		EXPECT(statistics.numPrefetchedGradients == 1);
+		EXPECT(desc.getBitmap ("b1") != nullptr);
+		EXPECT(desc.getFont ("f1") != nullptr);
+
+		// the sub template is prefetched with the template including it
+		view = owned (desc.createView ("sub", nullptr));
+		EXPECT(view);
+		EXPECT(desc.getCreateViewStatistics ().numPrefetchedBitmaps == 0);
+		EXPECT(desc.getCreateViewStatistics ().numPrefetchedGradients == 1);
+	);
 );
 
 #if 0
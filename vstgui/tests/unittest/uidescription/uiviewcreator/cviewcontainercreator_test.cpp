@@ -38,6 +38,26 @@ TESTCASE(CViewContainerCreatorTest,
 		});
 	);
 
+	TEST(renderCache,
+		DummyUIDescription uidesc;
+		testAttribute<CViewContainer>(kCViewContainer, kAttrRenderCache, true, &uidesc, [] (CViewContainer* v) {
+			return v->isRenderCacheEnabled ();
+		});
+		testAttribute<CViewContainer>(kCViewContainer, kAttrRenderCache, false, &uidesc, [] (CViewContainer* v) {
+			return !v->isRenderCacheEnabled ();
+		});
+	);
+
+	TEST(opaque,
+		DummyUIDescription uidesc;
+		testAttribute<CViewContainer>(kCViewContainer, kAttrOpaque, true, &uidesc, [] (CViewContainer* v) {
+			return v->getOpaque ();
+		});
+		testAttribute<CViewContainer>(kCViewContainer, kAttrOpaque, false, &uidesc, [] (CViewContainer* v) {
+			return !v->getOpaque ();
+		});
+	);
+
 	TEST(backgroundColorDrawStyleValues,
 		DummyUIDescription uidesc;
 		testPossibleValues (kCViewContainer, kAttrBackgroundColorDrawStyle, &uidesc, {"stroked", "filled", "filled and stroked"});
@@ -8,6 +8,7 @@
 #include "../../../uidescription/uiviewfactory.h"
 #include "../../../uidescription/uiattributes.h"
 #include "../../../uidescription/detail/uiviewcreatorattributes.h"
+#include "uidescriptionadapter.h"
 #include <algorithm>
 
 namespace VSTGUI {
@@ -173,6 +174,22 @@ static SharedPointer<CView> createView (IViewFactory* factory)
 	return owned (factory->createView (a, nullptr));
 }
 
+//------------------------------------------------------------------------
+struct VariableDescription : UIDescriptionAdapter
+{
+	bool getVariable (UTF8StringPtr name, std::string& value) const override
+	{
+		if (std::string (name) != "var")
+			return false;
+		value = variableValue;
+		return true;
+	}
+	uint64_t getResourceRevision () const override { return revision; }
+
+	std::string variableValue;
+	uint64_t revision {1};
+};
+
 } // anonymous
 
 TESTCASE(UIViewFactoryTests,
@@ -238,6 +255,60 @@ TESTCASE(UIViewFactoryTests,
 		EXPECT(view->value == 1);
 	);
 
+	TEST(applyChangedAttributes,
+		auto v = createView (factory);
+		auto view = v.cast<View>();
+		UIAttributes a;
+		a.setIntegerAttribute (viewAttr, 1);
+		factory->applyAttributeValues (v, a, nullptr);
+		EXPECT(view->value == 1);
+		a.setIntegerAttribute (viewAttr, 2);
+		factory->applyAttributeValues (v, a, nullptr);
+		EXPECT(view->value == 2);
+	);
+
+	TEST(createViewRepeatedly,
+		UIAttributes a;
+		a.setAttribute (UIViewCreator::kAttrClass, viewCreator.getViewName ());
+		a.setIntegerAttribute (viewAttr, 3);
+		a.setAttribute (baseViewAttr, "2");
+		for (auto i = 0; i < 3; ++i)
+		{
+			auto v = owned (factory->createView (a, nullptr));
+			auto view = v.cast<View> ();
+			EXPECT(view);
+			EXPECT(view->value == 3);
+			EXPECT(view->baseState == BaseView::State::kState2);
+		}
+	);
+
+	TEST(creationPlanIsStoredOnAttributes,
+		UIAttributes a;
+		a.setAttribute (UIViewCreator::kAttrClass, viewCreator.getViewName ());
+		a.setIntegerAttribute (viewAttr, 3);
+		auto v = owned (factory->createView (a, nullptr));
+		EXPECT(a.getDerivedData () != nullptr);
+		a.setIntegerAttribute (viewAttr, 4);
+		EXPECT(a.getDerivedData () == nullptr);
+		v = owned (factory->createView (a, nullptr));
+		EXPECT(v.cast<View> ()->value == 4);
+		EXPECT(a.getDerivedData () != nullptr);
+	);
+
+	TEST(createViewAfterVariableChanged,
+		VariableDescription description;
+		description.variableValue = "4";
+		UIAttributes a;
+		a.setAttribute (UIViewCreator::kAttrClass, viewCreator.getViewName ());
+		a.setAttribute (viewAttr, "var");
+		auto v = owned (factory->createView (a, &description));
+		EXPECT(v.cast<View> ()->value == 4);
+		description.variableValue = "5";
+		++description.revision;
+		v = owned (factory->createView (a, &description));
+		EXPECT(v.cast<View> ()->value == 5);
+	);
+
 	TEST(getAttributeValue,
 		auto v = createView (factory);
 		std::string value;
@@ -93,6 +93,24 @@ TESTCASE(XMLParserTest,
 		EXPECT(p.parse (&provider, &handler) == false);
 	);
 
+	TEST(validParseFromStream,
+		CMemoryStream stream (reinterpret_cast<const int8_t*> (validXML), static_cast<uint32_t> (strlen (validXML)));
+		InputStreamContentProvider provider (stream);
+		uint32_t size;
+		EXPECT(provider.getContent (size) == nullptr);
+		Handler handler;
+		Parser p;
+		EXPECT(p.parse (&provider, &handler) == true);
+	);
+
+	TEST(invalidParseFromStream,
+		CMemoryStream stream (reinterpret_cast<const int8_t*> (invalidXML), static_cast<uint32_t> (strlen (invalidXML)));
+		InputStreamContentProvider provider (stream);
+		Handler handler;
+		Parser p;
+		EXPECT(p.parse (&provider, &handler) == false);
+	);
+
 );
 
 } // VSTGUI
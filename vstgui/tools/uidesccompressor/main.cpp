@@ -42,6 +42,7 @@ int main (int argv, char* argc[])
 	std::string inputPath;
 	std::string outputPath;
 	bool noCompression = false;
+	bool binary = false;
 	uint32_t compressionLevel = 1;
 	for (auto i = 0; i < argv; ++i)
 	{
@@ -68,13 +69,17 @@ int main (int argv, char* argc[])
 		{
 			noCompression = true;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
 	}
 	if (inputPath.empty () || outputPath.empty ())
 	{
 		printAndTerminate ("No input or output path specified!");
 	}
-	printf ("Copy %s to %s%s\n", inputPath.data (), outputPath.data (),
-			noCompression ? " [uncompressed]" : "[compressed]");
+	printf ("Copy %s to %s%s%s\n", inputPath.data (), outputPath.data (),
+			noCompression ? " [uncompressed]" : "[compressed]", binary ? "[binary]" : "");
 
 	CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
 	if (!uiDesc.parse ())
@@ -82,9 +87,11 @@ int main (int argv, char* argc[])
 		printAndTerminate ("Parsing failed!");
 	}
 	int32_t flags = UIDescription::kWriteImagesIntoUIDescFile;
+	if (binary)
+		flags |= UIDescription::kWriteAsBinary;
 	if (noCompression)
 	{
-		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false)
+		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false && !binary)
 			return 0;
 
 		if (!uiDesc.UIDescription::save (outputPath.data (), flags))
@@ -94,7 +101,7 @@ int main (int argv, char* argc[])
 	}
 	else
 	{
-		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == true)
+		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == true && !binary)
 			return 0;
 
 		flags |= CompressedUIDescription::kNoPlainUIDescFileBackup |
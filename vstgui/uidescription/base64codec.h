@@ -5,6 +5,20 @@
 #pragma once
 
 #include "../lib/malloc.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef VSTGUI_BASE64_SSSE3
+#if defined(__SSSE3__) || defined(__AVX__)
+#define VSTGUI_BASE64_SSSE3 1
+#else
+#define VSTGUI_BASE64_SSSE3 0
+#endif
+#endif
+
+#if VSTGUI_BASE64_SSSE3
+#include <tmmintrin.h>
+#endif
 
 namespace VSTGUI {
 
@@ -29,36 +43,16 @@ public:
 	{
 		static_assert (sizeof (T) == 1, "T must be one byte type");
 		Result r;
-		r.data.allocate ((inBufferSize * 3 / 4) + 3);
-		uint8_t input1[4];
-		uint8_t input2[4];
-		auto input1Ptr = reinterpret_cast<uint32_t*>(&input1[0]);
-		auto input2Ptr = reinterpret_cast<uint32_t*>(&input2[0]);
-		auto buffer32Ptr = reinterpret_cast<const uint32_t*> (inBuffer);
-		while (inBufferSize > 8)
-		{
-			*input1Ptr = *buffer32Ptr++;
-			*input2Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
-			r.dataSize += decodeblock<false> (input2, r.data.get () + r.dataSize);
-			inBufferSize -= 8;
-		}
-		while (inBufferSize > 4)
-		{
-			*input1Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
-			inBufferSize -= 4;
-		}
-		if (inBufferSize > 0)
-		{
-			input1[0] = input1[1] = input1[2] = input1[3] = '=';
-			auto ptr = reinterpret_cast<const uint8_t*>(buffer32Ptr);
-			for (uint32_t j = 0; j < inBufferSize; j++)
-			{
-				input1[j] = *ptr++;
-			}
-			r.dataSize += decodeblock<true> (input1, r.data.get () + r.dataSize);
-		}
+		r.data.allocate ((inBufferSize / 4) * 3 + 3);
+		if (inBufferSize == 0)
+			return r;
+		auto input = reinterpret_cast<const uint8_t*> (inBuffer);
+		// the last group may be incomplete or padded
+		auto numGroups = (inBufferSize - 1) / 4;
+		decodeGroups (input, numGroups, r.data.get ());
+		r.dataSize = static_cast<uint32_t> (numGroups * 3);
+		r.dataSize += decodeFinalGroup (input + numGroups * 4, inBufferSize - numGroups * 4,
+		                                r.data.get () + r.dataSize);
 		return r;
 	}
 
@@ -67,60 +61,221 @@ public:
 		Result r;
 		r.data.allocate ((binaryDataSize * 4) / 3 + 4);
 		auto ptr = reinterpret_cast<const uint8_t*> (binaryData);
-		uint8_t input[3];
-		uint32_t i;
-		for (i = 0; i < (binaryDataSize - 3); i += 3)
+		auto numGroups = binaryDataSize / 3;
+		encodeGroups (ptr, numGroups, r.data.get ());
+		r.dataSize = static_cast<uint32_t> (numGroups * 4);
+		if (auto remaining = static_cast<uint32_t> (binaryDataSize - numGroups * 3))
 		{
-			input[0] = *ptr++;
-			input[1] = *ptr++;
-			input[2] = *ptr++;
-			encodeblock (input, r.data.get () + r.dataSize, 3);
+			uint8_t input[3] = {};
+			std::copy_n (ptr + numGroups * 3, remaining, input);
+			encodeblock (input, r.data.get () + r.dataSize, remaining);
 			r.dataSize += 4;
 		}
-		if (i < binaryDataSize)
+		return r;
+	}
+
+	//-----------------------------------------------------------------------------
+	/** decodes base64 text piece by piece into buffers of the caller, so that the decoded data
+	 *	can be consumed without decoding all of it into memory first. The text must be valid for
+	 *	the lifetime of the decoder. */
+	class Decoder
+	{
+	public:
+		template<typename T>
+		explicit Decoder (const T& base64String)
+		: Decoder (base64String.data (), base64String.size ())
+		{
+		}
+
+		template<typename T>
+		Decoder (const T* inBuffer, size_t inBufferSize)
+		: input (reinterpret_cast<const uint8_t*> (inBuffer)), remaining (inBufferSize)
+		{
+			static_assert (sizeof (T) == 1, "T must be one byte type");
+		}
+
+		/** decode the next bytes into buffer
+		 *	@return number of bytes written to buffer, 0 if all data was read
+		 */
+		size_t read (uint8_t* buffer, size_t bufferSize)
 		{
-			input[0] = input[1] = input[2] = 0;
-			uint32_t j;
-			for (j = 0; i < binaryDataSize; i++, j++)
+			size_t numBytes = 0;
+			while (numBytes < bufferSize)
 			{
-				input[j] = *ptr++;
+				if (pendingPos < pendingSize)
+				{
+					auto n = std::min<size_t> (pendingSize - pendingPos, bufferSize - numBytes);
+					std::copy_n (pending + pendingPos, n, buffer + numBytes);
+					pendingPos += static_cast<uint32_t> (n);
+					numBytes += n;
+					continue;
+				}
+				if (remaining == 0)
+					break;
+				pendingPos = pendingSize = 0;
+				if (remaining > 4)
+				{
+					auto numGroups = std::min ((remaining - 1) / 4, (bufferSize - numBytes) / 3);
+					if (numGroups)
+					{
+						decodeGroups (input, numGroups, buffer + numBytes);
+						numBytes += numGroups * 3;
+						input += numGroups * 4;
+						remaining -= numGroups * 4;
+						continue;
+					}
+					// less than 3 bytes left in buffer
+					decodeGroup (input, pending);
+					pendingSize = 3;
+					input += 4;
+					remaining -= 4;
+				}
+				else
+				{
+					pendingSize = decodeFinalGroup (input, remaining, pending);
+					input += remaining;
+					remaining = 0;
+				}
 			}
-			encodeblock (input, r.data.get () + r.dataSize, j);
-			r.dataSize += 4;
+			return numBytes;
 		}
-		return r;
-	}
+
+	private:
+		const uint8_t* input;
+		size_t remaining;
+		uint8_t pending[3];
+		uint32_t pendingSize {0};
+		uint32_t pendingPos {0};
+	};
 
 private:
-	template<bool finalBlock = true>
-	static inline uint32_t decodeblock (uint8_t input[4], uint8_t output[3])
+	struct DecodeTable
 	{
-		static constexpr uint8_t cd64[] = {
-			62,   0xFF, 0xFF, 0xFF, 63,   52,   53, 54, 55, 56, 57, 58, 59, 60, 61, 0xFF,
-			0xFF, 0xFF, 0,	0xFF, 0xFF, 0xFF, 0,  1,  2,  3,  4,  5,  6,  7,  8,  9,
-			10,   11,   12,   13,   14,   15,   16, 17, 18, 19, 20, 21, 22, 23, 24, 25,
-			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
-			36,   37,   38,   39,   40,   41,   42, 43, 44, 45, 46, 47, 48, 49, 50, 51};
+		constexpr DecodeTable () : values ()
+		{
+			constexpr char alphabet[] =
+			    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (auto i = 0u; i < 256u; ++i)
+				values[i] = 0xFF;
+			for (auto i = 0u; i < 64u; ++i)
+				values[static_cast<uint8_t> (alphabet[i])] = static_cast<uint8_t> (i);
+			values[static_cast<uint8_t> ('=')] = 0;
+		}
+		uint8_t values[256];
+	};
+
+	static inline void decodeGroup (const uint8_t input[4], uint8_t output[3])
+	{
+		static constexpr DecodeTable table;
+		auto value = (static_cast<uint32_t> (table.values[input[0]]) << 18) |
+		             (static_cast<uint32_t> (table.values[input[1]]) << 12) |
+		             (static_cast<uint32_t> (table.values[input[2]]) << 6) |
+		             static_cast<uint32_t> (table.values[input[3]]);
+		output[0] = static_cast<uint8_t> (value >> 16);
+		output[1] = static_cast<uint8_t> (value >> 8);
+		output[2] = static_cast<uint8_t> (value);
+	}
 
+	/** decodes the last 1 to 4 characters, missing characters are treated as padding */
+	static inline uint32_t decodeFinalGroup (const uint8_t* input, size_t inputSize,
+	                                         uint8_t output[3])
+	{
+		uint8_t group[4] = {'=', '=', '=', '='};
+		std::copy_n (input, inputSize, group);
 		uint32_t result = 3;
-		if (finalBlock)
+		if (group[2] == '=')
+			result = 1;
+		else if (group[3] == '=')
+			result = 2;
+		uint8_t decoded[3];
+		decodeGroup (group, decoded);
+		std::copy_n (decoded, result, output);
+		return result;
+	}
+
+	/** decodes numGroups groups of 4 characters into numGroups * 3 bytes */
+	static inline void decodeGroups (const uint8_t* input, size_t numGroups, uint8_t* output)
+	{
+#if VSTGUI_BASE64_SSSE3
+		// 16 bytes are stored for every 16 characters, of which the last 4 are overwritten by the
+		// next groups, so at least two more groups have to follow
+		for (; numGroups >= 6; numGroups -= 4, input += 16, output += 12)
 		{
-			if (input[2] == '=')
-				result = 1;
-			else if (input[3] == '=')
-				result = 2;
+			if (!decodeVector (input, output))
+				break;
 		}
-		input[0] = cd64[input[0] - 43];
-		input[1] = cd64[input[1] - 43];
-		input[2] = cd64[input[2] - 43];
-		input[3] = cd64[input[3] - 43];
-		output[0] = static_cast<uint8_t> ((input[0] << 2) | ((input[1] & 0x30) >> 4));
-		output[1] = static_cast<uint8_t> (((input[1] & 0xF) << 4) | ((input[2] & 0x3C) >> 2));
-		output[2] = static_cast<uint8_t> (((input[2] & 0x03) << 6) | input[3]);
-		return result;
+#endif
+		for (; numGroups > 0; --numGroups, input += 4, output += 3)
+			decodeGroup (input, output);
+	}
+
+	/** encodes numGroups groups of 3 bytes into numGroups * 4 characters */
+	static inline void encodeGroups (const uint8_t* input, size_t numGroups, uint8_t* output)
+	{
+#if VSTGUI_BASE64_SSSE3
+		// 16 bytes are loaded for every 12 bytes encoded
+		for (; numGroups >= 6; numGroups -= 4, input += 12, output += 16)
+			encodeVector (input, output);
+#endif
+		for (; numGroups > 0; --numGroups, input += 3, output += 4)
+			encodeblock (input, output, 3);
+	}
+
+#if VSTGUI_BASE64_SSSE3
+	/** decodes 16 characters into 12 bytes and stores 16 bytes, returns false without storing
+	 *	anything if one of the characters is not part of the base64 alphabet
+	 *	(see Wojciech Muła, Daniel Lemire: Faster Base64 Encoding and Decoding using AVX2
+	 *	Instructions) */
+	static inline bool decodeVector (const uint8_t* input, uint8_t* output)
+	{
+		const __m128i lutLo = _mm_setr_epi8 (0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		                                     0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i lutHi = _mm_setr_epi8 (0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+		                                     0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i lutRoll =
+		    _mm_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i mask2F = _mm_set1_epi8 (0x2F);
+
+		auto str = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input));
+		auto hiNibbles = _mm_and_si128 (_mm_srli_epi32 (str, 4), mask2F);
+		auto loNibbles = _mm_and_si128 (str, mask2F);
+		auto hi = _mm_shuffle_epi8 (lutHi, hiNibbles);
+		auto lo = _mm_shuffle_epi8 (lutLo, loNibbles);
+		if (_mm_movemask_epi8 (_mm_cmpgt_epi8 (_mm_and_si128 (lo, hi), _mm_setzero_si128 ())))
+			return false;
+		auto eq2F = _mm_cmpeq_epi8 (str, mask2F);
+		auto roll = _mm_shuffle_epi8 (lutRoll, _mm_add_epi8 (eq2F, hiNibbles));
+		str = _mm_add_epi8 (str, roll);
+
+		auto mergedAB = _mm_maddubs_epi16 (str, _mm_set1_epi32 (0x01400140));
+		auto merged = _mm_madd_epi16 (mergedAB, _mm_set1_epi32 (0x00011000));
+		merged = _mm_shuffle_epi8 (
+		    merged, _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output), merged);
+		return true;
+	}
+
+	/** encodes 12 bytes into 16 characters, loads 16 bytes */
+	static inline void encodeVector (const uint8_t* input, uint8_t* output)
+	{
+		auto in = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input));
+		in = _mm_shuffle_epi8 (in, _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		auto t0 = _mm_and_si128 (in, _mm_set1_epi32 (0x0FC0FC00));
+		auto t1 = _mm_mulhi_epu16 (t0, _mm_set1_epi32 (0x04000040));
+		auto t2 = _mm_and_si128 (in, _mm_set1_epi32 (0x003F03F0));
+		auto t3 = _mm_mullo_epi16 (t2, _mm_set1_epi32 (0x01000010));
+		auto indices = _mm_or_si128 (t1, t3);
+
+		const __m128i lut =
+		    _mm_setr_epi8 (65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+		auto offsets = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+		offsets = _mm_sub_epi8 (offsets, _mm_cmpgt_epi8 (indices, _mm_set1_epi8 (25)));
+		auto result = _mm_add_epi8 (indices, _mm_shuffle_epi8 (lut, offsets));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output), result);
 	}
+#endif
 
-	static inline void encodeblock (uint8_t input[3], uint8_t output[4], uint32_t len)
+	static inline void encodeblock (const uint8_t input[3], uint8_t output[4], uint32_t len)
 	{
 		static constexpr uint8_t cb64[] =
 			"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -116,7 +116,7 @@ int64_t CMemoryStream::seek (int64_t seekpos, SeekMode mode)
 			newPos = size - seekpos;
 			break;
 	}
-	if (newPos <= size && newPos > 0)
+	if (newPos <= size && newPos >= 0)
 	{
 		pos = static_cast<uint32_t> (newPos);
 		return pos;
@@ -358,6 +358,23 @@ bool CResourceInputStream::open (const CResourceDescription& res)
 	return platformStream != nullptr;
 }
 
+//-----------------------------------------------------------------------------
+const uint8_t* CResourceInputStream::getMemory (uint64_t& size) const
+{
+	if (platformStream)
+		return platformStream->getMemory (size);
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<const void> CResourceInputStream::getMemoryOwner () const
+{
+	uint64_t size;
+	if (getMemory (size))
+		return platformStream;
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 uint32_t CResourceInputStream::readRaw (void* buffer, uint32_t size)
 {
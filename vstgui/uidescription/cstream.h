@@ -220,6 +220,13 @@ public:
 
 	bool open (const CResourceDescription& res);
 
+	/** the whole content of the resource if the platform provides it in memory (i.e. as a memory
+	 *	mapped file), nullptr otherwise */
+	const uint8_t* getMemory (uint64_t& size) const;
+	/** keeps the memory returned by getMemory valid after this stream is destroyed, nullptr if
+	 *	the platform does not provide the content in memory */
+	std::shared_ptr<const void> getMemoryOwner () const;
+
 	bool operator>> (std::string& string) override { return false; }
 	uint32_t readRaw (void* buffer, uint32_t size) override;
 	int64_t seek (int64_t pos, SeekMode mode) override;
@@ -228,7 +235,7 @@ public:
 
 	using InputStream::operator>>;
 protected:
-	PlatformResourceInputStreamPtr platformStream;
+	std::shared_ptr<IPlatformResourceInputStream> platformStream;
 };
 
 //------------------------------------------------------------------------
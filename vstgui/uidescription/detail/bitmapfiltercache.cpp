@@ -0,0 +1,226 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "bitmapfiltercache.h"
+#include "../cstream.h"
+#include "../../lib/cbitmap.h"
+#include "../../lib/platform/iplatformbitmap.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+namespace BitmapFilterCache {
+namespace {
+
+//------------------------------------------------------------------------
+constexpr uint32_t kMagic = 'VBFC';
+constexpr uint32_t kVersion = 2;
+constexpr uint64_t kHashOffset = 0xcbf29ce484222325ull;
+constexpr uint64_t kHashPrime = 0x100000001b3ull;
+
+//------------------------------------------------------------------------
+struct Header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint32_t width;
+	uint32_t height;
+	double scaleFactor;
+	uint32_t pixelFormat;
+	uint32_t reserved;
+};
+
+//------------------------------------------------------------------------
+/** FNV-1a over 64 bit words */
+inline uint64_t hash (uint64_t h, const void* data, size_t size)
+{
+	auto bytes = static_cast<const uint8_t*> (data);
+	for (; size >= sizeof (uint64_t); size -= sizeof (uint64_t), bytes += sizeof (uint64_t))
+	{
+		uint64_t word;
+		memcpy (&word, bytes, sizeof (word));
+		h ^= word;
+		h *= kHashPrime;
+	}
+	for (; size > 0; --size, ++bytes)
+	{
+		h ^= *bytes;
+		h *= kHashPrime;
+	}
+	return h;
+}
+
+//------------------------------------------------------------------------
+std::string makeFilePath (const std::string& path, uint64_t slot)
+{
+	static constexpr auto hexChars = "0123456789abcdef";
+	std::string result (path);
+	if (!result.empty () && result.back () != '/' && result.back () != '\\')
+		result += '/';
+	for (auto shift = 60; shift >= 0; shift -= 4)
+		result += hexChars[(slot >> shift) & 0xf];
+	result += ".bfc";
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** a file name next to the entry which no other writer uses, also not one in another process */
+std::string makeTemporaryFilePath (const std::string& filePath)
+{
+	static std::atomic<uint32_t> counter {0};
+	auto time = std::chrono::steady_clock::now ().time_since_epoch ().count ();
+	uint64_t unique = hash (kHashOffset, &time, sizeof (time));
+	auto count = ++counter;
+	unique = hash (unique, &count, sizeof (count));
+	// the time and a stack address make it differ between processes
+	auto address = reinterpret_cast<uintptr_t> (&count);
+	unique = hash (unique, &address, sizeof (address));
+	return filePath + "." + std::to_string (unique) + ".tmp";
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+bool hashContent (const CResourceDescription& resource, uint64_t& contentHash)
+{
+	CResourceInputStream stream;
+	if (!stream.open (resource))
+		return false;
+	uint64_t size = 0;
+	if (auto memory = stream.getMemory (size))
+	{
+		auto h = hash (kHashOffset, memory, static_cast<size_t> (size));
+		contentHash = hash (h, &size, sizeof (size));
+		return true;
+	}
+	uint64_t h = kHashOffset;
+	std::vector<uint8_t> buffer (64 * 1024);
+	uint32_t numBytes;
+	while ((numBytes = stream.readRaw (buffer.data (), static_cast<uint32_t> (buffer.size ()))) > 0 &&
+	       numBytes != kStreamIOError)
+	{
+		h = hash (h, buffer.data (), numBytes);
+		size += numBytes;
+	}
+	if (numBytes == kStreamIOError)
+		return false;
+	contentHash = hash (h, &size, sizeof (size));
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool makeKey (const Source& source, const std::string& filterDescription, CBitmap* sourceBitmap,
+              Key& key)
+{
+	auto platformBitmap = sourceBitmap ? sourceBitmap->getPlatformBitmap () : nullptr;
+	if (!platformBitmap)
+		return false;
+	auto width = static_cast<uint32_t> (platformBitmap->getSize ().x);
+	auto height = static_cast<uint32_t> (platformBitmap->getSize ().y);
+	auto scaleFactor = platformBitmap->getScaleFactor ();
+	uint64_t h = hash (kHashOffset, source.bitmapName.data (), source.bitmapName.size ());
+	// the separator keeps "ab" + "c" and "a" + "bc" apart
+	h = hash (h, "", 1);
+	h = hash (h, source.path.data (), source.path.size ());
+	h = hash (h, &scaleFactor, sizeof (scaleFactor));
+	key.slot = h;
+	h = hash (h, &width, sizeof (width));
+	h = hash (h, &height, sizeof (height));
+	h = hash (h, &source.revision, sizeof (source.revision));
+	h = hash (h, &source.contentHash, sizeof (source.contentHash));
+	key.value = hash (h, filterDescription.data (), filterDescription.size ());
+	return true;
+}
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr load (const std::string& path, const Key& key)
+{
+	CFileStream stream;
+	if (!stream.open (makeFilePath (path, key.slot).data (), CFileStream::kReadMode | CFileStream::kBinaryMode))
+		return nullptr;
+	Header header;
+	if (stream.readRaw (&header, sizeof (header)) != sizeof (header))
+		return nullptr;
+	if (header.magic != kMagic || header.version != kVersion || header.key != key.value ||
+	    header.width == 0 || header.height == 0 || header.scaleFactor <= 0.)
+		return nullptr;
+	CPoint size (header.width / header.scaleFactor, header.height / header.scaleFactor);
+	auto bitmap = makeOwned<CBitmap> (size, header.scaleFactor);
+	auto platformBitmap = bitmap->getPlatformBitmap ();
+	if (!platformBitmap || static_cast<uint32_t> (platformBitmap->getSize ().x) != header.width ||
+	    static_cast<uint32_t> (platformBitmap->getSize ().y) != header.height)
+		return nullptr;
+	{
+		auto pixelAccess = platformBitmap->lockPixels (false);
+		if (!pixelAccess || static_cast<uint32_t> (pixelAccess->getPixelFormat ()) != header.pixelFormat)
+			return nullptr;
+		auto address = pixelAccess->getAddress ();
+		for (auto y = 0u; y < header.height; ++y)
+		{
+			auto rowSize = header.width * 4;
+			if (stream.readRaw (address + y * pixelAccess->getBytesPerRow (), rowSize) != rowSize)
+				return nullptr;
+		}
+	}
+	return platformBitmap;
+}
+
+//------------------------------------------------------------------------
+bool store (const std::string& path, const Key& key, CBitmap* result)
+{
+	auto platformBitmap = result ? result->getPlatformBitmap () : nullptr;
+	if (!platformBitmap)
+		return false;
+	auto pixelAccess = platformBitmap->lockPixels (false);
+	if (!pixelAccess)
+		return false;
+	Header header;
+	memset (&header, 0, sizeof (header));
+	header.magic = kMagic;
+	header.version = kVersion;
+	header.key = key.value;
+	header.width = static_cast<uint32_t> (platformBitmap->getSize ().x);
+	header.height = static_cast<uint32_t> (platformBitmap->getSize ().y);
+	header.scaleFactor = platformBitmap->getScaleFactor ();
+	header.pixelFormat = static_cast<uint32_t> (pixelAccess->getPixelFormat ());
+	auto filePath = makeFilePath (path, key.slot);
+	auto temporaryFilePath = makeTemporaryFilePath (filePath);
+	bool success;
+	{
+		CFileStream stream;
+		if (!stream.open (temporaryFilePath.data (), CFileStream::kWriteMode |
+		                                                 CFileStream::kTruncateMode |
+		                                                 CFileStream::kBinaryMode))
+			return false;
+		success = stream.writeRaw (&header, sizeof (header)) == sizeof (header);
+		auto address = pixelAccess->getAddress ();
+		for (auto y = 0u; success && y < header.height; ++y)
+		{
+			auto rowSize = header.width * 4;
+			success =
+			    stream.writeRaw (address + y * pixelAccess->getBytesPerRow (), rowSize) == rowSize;
+		}
+	}
+	if (success && std::rename (temporaryFilePath.data (), filePath.data ()) != 0)
+	{
+		// rename does not replace an existing file on Windows
+		std::remove (filePath.data ());
+		success = std::rename (temporaryFilePath.data (), filePath.data ()) == 0;
+	}
+	if (!success)
+		std::remove (temporaryFilePath.data ());
+	return success;
+}
+
+//------------------------------------------------------------------------
+} // BitmapFilterCache
+} // Detail
+} // VSTGUI
@@ -0,0 +1,75 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../lib/vstguifwd.h"
+#include <string>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** Disk cache for the results of bitmap filters
+ *
+ *	A result is stored as raw pixels in one file per bitmap, so the cache never holds more than
+ *	one filtered copy of each bitmap. The file is replaced when the filter settings, the size of
+ *	the source, the encoded source image or the revision of the sources change.
+ *
+ *	The decoded source pixels are not read to build the key, the source is identified by its
+ *	path, a hash of its encoded image file and the revision the application passes.
+ */
+namespace BitmapFilterCache {
+
+//------------------------------------------------------------------------
+struct Key
+{
+	/** identifies the bitmap and names the file of the entry */
+	uint64_t slot {0};
+	/** identifies the filter settings and the content and revision of the source */
+	uint64_t value {0};
+};
+
+//------------------------------------------------------------------------
+struct Source
+{
+	/** the name of the bitmap, bitmaps filtering the same source image use different entries */
+	std::string bitmapName;
+	/** the path of the source image */
+	std::string path;
+	/** the revision the application passes */
+	uint64_t revision {0};
+	/** see hashContent, zero if the source image can not be read */
+	uint64_t contentHash {0};
+};
+
+//------------------------------------------------------------------------
+/** hash the encoded content of a source image
+ *	@return false if the resource can not be read
+ */
+bool hashContent (const CResourceDescription& resource, uint64_t& contentHash);
+
+//------------------------------------------------------------------------
+/** compute the key for the filter description and source bitmap
+ *	@return false if the source bitmap has no platform bitmap
+ */
+bool makeKey (const Source& source, const std::string& filterDescription, CBitmap* sourceBitmap,
+              Key& key);
+
+//------------------------------------------------------------------------
+/** load a cached result
+ *	@return the platform bitmap or nullptr if there is no valid entry for the key
+ */
+PlatformBitmapPtr load (const std::string& path, const Key& key);
+
+//------------------------------------------------------------------------
+/** store a result. The entry is written to a temporary file first and then renamed, so that a
+ *	reader never sees a partially written entry. */
+bool store (const std::string& path, const Key& key, CBitmap* result);
+
+//------------------------------------------------------------------------
+} // BitmapFilterCache
+} // Detail
+} // VSTGUI
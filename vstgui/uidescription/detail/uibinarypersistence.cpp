@@ -0,0 +1,632 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibinarypersistence.h"
+#include "../uiattributes.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+namespace UIBinaryDesc {
+
+//------------------------------------------------------------------------
+enum class NodeKind : uint32_t
+{
+	Generic,
+	Bitmap,
+	Font,
+	Color,
+	ControlTag,
+	Gradient,
+	Variable,
+	Comment,
+};
+
+//------------------------------------------------------------------------
+enum NodeFlags : uint32_t
+{
+	kFastChildLookup = 1 << 0,
+};
+
+static constexpr uint32_t kNodeHeaderSize = 6 * sizeof (uint32_t);
+static constexpr uint32_t kStringEntrySize = 2 * sizeof (uint32_t);
+static constexpr uint32_t kTemplateEntrySize = 2 * sizeof (uint32_t);
+static constexpr uint32_t kMaxNodeDepth = 256;
+
+//------------------------------------------------------------------------
+inline uint32_t load32 (const uint8_t* ptr)
+{
+	return static_cast<uint32_t> (ptr[0]) | (static_cast<uint32_t> (ptr[1]) << 8) |
+	       (static_cast<uint32_t> (ptr[2]) << 16) | (static_cast<uint32_t> (ptr[3]) << 24);
+}
+
+//------------------------------------------------------------------------
+inline void store32 (uint8_t* ptr, uint32_t value)
+{
+	ptr[0] = static_cast<uint8_t> (value);
+	ptr[1] = static_cast<uint8_t> (value >> 8);
+	ptr[2] = static_cast<uint8_t> (value >> 16);
+	ptr[3] = static_cast<uint8_t> (value >> 24);
+}
+
+//------------------------------------------------------------------------
+bool hasMagic (const void* data, size_t size)
+{
+	return size >= sizeof (kMagic) && load32 (static_cast<const uint8_t*> (data)) == kMagic;
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDesc
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescReader {
+
+using namespace UIBinaryDesc;
+
+//------------------------------------------------------------------------
+struct Reader
+{
+	Reader (const uint8_t* data, size_t size) : data (data), size (size) {}
+
+	bool init ()
+	{
+		uint32_t magic;
+		uint32_t version;
+		if (!load (0, magic) || magic != kMagic || !load (4, version) || version != kVersion)
+			return false;
+		if (!load (8, numStrings) || !load (12, stringTable) || !load (16, rootNodeOffset))
+			return false;
+		return numStrings > 0 && isInside (stringTable, numStrings * uint64_t (kStringEntrySize));
+	}
+
+	/** the node offsets of the template table, sorted */
+	bool getTemplateOffsets (std::vector<uint32_t>& offsets) const
+	{
+		uint32_t numTemplates;
+		uint32_t templateTable;
+		if (!load (20, numTemplates) || !load (24, templateTable) ||
+		    !isInside (templateTable, numTemplates * uint64_t (kTemplateEntrySize)))
+			return false;
+		offsets.resize (numTemplates);
+		for (auto i = 0u; i < numTemplates; ++i)
+			offsets[i] = load32 (data + templateTable + i * kTemplateEntrySize + sizeof (uint32_t));
+		std::sort (offsets.begin (), offsets.end ());
+		return true;
+	}
+
+	bool isInside (uint64_t offset, uint64_t length) const
+	{
+		return offset <= size && length <= size - offset;
+	}
+
+	bool load (uint64_t offset, uint32_t& value) const
+	{
+		if (!isInside (offset, sizeof (uint32_t)))
+			return false;
+		value = load32 (data + offset);
+		return true;
+	}
+
+	bool getString (uint32_t index, const uint8_t*& str, uint32_t& length) const
+	{
+		if (index >= numStrings)
+			return false;
+		auto entry = data + stringTable + index * uint64_t (kStringEntrySize);
+		auto offset = load32 (entry);
+		length = load32 (entry + sizeof (uint32_t));
+		if (!isInside (offset, length))
+			return false;
+		str = data + offset;
+		return true;
+	}
+
+	bool getString (uint32_t index, std::string& str) const
+	{
+		const uint8_t* ptr;
+		uint32_t length;
+		if (!getString (index, ptr, length))
+			return false;
+		str.assign (reinterpret_cast<const char*> (ptr), length);
+		return true;
+	}
+
+	/** reads the node header and checks that the attributes and the child offsets are inside */
+	bool readHeader (uint32_t offset, uint32_t depth, uint32_t (&header)[kNodeHeaderSize / 4],
+	                 uint64_t& childrenOffset) const
+	{
+		if (depth > kMaxNodeDepth || !isInside (offset, kNodeHeaderSize))
+			return false;
+		for (auto i = 0u; i < kNodeHeaderSize / sizeof (uint32_t); ++i)
+			header[i] = load32 (data + offset + i * sizeof (uint32_t));
+		auto attributesOffset = uint64_t (offset) + kNodeHeaderSize;
+		childrenOffset = attributesOffset + header[4] * uint64_t (kStringEntrySize);
+		return isInside (attributesOffset, childrenOffset - attributesOffset +
+		                                       header[5] * uint64_t (sizeof (uint32_t)));
+	}
+
+	static UINode* createNode (uint32_t kind, const std::string& name,
+	                           const SharedPointer<UIAttributes>& attributes, uint32_t flags)
+	{
+		switch (static_cast<NodeKind> (kind))
+		{
+			case NodeKind::Generic:
+				return new UINode (name, attributes, (flags & kFastChildLookup) != 0);
+			case NodeKind::Bitmap:
+				return new UIBitmapNode (name, attributes);
+			case NodeKind::Font:
+				return new UIFontNode (name, attributes);
+			case NodeKind::Color:
+				return new UIColorNode (name, attributes);
+			case NodeKind::ControlTag:
+				return new UIControlTagNode (name, attributes);
+			case NodeKind::Gradient:
+				return new UIGradientNode (name, attributes);
+			case NodeKind::Variable:
+				return new UIVariableNode (name, attributes);
+			case NodeKind::Comment:
+				return new UICommentNode ({});
+		}
+		return nullptr;
+	}
+
+	UINode* readNode (uint32_t offset, uint32_t depth) const
+	{
+		uint32_t header[kNodeHeaderSize / sizeof (uint32_t)];
+		uint64_t childrenOffset;
+		if (!readHeader (offset, depth, header, childrenOffset))
+			return nullptr;
+		auto numAttributes = header[4];
+		auto numChildren = header[5];
+
+		std::string name;
+		if (!getString (header[2], name))
+			return nullptr;
+		auto attributes = makeOwned<UIAttributes> (numAttributes);
+		for (auto i = 0u; i < numAttributes; ++i)
+		{
+			auto entry = data + offset + kNodeHeaderSize + i * uint64_t (kStringEntrySize);
+			std::string key;
+			std::string value;
+			if (!getString (load32 (entry), key) ||
+			    !getString (load32 (entry + sizeof (uint32_t)), value))
+				return nullptr;
+			attributes->setAttribute (std::move (key), std::move (value));
+		}
+		UINode* node = nullptr;
+		auto lazy = isLazyTemplate (header[0], offset, depth);
+		if (lazy)
+		{
+			auto loader = makeLazyLoader (offset, depth);
+			if (!loader)
+				return nullptr;
+			node = new UILazyNode (name, attributes, (header[1] & kFastChildLookup) != 0,
+			                       std::move (loader));
+		}
+		else if (!(node = createNode (header[0], name, attributes, header[1])))
+			return nullptr;
+		if (header[3] != 0)
+		{
+			std::string nodeData;
+			if (!getString (header[3], nodeData))
+			{
+				node->forget ();
+				return nullptr;
+			}
+			node->setData (std::move (nodeData));
+		}
+		if (!lazy &&
+		    !readChildren (node->getChildren (), offset, childrenOffset, numChildren, depth))
+		{
+			node->forget ();
+			return nullptr;
+		}
+		return node;
+	}
+
+	bool readChildren (UIDescList& children, uint32_t offset, uint64_t childrenOffset,
+	                   uint32_t numChildren, uint32_t depth) const
+	{
+		for (auto i = 0u; i < numChildren; ++i)
+		{
+			// children are stored after their parent, which also rules out cycles
+			auto childOffset = load32 (data + childrenOffset + i * sizeof (uint32_t));
+			auto child = childOffset > offset ? readNode (childOffset, depth + 1) : nullptr;
+			if (!child)
+				return false;
+			children.add (child);
+		}
+		return true;
+	}
+
+	/** the children of the templates in the template table are read when they are accessed */
+	bool isLazyTemplate (uint32_t kind, uint32_t offset, uint32_t depth) const
+	{
+		return templateOffsets && depth == 1 &&
+		       kind == static_cast<uint32_t> (NodeKind::Generic) &&
+		       std::binary_search (templateOffsets->begin (), templateOffsets->end (), offset);
+	}
+
+	/** reads the children of the template at offset from the content if its owner can be kept
+	 *	alive, otherwise from a copy of the template */
+	UILazyNode::ChildrenCreator makeLazyLoader (uint32_t offset, uint32_t depth) const
+	{
+		auto reader = *this;
+		reader.templateOffsets = nullptr;
+		if (!contentOwner)
+		{
+			auto copy = std::make_shared<std::vector<uint8_t>> ();
+			if (!copyTemplate (offset, depth, *copy))
+				return {};
+			reader = Reader (copy->data (), copy->size ());
+			reader.contentOwner = copy;
+			if (!reader.load (0, reader.numStrings) || !reader.load (4, reader.stringTable))
+				return {};
+			offset = kTemplateCopyHeaderSize;
+		}
+		return [reader, offset, depth] (UIDescList& children) {
+			uint32_t header[kNodeHeaderSize / sizeof (uint32_t)];
+			uint64_t childrenOffset;
+			return reader.readHeader (offset, depth, header, childrenOffset) &&
+			       reader.readChildren (children, offset, childrenOffset, header[5], depth);
+		};
+	}
+
+	/** copies the template node at offset, its subtree and the strings they use.
+	 *
+	 *	The copy starts with the string count and the string table offset, followed by the nodes
+	 *	and the strings. The string indices and the child offsets are rewritten for the copy.
+	 */
+	bool copyTemplate (uint32_t offset, uint32_t depth, std::vector<uint8_t>& result) const
+	{
+		TemplateCopy copy {*this, result};
+		// the empty string keeps index 0, node data index 0 means no data
+		uint8_t emptyString[sizeof (uint32_t)] = {};
+		result.assign (kTemplateCopyHeaderSize, 0);
+		if (!copy.copyString (emptyString) || !copy.copyNode (offset, depth))
+			return false;
+		auto stringTable = result.size ();
+		auto stringData = stringTable + copy.strings.size () * kStringEntrySize;
+		auto totalSize = stringData;
+		for (const auto& str : copy.strings)
+			totalSize += str.second + 1;
+		if (totalSize > std::numeric_limits<uint32_t>::max ())
+			return false;
+		result.resize (totalSize);
+		store32 (result.data (), static_cast<uint32_t> (copy.strings.size ()));
+		store32 (result.data () + 4, static_cast<uint32_t> (stringTable));
+		for (auto i = 0u; i < copy.strings.size (); ++i)
+		{
+			const auto& str = copy.strings[i];
+			auto entry = result.data () + stringTable + i * kStringEntrySize;
+			store32 (entry, static_cast<uint32_t> (stringData));
+			store32 (entry + 4, str.second);
+			std::copy (str.first, str.first + str.second, result.data () + stringData);
+			stringData += str.second + 1;
+		}
+		return true;
+	}
+
+	static constexpr uint32_t kTemplateCopyHeaderSize = 2 * sizeof (uint32_t);
+
+	struct TemplateCopy
+	{
+		using String = std::pair<const uint8_t*, uint32_t>;
+
+		const Reader& source;
+		std::vector<uint8_t>& nodes;
+		std::vector<String> strings;
+		std::unordered_map<uint32_t, uint32_t> stringIndices;
+
+		/** replaces the string index of the content by the one of the copy */
+		bool copyString (uint8_t* field)
+		{
+			auto index = load32 (field);
+			auto it = stringIndices.find (index);
+			if (it == stringIndices.end ())
+			{
+				String str;
+				if (!source.getString (index, str.first, str.second))
+					return false;
+				it = stringIndices.emplace (index, static_cast<uint32_t> (strings.size ())).first;
+				strings.emplace_back (str);
+			}
+			store32 (field, it->second);
+			return true;
+		}
+
+		bool copyNode (uint32_t offset, uint32_t depth)
+		{
+			uint32_t header[kNodeHeaderSize / sizeof (uint32_t)];
+			uint64_t childrenOffset;
+			if (!source.readHeader (offset, depth, header, childrenOffset))
+				return false;
+			auto childrenStart = static_cast<size_t> (childrenOffset - offset);
+			auto nodeSize = childrenStart + header[5] * sizeof (uint32_t);
+			auto nodeOffset = nodes.size ();
+			if (nodeOffset + nodeSize > std::numeric_limits<uint32_t>::max ())
+				return false;
+			nodes.insert (nodes.end (), source.data + offset, source.data + offset + nodeSize);
+			// nodes is resized by the children, so the fields are addressed by their offset
+			auto field = [&] (size_t fieldOffset) { return nodes.data () + nodeOffset + fieldOffset; };
+			if (!copyString (field (8)) || !copyString (field (12)))
+				return false;
+			for (auto i = kNodeHeaderSize; i < childrenStart; i += sizeof (uint32_t))
+			{
+				if (!copyString (field (i)))
+					return false;
+			}
+			for (auto i = 0u; i < header[5]; ++i)
+			{
+				auto childField = childrenStart + i * sizeof (uint32_t);
+				auto childOffset = load32 (field (childField));
+				auto childCopyOffset = static_cast<uint32_t> (nodes.size ());
+				if (childOffset <= offset || !copyNode (childOffset, depth + 1))
+					return false;
+				store32 (field (childField), childCopyOffset);
+			}
+			return true;
+		}
+	};
+
+	const uint8_t* data;
+	size_t size;
+	/** keeps the content alive for lazy templates */
+	std::shared_ptr<const void> contentOwner;
+	/** the node offsets of the templates which are read lazily */
+	const std::vector<uint32_t>* templateOffsets {nullptr};
+	uint32_t numStrings {0};
+	uint32_t stringTable {0};
+	uint32_t rootNodeOffset {0};
+};
+
+//------------------------------------------------------------------------
+static SharedPointer<UINode> readContent (const uint8_t* data, size_t size, bool lazyTemplates,
+                                          std::shared_ptr<const void> contentOwner)
+{
+	Reader reader (data, size);
+	if (!reader.init ())
+		return nullptr;
+	std::vector<uint32_t> templateOffsets;
+	if (lazyTemplates && reader.getTemplateOffsets (templateOffsets))
+	{
+		reader.templateOffsets = &templateOffsets;
+		reader.contentOwner = std::move (contentOwner);
+	}
+	return owned (reader.readNode (reader.rootNodeOffset, 0));
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (IContentProvider& contentProvider, bool lazyTemplates)
+{
+	uint32_t contentSize = 0;
+	if (auto content = contentProvider.getContent (contentSize))
+	{
+		if (!hasMagic (content, contentSize))
+			return nullptr;
+		// lazy templates read from the content in place if its owner can be kept alive
+		return readContent (reinterpret_cast<const uint8_t*> (content), contentSize,
+		                    lazyTemplates,
+		                    lazyTemplates ? contentProvider.getContentOwner () : nullptr);
+	}
+
+	static constexpr uint32_t kChunkSize = 0x10000;
+	std::vector<uint8_t> buffer (sizeof (kMagic));
+	auto numBytes =
+	    contentProvider.readRawData (reinterpret_cast<int8_t*> (buffer.data ()), sizeof (kMagic));
+	SharedPointer<UINode> result;
+	if (numBytes == sizeof (kMagic) && hasMagic (buffer.data (), buffer.size ()))
+	{
+		while (true)
+		{
+			auto size = buffer.size ();
+			buffer.resize (size + kChunkSize);
+			numBytes = contentProvider.readRawData (
+			    reinterpret_cast<int8_t*> (buffer.data () + size), kChunkSize);
+			if (numBytes == 0 || numBytes == kStreamIOError)
+			{
+				buffer.resize (size);
+				break;
+			}
+			buffer.resize (size + numBytes);
+		}
+		result = readContent (buffer.data (), buffer.size (), lazyTemplates, nullptr);
+	}
+	if (!result)
+		contentProvider.rewind ();
+	return result;
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+using namespace UIBinaryDesc;
+
+//------------------------------------------------------------------------
+struct Writer
+{
+	using Attribute = std::pair<const std::string*, const std::string*>;
+
+	static bool isExported (const UINode* node)
+	{
+		return !node->noExport ();
+	}
+
+	static NodeKind getKind (const UINode* node)
+	{
+		if (dynamic_cast<const UIBitmapNode*> (node))
+			return NodeKind::Bitmap;
+		if (dynamic_cast<const UIFontNode*> (node))
+			return NodeKind::Font;
+		if (dynamic_cast<const UIColorNode*> (node))
+			return NodeKind::Color;
+		if (dynamic_cast<const UIControlTagNode*> (node))
+			return NodeKind::ControlTag;
+		if (dynamic_cast<const UIGradientNode*> (node))
+			return NodeKind::Gradient;
+		if (dynamic_cast<const UIVariableNode*> (node))
+			return NodeKind::Variable;
+		if (dynamic_cast<const UICommentNode*> (node))
+			return NodeKind::Comment;
+		return NodeKind::Generic;
+	}
+
+	static std::vector<Attribute> getSortedAttributes (const UINode* node)
+	{
+		std::vector<Attribute> result;
+		if (auto attributes = node->getAttributes ())
+		{
+			for (const auto& attr : *attributes)
+				result.emplace_back (&attr.first, &attr.second);
+		}
+		std::sort (result.begin (), result.end (),
+		           [] (const Attribute& a, const Attribute& b) { return *a.first < *b.first; });
+		return result;
+	}
+
+	uint32_t intern (const std::string& str)
+	{
+		auto it = stringIndices.emplace (str, static_cast<uint32_t> (strings.size ()));
+		if (it.second)
+		{
+			strings.emplace_back (&it.first->first);
+			stringDataSize += str.size () + 1;
+		}
+		return it.first->second;
+	}
+
+	/** intern the strings of node and assign the offsets of node and its children relative to
+	 *	the start of the nodes */
+	void layout (const UINode* node)
+	{
+		intern (node->getName ());
+		intern (node->getData ());
+		auto attributes = getSortedAttributes (node);
+		for (const auto& attr : attributes)
+		{
+			intern (*attr.first);
+			intern (*attr.second);
+		}
+		auto numChildren = std::count_if (node->getChildren ().begin (),
+		                                  node->getChildren ().end (), isExported);
+		nodeOffsets.emplace (node, nodesSize);
+		nodesSize += kNodeHeaderSize + attributes.size () * kStringEntrySize +
+		             static_cast<size_t> (numChildren) * sizeof (uint32_t);
+		for (const auto& child : node->getChildren ())
+		{
+			if (isExported (child))
+				layout (child);
+		}
+	}
+
+	void writeNode (const UINode* node, uint8_t* nodes, uint32_t nodesStart) const
+	{
+		auto attributes = getSortedAttributes (node);
+		auto ptr = nodes + nodeOffsets.at (node);
+		uint32_t flags = 0;
+		if (dynamic_cast<UIDescListWithFastFindAttributeNameChild*> (&node->getChildren ()))
+			flags |= kFastChildLookup;
+		auto numChildren = std::count_if (node->getChildren ().begin (),
+		                                  node->getChildren ().end (), isExported);
+		store32 (ptr, static_cast<uint32_t> (getKind (node)));
+		store32 (ptr + 4, flags);
+		store32 (ptr + 8, stringIndices.at (node->getName ()));
+		store32 (ptr + 12, stringIndices.at (node->getData ()));
+		store32 (ptr + 16, static_cast<uint32_t> (attributes.size ()));
+		store32 (ptr + 20, static_cast<uint32_t> (numChildren));
+		ptr += kNodeHeaderSize;
+		for (const auto& attr : attributes)
+		{
+			store32 (ptr, stringIndices.at (*attr.first));
+			store32 (ptr + 4, stringIndices.at (*attr.second));
+			ptr += kStringEntrySize;
+		}
+		for (const auto& child : node->getChildren ())
+		{
+			if (!isExported (child))
+				continue;
+			store32 (ptr, nodesStart + static_cast<uint32_t> (nodeOffsets.at (child)));
+			ptr += sizeof (uint32_t);
+			writeNode (child, nodes, nodesStart);
+		}
+	}
+
+	std::unordered_map<std::string, uint32_t> stringIndices;
+	std::vector<const std::string*> strings;
+	size_t stringDataSize {0};
+	std::unordered_map<const UINode*, size_t> nodeOffsets;
+	size_t nodesSize {0};
+};
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode)
+{
+	if (!rootNode)
+		return false;
+
+	Writer writer;
+	writer.intern ({});
+	writer.layout (rootNode);
+
+	std::vector<const UINode*> templates;
+	for (const auto& child : rootNode->getChildren ())
+	{
+		if (Writer::isExported (child) && child->getName () == MainNodeNames::kTemplate &&
+		    child->getAttributes ()->hasAttribute ("name"))
+			templates.emplace_back (child);
+	}
+
+	auto stringTable = kHeaderSize;
+	auto templateTable = stringTable + writer.strings.size () * kStringEntrySize;
+	auto stringData = templateTable + templates.size () * kTemplateEntrySize;
+	auto nodesStart = (stringData + writer.stringDataSize + 3) & ~size_t (3);
+	auto totalSize = nodesStart + writer.nodesSize;
+	if (totalSize > std::numeric_limits<uint32_t>::max ())
+		return false;
+
+	std::vector<uint8_t> buffer (totalSize);
+	auto data = buffer.data ();
+	store32 (data, kMagic);
+	store32 (data + 4, kVersion);
+	store32 (data + 8, static_cast<uint32_t> (writer.strings.size ()));
+	store32 (data + 12, static_cast<uint32_t> (stringTable));
+	store32 (data + 16, static_cast<uint32_t> (nodesStart + writer.nodeOffsets.at (rootNode)));
+	store32 (data + 20, static_cast<uint32_t> (templates.size ()));
+	store32 (data + 24, static_cast<uint32_t> (templateTable));
+
+	auto stringOffset = stringData;
+	for (auto i = 0u; i < writer.strings.size (); ++i)
+	{
+		const auto& str = *writer.strings[i];
+		store32 (data + stringTable + i * kStringEntrySize, static_cast<uint32_t> (stringOffset));
+		store32 (data + stringTable + i * kStringEntrySize + 4, static_cast<uint32_t> (str.size ()));
+		std::copy (str.begin (), str.end (), data + stringOffset);
+		stringOffset += str.size () + 1;
+	}
+	for (auto i = 0u; i < templates.size (); ++i)
+	{
+		auto name = templates[i]->getAttributes ()->getAttributeValue ("name");
+		store32 (data + templateTable + i * kTemplateEntrySize, writer.stringIndices.at (*name));
+		store32 (data + templateTable + i * kTemplateEntrySize + 4,
+		         static_cast<uint32_t> (nodesStart + writer.nodeOffsets.at (templates[i])));
+	}
+	writer.writeNode (rootNode, data + nodesStart, static_cast<uint32_t> (nodesStart));
+
+	auto size = static_cast<uint32_t> (buffer.size ());
+	return stream.writeRaw (buffer.data (), size) == size;
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,73 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../cstream.h"
+#include "../icontentprovider.h"
+#include "uinode.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** Compiled binary uidesc format
+ *
+ *	Every string of the description (node names, attribute keys and values, node data) is stored
+ *	once in a string table and referenced by index. Nodes are stored with the offsets of their
+ *	children and the header points to a table of all templates, so that a single node can be read
+ *	without reading the nodes in front of it, i.e. from a memory mapped file.
+ *
+ *	All fields are little endian 32 bit values:
+ *	- header: magic, version, string count, string table offset, root node offset, template count,
+ *	  template table offset
+ *	- string table: offset and size of each string, the strings are zero terminated. The first
+ *	  string is the empty string
+ *	- template table: name string and node offset of each template
+ *	- node: kind, flags, name string, data string, attribute count, child count, key and value
+ *	  string of each attribute, offset of each child. Children are stored after their parent.
+ */
+namespace UIBinaryDesc {
+
+//------------------------------------------------------------------------
+static constexpr uint32_t kMagic = 0x62756776; // "vgub"
+static constexpr uint32_t kVersion = 1;
+static constexpr uint32_t kHeaderSize = 7 * sizeof (uint32_t);
+
+//------------------------------------------------------------------------
+/** true if data starts with the magic of the binary format */
+bool hasMagic (const void* data, size_t size);
+
+//------------------------------------------------------------------------
+} // UIBinaryDesc
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescReader {
+
+//------------------------------------------------------------------------
+/** returns nullptr and rewinds the content provider if the content is not a binary uidesc.
+ *
+ *	With lazyTemplates the children of the templates in the template table are read when they are
+ *	accessed for the first time. They are read in place if the content provider has an owner of
+ *	its content (i.e. a memory mapped file), otherwise from a copy of the template nodes and the
+ *	strings they use.
+ */
+SharedPointer<UINode> read (IContentProvider& contentProvider, bool lazyTemplates = false);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,89 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uidescformat.h"
+#include "uibinarypersistence.h"
+#include <array>
+#include <cstring>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+/** the identifier CompressedUIDescription writes in front of the zlib stream */
+static constexpr char kCompressedIdentifier[] = "uidescrp";
+static constexpr size_t kCompressedIdentifierSize = sizeof (kCompressedIdentifier) - 1;
+
+/** number of bytes read from a content provider which has no content in memory */
+static constexpr uint32_t kSniffSize = 256;
+
+//------------------------------------------------------------------------
+bool startsWith (const uint8_t* data, size_t size, const char* prefix, size_t prefixSize)
+{
+	return size >= prefixSize && std::memcmp (data, prefix, prefixSize) == 0;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+UIDescription::Format detectUIDescFormat (const void* data, size_t size)
+{
+	using Format = UIDescription::Format;
+
+	auto bytes = static_cast<const uint8_t*> (data);
+	if (UIBinaryDesc::hasMagic (bytes, size))
+		return Format::Binary;
+	if (startsWith (bytes, size, kCompressedIdentifier, kCompressedIdentifierSize))
+		return Format::Compressed;
+	// expat detects UTF-16 from the byte order mark
+	if (startsWith (bytes, size, "\xFF\xFE", 2) || startsWith (bytes, size, "\xFE\xFF", 2))
+		return Format::XML;
+	if (startsWith (bytes, size, "\xEF\xBB\xBF", 3))
+	{
+		bytes += 3;
+		size -= 3;
+	}
+	for (auto end = bytes + size; bytes != end; ++bytes)
+	{
+		switch (*bytes)
+		{
+			case ' ':
+			case '\t':
+			case '\r':
+			case '\n':
+				continue;
+			case '{':
+				return Format::JSON;
+			case '<':
+				return Format::XML;
+			default:
+				return Format::Unknown;
+		}
+	}
+	return Format::Unknown;
+}
+
+//------------------------------------------------------------------------
+UIDescription::Format detectUIDescFormat (IContentProvider& contentProvider)
+{
+	uint32_t size = 0;
+	if (auto content = contentProvider.getContent (size))
+		return detectUIDescFormat (content, size);
+
+	std::array<int8_t, kSniffSize> buffer;
+	auto numBytes = contentProvider.readRawData (buffer.data (), kSniffSize);
+	contentProvider.rewind ();
+	if (numBytes == kStreamIOError)
+		return UIDescription::Format::Unknown;
+	return detectUIDescFormat (buffer.data (), numBytes);
+}
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,24 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../icontentprovider.h"
+#include "../uidescription.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** detect the format of a description from its first bytes */
+UIDescription::Format detectUIDescFormat (const void* data, size_t size);
+
+//------------------------------------------------------------------------
+/** detect the format of the content and rewind the content provider */
+UIDescription::Format detectUIDescFormat (IContentProvider& contentProvider);
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
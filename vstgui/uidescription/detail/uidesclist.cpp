@@ -5,17 +5,27 @@
 #include "../uiattributes.h"
 #include "uidesclist.h"
 #include "uinode.h"
+#include <atomic>
 
 namespace VSTGUI {
 namespace Detail {
 
 //-----------------------------------------------------------------------------
-UIDescList::UIDescList (bool ownsObjects) : ownsObjects (ownsObjects)
+static uint64_t nextListRevision ()
+{
+	static std::atomic<uint64_t> counter {0};
+	return ++counter;
+}
+
+//-----------------------------------------------------------------------------
+UIDescList::UIDescList (bool ownsObjects)
+: ownsObjects (ownsObjects), revision (nextListRevision ())
 {
 }
 
 //------------------------------------------------------------------------
-UIDescList::UIDescList (const UIDescList& uiDesc) : ownsObjects (false)
+UIDescList::UIDescList (const UIDescList& uiDesc)
+: ownsObjects (false), revision (nextListRevision ())
 {
 	for (auto& child : uiDesc)
 		add (child);
@@ -33,6 +43,7 @@ void UIDescList::add (UINode* obj)
 	if (!ownsObjects)
 		obj->remember ();
 	UIDescListContainerType::emplace_back (obj);
+	markChanged ();
 }
 
 //-----------------------------------------------------------------------------
@@ -44,6 +55,7 @@ void UIDescList::remove (UINode* obj)
 	{
 		UIDescListContainerType::erase (pos);
 		obj->forget ();
+		markChanged ();
 	}
 }
 
@@ -53,6 +65,7 @@ void UIDescList::removeAll ()
 	for (const_reverse_iterator it = rbegin (), end = rend (); it != end; ++it)
 		(*it)->forget ();
 	clear ();
+	markChanged ();
 }
 
 //-----------------------------------------------------------------------------
@@ -93,6 +106,20 @@ void UIDescList::sort ()
 			return true;
 		return false;
 	});
+	markChanged ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescList::nodeAttributeChanged (UINode* child, const std::string& attributeName,
+                                       const std::string& oldAttributeValue)
+{
+	markChanged ();
+}
+
+//-----------------------------------------------------------------------------
+void UIDescList::markChanged ()
+{
+	revision = nextListRevision ();
 }
 
 //------------------------------------------------------------------------
@@ -116,8 +143,11 @@ void UIDescListWithFastFindAttributeNameChild::remove (UINode* obj)
 	if (nameAttributeValue)
 	{
 		ChildMap::iterator it = childMap.find (*nameAttributeValue);
-		if (it != childMap.end ())
+		if (it != childMap.end () && it->second == obj)
+		{
 			childMap.erase (it);
+			addFirstChildWithName (*nameAttributeValue, obj);
+		}
 	}
 	UIDescList::remove (obj);
 }
@@ -145,16 +175,38 @@ UINode* UIDescListWithFastFindAttributeNameChild::findChildNodeWithAttributeValu
 void UIDescListWithFastFindAttributeNameChild::nodeAttributeChanged (
     UINode* node, const std::string& attributeName, const std::string& oldAttributeValue)
 {
+	UIDescList::nodeAttributeChanged (node, attributeName, oldAttributeValue);
 	if (attributeName != "name")
 		return;
 	ChildMap::iterator it = childMap.find (oldAttributeValue);
-	if (it != childMap.end ())
+	if (it != childMap.end () && it->second == node)
+	{
 		childMap.erase (it);
+		addFirstChildWithName (oldAttributeValue, node);
+	}
 	const std::string* nameAttributeValue = node->getAttributes ()->getAttributeValue ("name");
 	if (nameAttributeValue)
 		childMap.emplace (*nameAttributeValue, node);
 }
 
+//------------------------------------------------------------------------
+void UIDescListWithFastFindAttributeNameChild::addFirstChildWithName (const std::string& name,
+                                                                     const UINode* exclude)
+{
+	// another child may use the same name, the linear search would find the first one
+	for (const auto& child : *this)
+	{
+		if (child == exclude)
+			continue;
+		const std::string* nameAttributeValue = child->getAttributes ()->getAttributeValue ("name");
+		if (nameAttributeValue && *nameAttributeValue == name)
+		{
+			childMap.emplace (name, child);
+			return;
+		}
+	}
+}
+
 //------------------------------------------------------------------------
 } // Detail
 } // VSTGUI
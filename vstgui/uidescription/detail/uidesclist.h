@@ -41,14 +41,19 @@ public:
 	                                                 const std::string& attributeValue) const;
 
 	virtual void nodeAttributeChanged (UINode* child, const std::string& attributeName,
-	                                   const std::string& oldAttributeValue)
-	{
-	}
+	                                   const std::string& oldAttributeValue);
 
 	void sort ();
 
+	/** mark the list as changed when the content of one of its children has changed */
+	void markChanged ();
+	/** the revision changes whenever the list or one of its children was changed. It is unique
+	 *	across all lists so that it can be used to validate caches built from the list's content */
+	uint64_t getRevision () const { return revision; }
+
 protected:
 	bool ownsObjects;
+	uint64_t revision;
 };
 
 //-----------------------------------------------------------------------------
@@ -69,6 +74,8 @@ public:
 	                           const std::string& oldAttributeValue) override;
 
 private:
+	void addFirstChildWithName (const std::string& name, const UINode* exclude);
+
 	ChildMap childMap;
 };
 
@@ -17,6 +17,7 @@
 #include "../rapidjson/include/rapidjson/error/en.h"
 #endif
 #include "../rapidjson/include/rapidjson/document.h"
+#include "../rapidjson/include/rapidjson/memorystream.h"
 #include "../rapidjson/include/rapidjson/prettywriter.h"
 #include "../rapidjson/include/rapidjson/reader.h"
 
@@ -199,7 +200,8 @@ struct Handler
 			{
 				vstgui_assert (keyStr == "vstgui-ui-description" ||
 				               keyStr == "vstgui-ui-description-view-list");
-				rootNode = makeOwned<UINode> (std::move (keyStr));
+				// templates are looked up by name in the root node
+				rootNode = makeOwned<UINode> (std::move (keyStr), nullptr, true);
 				newNode = rootNode;
 				newState = State::InRootNode;
 				break;
@@ -211,33 +213,23 @@ struct Handler
 					newState = State::InTemplateRootNode;
 					break;
 				}
-				auto needsFastChildNameAttributeLookup = false;
 				if (keyStr == MainNodeNames::kBitmap)
-				{
 					newState = State::InBitmapRootNode;
-					needsFastChildNameAttributeLookup = true;
-				}
 				else if (keyStr == MainNodeNames::kFont)
 					newState = State::InFontRootNode;
 				else if (keyStr == MainNodeNames::kColor)
-				{
 					newState = State::InColorRootNode;
-					needsFastChildNameAttributeLookup = true;
-				}
 				else if (keyStr == MainNodeNames::kGradient)
 					newState = State::InGradientRootNode;
 				else if (keyStr == MainNodeNames::kControlTag)
-				{
 					newState = State::InControlTagRootNode;
-					needsFastChildNameAttributeLookup = true;
-				}
 				else if (keyStr == MainNodeNames::kCustom)
 					newState = State::InCustomRootNode;
 				else if (keyStr == MainNodeNames::kVariable)
 					newState = State::InVariableRootNode;
 				else
 					return false;
-				newNode = new UINode (keyStr, nullptr, needsFastChildNameAttributeLookup);
+				newNode = new UINode (keyStr, nullptr, true);
 				break;
 			}
 			case State::InBitmapRootNode:
@@ -396,13 +388,13 @@ struct Handler
 };
 
 //------------------------------------------------------------------------
-SharedPointer<UINode> read (IContentProvider& stream)
+template <typename Stream>
+SharedPointer<UINode> parse (Stream& stream)
 {
-	ContentProviderWrapper<1024> streamWrapper (stream);
 	Handler handler;
 	rapidjson::Reader reader;
 
-	auto result = reader.Parse (streamWrapper, handler);
+	auto result = reader.Parse (stream, handler);
 	if (result.IsError ())
 	{
 #if DEBUG
@@ -418,6 +410,19 @@ SharedPointer<UINode> read (IContentProvider& stream)
 	return handler.rootNode;
 }
 
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (IContentProvider& stream)
+{
+	uint32_t contentSize;
+	if (auto content = stream.getContent (contentSize))
+	{
+		rapidjson::MemoryStream memoryStream (reinterpret_cast<const char*> (content), contentSize);
+		return parse (memoryStream);
+	}
+	ContentProviderWrapper<1024> streamWrapper (stream);
+	return parse (streamWrapper);
+}
+
 //------------------------------------------------------------------------
 } // UIJsonDescReader
 
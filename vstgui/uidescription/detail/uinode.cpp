@@ -51,9 +51,10 @@ UINode::UINode (const UINode& n)
 : name (n.name)
 , data (n.data)
 , attributes (makeOwned<UIAttributes> (*n.attributes))
-, children (makeOwned<UIDescList> (*n.children))
+, children (makeOwned<UIDescList> (n.getChildren ()))
 , flags (n.flags)
 {
+	setBit (flags, kLazyChildren, false);
 }
 
 //-----------------------------------------------------------------------------
@@ -64,20 +65,20 @@ UINode::~UINode () noexcept
 //-----------------------------------------------------------------------------
 bool UINode::hasChildren () const
 {
-	return !children->empty ();
+	return !getChildren ().empty ();
 }
 
 //-----------------------------------------------------------------------------
 void UINode::childAttributeChanged (UINode* child, const char* attributeName,
                                     const char* oldAttributeValue)
 {
-	children->nodeAttributeChanged (child, attributeName, oldAttributeValue);
+	getChildren ().nodeAttributeChanged (child, attributeName, oldAttributeValue);
 }
 
 //-----------------------------------------------------------------------------
 void UINode::sortChildren ()
 {
-	children->sort ();
+	getChildren ().sort ();
 }
 
 //------------------------------------------------------------------------
@@ -86,6 +87,32 @@ void UINode::setData (DataStorage&& newData)
 	data = std::move (newData);
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+UILazyNode::UILazyNode (const std::string& name, const SharedPointer<UIAttributes>& attributes,
+                        bool needsFastChildNameAttributeLookup, ChildrenCreator&& childrenCreator)
+: UINode (name, attributes, needsFastChildNameAttributeLookup)
+, childrenCreator (std::move (childrenCreator))
+{
+	setBit (flags, kLazyChildren, true);
+}
+
+//-----------------------------------------------------------------------------
+void UILazyNode::createLazyChildren ()
+{
+	setBit (flags, kLazyChildren, false);
+	auto creator = std::move (childrenCreator);
+	childrenCreator = nullptr;
+	if (creator && !creator (*children))
+	{
+#if DEBUG
+		DebugPrint ("Creating the children of %s failed.\n", name.data ());
+#endif
+		children->removeAll ();
+	}
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -356,9 +383,12 @@ PlatformBitmapPtr UIBitmapNode::createBitmapFromDataNode () const
 		auto codecStr = node->getAttributes ()->getAttributeValue ("encoding");
 		if (codecStr && *codecStr == "base64")
 		{
-			auto result = Base64Codec::decode (node->getData ());
-			if (auto platformBitmap = getPlatformFactory ().createBitmapFromMemory (
-			        result.data.get (), result.dataSize))
+			// decode while the platform reads the image instead of decoding all data first
+			Base64Codec::Decoder decoder (node->getData ());
+			if (auto platformBitmap = getPlatformFactory ().createBitmapFromReader (
+			        [&] (uint8_t* buffer, uint32_t size) {
+				        return static_cast<uint32_t> (decoder.read (buffer, size));
+			        }))
 			{
 				double scaleFactor = 1.;
 				if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
@@ -375,50 +405,64 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 {
 	if (bitmap == nullptr)
 	{
-		const std::string* path = attributes->getAttributeValue ("path");
-		if (path)
-		{
-			CNinePartTiledDescription partDesc;
-			CNinePartTiledDescription* partDescPtr = nullptr;
-			CRect offsets;
-			if (attributes->getRectAttribute ("nineparttiled-offsets", offsets))
-			{
-				partDesc = CNinePartTiledDescription (offsets.left, offsets.top, offsets.right,
-				                                      offsets.bottom);
-				partDescPtr = &partDesc;
-			}
-			bitmap = createBitmap (*path, partDescPtr);
-			if (bitmap->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
-			{
-				std::string absPath = pathHint;
-				if (removeLastPathComponent (absPath))
-				{
-					absPath += "/" + *path;
-					if (auto platformBitmap =
-					        getPlatformFactory ().createBitmapFromPath (absPath.c_str ()))
-					{
-						bitmap->setPlatformBitmap (platformBitmap);
-					}
-				}
-			}
-		}
-		if (bitmap && bitmap->getPlatformBitmap () == nullptr)
+		if (auto decodedBitmap = decodeBitmap (pathHint))
+			setDecodedBitmap (decodedBitmap);
+	}
+	return bitmap;
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<CBitmap> UIBitmapNode::decodeBitmap (const std::string& pathHint) const
+{
+	const std::string* path = attributes->getAttributeValue ("path");
+	if (path == nullptr)
+		return nullptr;
+	CNinePartTiledDescription partDesc;
+	CNinePartTiledDescription* partDescPtr = nullptr;
+	CRect offsets;
+	if (attributes->getRectAttribute ("nineparttiled-offsets", offsets))
+	{
+		partDesc =
+		    CNinePartTiledDescription (offsets.left, offsets.top, offsets.right, offsets.bottom);
+		partDescPtr = &partDesc;
+	}
+	auto result = owned (createBitmap (*path, partDescPtr));
+	if (result->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
+	{
+		std::string absPath = pathHint;
+		if (removeLastPathComponent (absPath))
 		{
-			if (auto platformBitmap = createBitmapFromDataNode ())
-				bitmap->setPlatformBitmap (platformBitmap);
+			absPath += "/" + *path;
+			if (auto platformBitmap = getPlatformFactory ().createBitmapFromPath (absPath.c_str ()))
+				result->setPlatformBitmap (platformBitmap);
 		}
-		if (bitmap && path && bitmap->getPlatformBitmap () &&
-		    bitmap->getPlatformBitmap ()->getScaleFactor () == 1.)
+	}
+	if (result->getPlatformBitmap () == nullptr)
+	{
+		if (auto platformBitmap = createBitmapFromDataNode ())
+			result->setPlatformBitmap (platformBitmap);
+	}
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapNode::setDecodedBitmap (CBitmap* decodedBitmap)
+{
+	if (bitmap || decodedBitmap == nullptr)
+		return;
+	bitmap = decodedBitmap;
+	bitmap->remember ();
+	const std::string* path = attributes->getAttributeValue ("path");
+	if (path && bitmap->getPlatformBitmap () &&
+	    bitmap->getPlatformBitmap ()->getScaleFactor () == 1.)
+	{
+		double scaleFactor = 1.;
+		if (Detail::decodeScaleFactorFromName (*path, scaleFactor))
 		{
-			double scaleFactor = 1.;
-			if (Detail::decodeScaleFactorFromName (*path, scaleFactor))
-			{
-				bitmap->getPlatformBitmap ()->setScaleFactor (scaleFactor);
-				attributes->setDoubleAttribute ("scale-factor", scaleFactor);
-			}
+			bitmap->getPlatformBitmap ()->setScaleFactor (scaleFactor);
+			attributes->setDoubleAttribute ("scale-factor", scaleFactor);
 		}
 	}
-	return bitmap;
 }
 
 //-----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include "../uidescriptionfwd.h"
 #include "../../lib/ccolor.h"
 #include "uidesclist.h"
+#include <functional>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -47,14 +48,21 @@ public:
 	void setData (DataStorage&& newData);
 
 	const SharedPointer<UIAttributes>& getAttributes () const { return attributes; }
-	UIDescList& getChildren () const { return *children; }
+	UIDescList& getChildren () const
+	{
+		if (hasBit (flags, kLazyChildren))
+			const_cast<UINode*> (this)->createLazyChildren ();
+		return *children;
+	}
 	bool hasChildren () const;
 	void childAttributeChanged (UINode* child, const char* attributeName,
 	                            const char* oldAttributeValue);
 
 	enum
 	{
-		kNoExport = 1 << 0
+		kNoExport = 1 << 0,
+		/** the children are created by createLazyChildren on first access */
+		kLazyChildren = 1 << 1,
 	};
 
 	bool noExport () const { return hasBit (flags, kNoExport); }
@@ -66,6 +74,8 @@ public:
 	virtual void freePlatformResources () {}
 
 protected:
+	virtual void createLazyChildren () { setBit (flags, kLazyChildren, false); }
+
 	std::string name;
 	DataStorage data;
 	SharedPointer<UIAttributes> attributes;
@@ -73,6 +83,24 @@ protected:
 	int32_t flags;
 };
 
+//-----------------------------------------------------------------------------
+/** a node which creates its children when they are accessed for the first time */
+class UILazyNode : public UINode
+{
+public:
+	using ChildrenCreator = std::function<bool (UIDescList& children)>;
+
+	UILazyNode (const std::string& name, const SharedPointer<UIAttributes>& attributes,
+	            bool needsFastChildNameAttributeLookup, ChildrenCreator&& childrenCreator);
+
+	bool childrenCreated () const { return !hasBit (flags, kLazyChildren); }
+
+protected:
+	void createLazyChildren () override;
+
+	ChildrenCreator childrenCreator;
+};
+
 //-----------------------------------------------------------------------------
 class UICommentNode : public UINode
 {
@@ -123,6 +151,12 @@ class UIBitmapNode : public UINode
 public:
 	UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CBitmap* getBitmap (const std::string& pathHint);
+	/** decode the bitmap without changing the node, can be called from any thread as long as
+	 *	the node is not changed at the same time */
+	SharedPointer<CBitmap> decodeBitmap (const std::string& pathHint) const;
+	/** use a bitmap returned by decodeBitmap, ignored if the node already has a bitmap */
+	void setDecodedBitmap (CBitmap* decodedBitmap);
+	bool hasBitmap () const { return bitmap != nullptr; }
 	void setBitmap (UTF8StringPtr bitmapName);
 	void setNinePartTiledOffset (const CRect* offsets);
 	void invalidBitmap ();
@@ -89,6 +89,8 @@ static const std::string kAttrOpacity = "opacity";
 //-----------------------------------------------------------------------------
 static const std::string kAttrBackgroundColor = "background-color";
 static const std::string kAttrBackgroundColorDrawStyle = "background-color-draw-style";
+static const std::string kAttrRenderCache = "render-cache";
+static const std::string kAttrOpaque = "opaque";
 
 //-----------------------------------------------------------------------------
 // CLayeredViewContainerCreator attributes
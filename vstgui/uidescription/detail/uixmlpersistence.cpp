@@ -44,11 +44,12 @@ void UIXMLParser::startXmlElement (Xml::Parser* parser, IdStringPtr elementName,
 			if (parent == nodes)
 			{
 				// only allowed second level elements
-				if (name == MainNodeNames::kControlTag || name == MainNodeNames::kColor || name == MainNodeNames::kBitmap)
+				if (name == MainNodeNames::kControlTag || name == MainNodeNames::kColor
+				    || name == MainNodeNames::kBitmap || name == MainNodeNames::kFont
+				    || name == MainNodeNames::kCustom || name == MainNodeNames::kVariable
+				    || name == MainNodeNames::kGradient)
 					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes), true);
-				else if (name == MainNodeNames::kFont || name == MainNodeNames::kTemplate
-					  || name == MainNodeNames::kControlTag || name == MainNodeNames::kCustom
-					  || name == MainNodeNames::kVariable || name == MainNodeNames::kGradient)
+				else if (name == MainNodeNames::kTemplate)
 					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
@@ -106,7 +107,8 @@ void UIXMLParser::startXmlElement (Xml::Parser* parser, IdStringPtr elementName,
 	}
 	else if (name == "vstgui-ui-description")
 	{
-		nodes = makeOwned<UINode> (name, makeOwned<UIAttributes> (elementAttributes));
+		// templates are looked up by name in the root node
+		nodes = makeOwned<UINode> (name, makeOwned<UIAttributes> (elementAttributes), true);
 		nodeStack.emplace_back (nodes);
 	}
 	else if (name == "vstgui-ui-description-view-list")
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../lib/vstguibase.h"
+#include <memory>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -15,6 +16,12 @@ class IContentProvider
 public:
 	virtual uint32_t readRawData (int8_t* buffer, uint32_t size) = 0;
 	virtual void rewind () = 0;
+	/** the unread content if it is available in memory, nullptr otherwise. Parsers use it to
+	 *	read the content in place instead of copying it chunk by chunk. */
+	virtual const int8_t* getContent (uint32_t& size) { return nullptr; }
+	/** the owner of the memory returned by getContent if it can be kept alive after parsing
+	 *	(i.e. a memory mapped file), nullptr if the memory is only valid while parsing */
+	virtual std::shared_ptr<const void> getContentOwner () { return nullptr; }
 
 	virtual ~IContentProvider () noexcept = default;
 };
@@ -39,6 +39,9 @@ public:
 
 	virtual bool getVariable (UTF8StringPtr name, double& value) const = 0;
 	virtual bool getVariable (UTF8StringPtr name, std::string& value) const = 0;
+	/** changes whenever a variable or a color was changed, so that caches of evaluated
+	 *	attributes can be validated. Zero if the description does not track its changes. */
+	virtual uint64_t getResourceRevision () const { return 0; }
 
 	virtual void collectTemplateViewNames (std::list<const std::string*>& names) const = 0;
 	virtual void collectColorNames (std::list<const std::string*>& names) const = 0;
@@ -9,6 +9,8 @@
 #include "../lib/cstring.h"
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <tuple>
 
 namespace VSTGUI {
 namespace {
@@ -224,8 +226,38 @@ bool UIAttributes::stringToStringArray (const std::string& str, std::vector<std:
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+static uint64_t nextAttributesRevision ()
+{
+	// attributes may be created on other threads, e.g. when templates are parsed in the background
+	static std::atomic<uint64_t> counter {0};
+	return ++counter;
+}
+
+//-----------------------------------------------------------------------------
+struct UIAttributes::ParsedValueCache
+{
+	template<typename T>
+	using Values = std::unordered_map<std::string, T>;
+
+	template<typename T>
+	Values<T>& get () { return std::get<Values<T>> (values); }
+
+	void clear ()
+	{
+		get<bool> ().clear ();
+		get<int32_t> ().clear ();
+		get<double> ().clear ();
+		get<CPoint> ().clear ();
+		get<CRect> ().clear ();
+	}
+
+	std::tuple<Values<bool>, Values<int32_t>, Values<double>, Values<CPoint>, Values<CRect>> values;
+};
+
 //-----------------------------------------------------------------------------
 UIAttributes::UIAttributes (UTF8StringPtr* attributes)
+: revision (nextAttributesRevision ())
 {
 	if (attributes)
 	{
@@ -246,10 +278,82 @@ UIAttributes::UIAttributes (UTF8StringPtr* attributes)
 
 //------------------------------------------------------------------------
 UIAttributes::UIAttributes (size_t reserve)
+: revision (nextAttributesRevision ())
 {
 	UIAttributesMap::reserve (reserve);
 }
 
+//------------------------------------------------------------------------
+UIAttributes::UIAttributes (const UIAttributes& other)
+: UIAttributesMap (other), revision (nextAttributesRevision ())
+{
+}
+
+//------------------------------------------------------------------------
+UIAttributes::~UIAttributes () noexcept = default;
+
+//------------------------------------------------------------------------
+UIAttributes& UIAttributes::operator= (const UIAttributes& other)
+{
+	if (this != &other)
+	{
+		UIAttributesMap::operator= (other);
+		changed ();
+	}
+	return *this;
+}
+
+//------------------------------------------------------------------------
+void UIAttributes::changed ()
+{
+	revision = nextAttributesRevision ();
+	if (parsedValueCache)
+		parsedValueCache->clear ();
+	derivedData = nullptr;
+}
+
+//------------------------------------------------------------------------
+void UIAttributes::enableParsedValueCache ()
+{
+	if (!parsedValueCache)
+		parsedValueCache = std::unique_ptr<ParsedValueCache> (new ParsedValueCache);
+}
+
+//------------------------------------------------------------------------
+void UIAttributes::setDerivedData (std::unique_ptr<DerivedData>&& data) const
+{
+	derivedData = std::move (data);
+}
+
+//------------------------------------------------------------------------
+template<typename T, typename ParseFunction>
+bool UIAttributes::getParsedValue (const std::string& name, T& value, ParseFunction parse) const
+{
+	auto str = getAttributeValue (name);
+	if (!str)
+		return false;
+	if (!parsedValueCache)
+		return parse (*str, value);
+	auto& values = parsedValueCache->get<T> ();
+	auto it = values.find (name);
+	if (it != values.end ())
+	{
+		value = it->second;
+		return true;
+	}
+	if (!parse (*str, value))
+		return false;
+	values.emplace (name, value);
+	return true;
+}
+
+//------------------------------------------------------------------------
+void UIAttributes::removeAll ()
+{
+	clear ();
+	changed ();
+}
+
 //-----------------------------------------------------------------------------
 bool UIAttributes::hasAttribute (const std::string& name) const
 {
@@ -270,6 +374,7 @@ const std::string* UIAttributes::getAttributeValue (const std::string& name) con
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, const std::string& value)
 {
+	changed ();
 	iterator iter = find (name);
 	if (iter != end ())
 		iter->second = value;
@@ -280,6 +385,7 @@ void UIAttributes::setAttribute (const std::string& name, const std::string& val
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 {
+	changed ();
 	iterator iter = find (name);
 	if (iter != end ())
 		iter->second = std::move (value);
@@ -290,6 +396,7 @@ void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 {
+	changed ();
 	iterator iter = find (name);
 	if (iter != end ())
 		iter->second = std::move (value);
@@ -300,6 +407,7 @@ void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 //-----------------------------------------------------------------------------
 void UIAttributes::removeAttribute (const std::string& name)
 {
+	changed ();
 	iterator iter = find (name);
 	if (iter != end ())
 		erase (iter);
@@ -314,9 +422,7 @@ void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToDouble (*str, value);
-	return false;
+	return getParsedValue (name, value, stringToDouble);
 }
 
 //-----------------------------------------------------------------------------
@@ -328,9 +434,7 @@ void UIAttributes::setBooleanAttribute (const std::string& name, bool value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getBooleanAttribute (const std::string& name, bool& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToBool (*str, value);
-	return false;
+	return getParsedValue (name, value, stringToBool);
 }
 
 //-----------------------------------------------------------------------------
@@ -342,9 +446,7 @@ void UIAttributes::setIntegerAttribute (const std::string& name, int32_t value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToInteger(*str, value);
-	return false;
+	return getParsedValue (name, value, stringToInteger);
 }
 
 //-----------------------------------------------------------------------------
@@ -356,9 +458,7 @@ void UIAttributes::setPointAttribute (const std::string& name, const CPoint& p)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToPoint (*str, p);
-	return false;
+	return getParsedValue (name, p, stringToPoint);
 }
 
 //-----------------------------------------------------------------------------
@@ -370,9 +470,7 @@ void UIAttributes::setRectAttribute (const std::string& name, const CRect& r)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getRectAttribute (const std::string& name, CRect& r) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToRect (*str, r);
-	return false;
+	return getParsedValue (name, r, stringToRect);
 }
 
 //-----------------------------------------------------------------------------
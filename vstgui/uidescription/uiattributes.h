@@ -7,6 +7,7 @@
 #include "../lib/vstguifwd.h"
 #include "../lib/cstring.h"
 
+#include <memory>
 #include <vector>
 #include "../lib/platform/std_unorderedmap.h"
 
@@ -24,7 +25,10 @@ public:
 	
 	explicit UIAttributes (UTF8StringPtr* attributes = nullptr);
 	explicit UIAttributes (size_t reserve);
-	~UIAttributes () noexcept override = default;
+	UIAttributes (const UIAttributes& other);
+	~UIAttributes () noexcept override;
+
+	UIAttributes& operator= (const UIAttributes& other);
 
 	using UIAttributesMap::empty;
 
@@ -58,7 +62,25 @@ public:
 	void setStringArrayAttribute (const std::string& name, const StringArray& values);
 	bool getStringArrayAttribute (const std::string& name, StringArray& values) const;
 	
-	void removeAll () { clear (); }
+	void removeAll ();
+
+	/** the revision changes whenever an attribute was changed. It is unique across all attributes
+	 *	so that it can be used to validate caches built from the attributes */
+	uint64_t getRevision () const { return revision; }
+
+	/** keep the results of the typed getters, for attributes which are read many times. Changing
+	 *	an attribute drops the cached values */
+	void enableParsedValueCache ();
+
+	/** data which a user of the attributes derives from them, for example the view creation plan
+	 *	of UIViewFactory. It lives as long as the attributes and is dropped when an attribute
+	 *	changes */
+	struct DerivedData
+	{
+		virtual ~DerivedData () noexcept = default;
+	};
+	DerivedData* getDerivedData () const { return derivedData.get (); }
+	void setDerivedData (std::unique_ptr<DerivedData>&& data) const;
 
 	bool store (OutputStream& stream) const;
 	bool restore (InputStream& stream);
@@ -75,7 +97,18 @@ public:
 	static bool stringToRect (const std::string& str, CRect& r);
 	static std::string stringArrayToString (const StringArray& values);
 	static bool stringToStringArray (const std::string& str, StringArray& values);
-	
+
+private:
+	struct ParsedValueCache;
+
+	template<typename T, typename ParseFunction>
+	bool getParsedValue (const std::string& name, T& value, ParseFunction parse) const;
+	void changed ();
+
+	std::unique_ptr<ParsedValueCache> parsedValueCache;
+	// derived data does not change the attributes, so it can be set on const attributes
+	mutable std::unique_ptr<DerivedData> derivedData;
+	uint64_t revision;
 };
 
 } // VSTGUI
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "uicontentprovider.h"
+#include <limits>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -13,6 +14,14 @@ MemoryContentProvider::MemoryContentProvider (const void* data, uint32_t dataSiz
 {
 }
 
+//------------------------------------------------------------------------
+MemoryContentProvider::MemoryContentProvider (const void* data, uint32_t dataSize,
+                                              std::shared_ptr<const void> contentOwner)
+: CMemoryStream ((const int8_t*)data, dataSize, false)
+, contentOwner (std::move (contentOwner))
+{
+}
+
 //------------------------------------------------------------------------
 uint32_t MemoryContentProvider::readRawData (int8_t* buffer, uint32_t size)
 {
@@ -25,6 +34,19 @@ void MemoryContentProvider::rewind ()
 	CMemoryStream::rewind ();
 }
 
+//------------------------------------------------------------------------
+const int8_t* MemoryContentProvider::getContent (uint32_t& _size)
+{
+	_size = size - pos;
+	return buffer + pos;
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<const void> MemoryContentProvider::getContentOwner ()
+{
+	return contentOwner;
+}
+
 //------------------------------------------------------------------------
 InputStreamContentProvider::InputStreamContentProvider (InputStream& stream)
 : stream (stream)
@@ -49,6 +71,30 @@ void InputStreamContentProvider::rewind ()
 		seekStream->seek (startPos, SeekableStream::kSeekSet);
 }
 
+//------------------------------------------------------------------------
+const int8_t* InputStreamContentProvider::getContent (uint32_t& size)
+{
+	auto resourceStream = dynamic_cast<CResourceInputStream*> (&stream);
+	if (resourceStream == nullptr)
+		return nullptr;
+	uint64_t memorySize;
+	auto memory = resourceStream->getMemory (memorySize);
+	auto position = resourceStream->tell ();
+	if (memory == nullptr || position < 0 || static_cast<uint64_t> (position) > memorySize ||
+	    memorySize - static_cast<uint64_t> (position) > std::numeric_limits<uint32_t>::max ())
+		return nullptr;
+	size = static_cast<uint32_t> (memorySize - static_cast<uint64_t> (position));
+	return reinterpret_cast<const int8_t*> (memory + position);
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<const void> InputStreamContentProvider::getContentOwner ()
+{
+	if (auto resourceStream = dynamic_cast<CResourceInputStream*> (&stream))
+		return resourceStream->getMemoryOwner ();
+	return nullptr;
+}
+
 
 //------------------------------------------------------------------------
 } // VSTGUI
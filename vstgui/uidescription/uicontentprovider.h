@@ -15,8 +15,14 @@ class MemoryContentProvider : public CMemoryStream, public IContentProvider
 {
 public:
 	MemoryContentProvider (const void* data, uint32_t dataSize);		// data must be valid the whole lifetime of this object
+	/** contentOwner keeps data valid */
+	MemoryContentProvider (const void* data, uint32_t dataSize, std::shared_ptr<const void> contentOwner);
 	uint32_t readRawData (int8_t* buffer, uint32_t size) override;
 	void rewind () override;
+	const int8_t* getContent (uint32_t& size) override;
+	std::shared_ptr<const void> getContentOwner () override;
+protected:
+	std::shared_ptr<const void> contentOwner;
 };
 
 //-----------------------------------------------------------------------------
@@ -27,6 +33,8 @@ public:
 
 	uint32_t readRawData (int8_t* buffer, uint32_t size) override;
 	void rewind () override;
+	const int8_t* getContent (uint32_t& size) override;
+	std::shared_ptr<const void> getContentOwner () override;
 protected:
 	InputStream& stream;
 	int64_t startPos;
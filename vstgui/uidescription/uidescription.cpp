@@ -24,9 +24,14 @@
 #include "../lib/platform/std_unorderedmap.h"
 #include "../lib/platform/iplatformbitmap.h"
 #include "../lib/platform/iplatformfont.h"
+#include "../lib/platform/common/mappedfileresourceinputstream.h"
+#include "../lib/workerpool.h"
+#include "detail/bitmapfiltercache.h"
 #include "detail/locale.h"
 #include "detail/parsecolor.h"
 #include "detail/scalefactorutils.h"
+#include "detail/uibinarypersistence.h"
+#include "detail/uidescformat.h"
 #include "detail/uidesclist.h"
 #include "detail/uijsonpersistence.h"
 #include "detail/uinode.h"
@@ -36,7 +41,10 @@
 #include <fstream>
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <deque>
+#include <limits>
+#include <unordered_set>
 
 namespace VSTGUI {
 
@@ -76,6 +84,51 @@ static UIViewFactory* getGenericViewFactory ()
 
 IdStringPtr IUIDescription::kCustomViewName = "custom-view-name";
 
+namespace UIDescriptionPrivate {
+
+//-----------------------------------------------------------------------------
+/** an expression as used by calculateStringValue compiled to postfix order */
+struct CompiledExpression
+{
+	enum class Op : uint8_t
+	{
+		Number,
+		Variable,
+		Tag,
+		Negate,
+		Add,
+		Subtract,
+		Multiply,
+		Divide
+	};
+	struct Instruction
+	{
+		Op op;
+		double number {0.};
+		std::string name;
+	};
+
+	std::vector<Instruction> program;
+	bool valid {false};
+	bool usesTags {false};
+};
+
+static void compileExpression (const std::string& str, CompiledExpression& expression);
+
+//-----------------------------------------------------------------------------
+/** the cached value of a numeric variable and the variables which depend on it */
+struct VariableState
+{
+	SharedPointer<Detail::UINode> node;
+	bool evaluated {false};
+	bool evaluating {false};
+	bool success {false};
+	double value {0.};
+	std::vector<std::string> dependents;
+};
+
+} // UIDescriptionPrivate
+
 //-----------------------------------------------------------------------------
 struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 {
@@ -89,6 +142,14 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 	IContentProvider* contentProvider {nullptr};
 	IBitmapCreator* bitmapCreator { nullptr};
 	IBitmapCreator2* bitmapCreator2 { nullptr};
+	std::string bitmapFilterCachePath;
+	uint64_t bitmapFilterCacheRevision {0};
+
+	std::shared_ptr<WorkerPool> prefetchPool;
+	bool lazyTemplates {false};
+	uint32_t createViewDepth {0};
+	CreateViewStatistics createViewStatistics;
+	ParseStatistics parseStatistics;
 
 	SharedPointer<UINode> nodes;
 	SharedPointer<UIDescription> sharedResources;
@@ -106,8 +167,276 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 		}
 		return *variableBaseNode;
 	}
+
+	/** reverse lookup of resource names, the nodes are bucketed by a key computed from their
+	 *	resource objects and the index is rebuilt whenever the revision of the list changes */
+	struct NameIndex
+	{
+		const Detail::UIDescList* list {nullptr};
+		uint64_t revision {0};
+		uint64_t dependencyRevision {0};
+		std::unordered_map<size_t, std::vector<UINode*>> nodes;
+	};
+
+	static constexpr size_t kMaxCompiledExpressions = 4096;
+
+	using CompiledExpressionPtr = std::shared_ptr<const UIDescriptionPrivate::CompiledExpression>;
+
+	/** caches of the compiled expressions and the variable values. They are changed by const
+	 *	methods of UIDescription and like the rest of the description they must only be used from
+	 *	one thread. */
+	mutable std::unordered_map<std::string, CompiledExpressionPtr> expressions;
+	mutable std::unordered_map<std::string, UIDescriptionPrivate::VariableState> variables;
+	mutable const Detail::UIDescList* variablesList {nullptr};
+	mutable uint64_t variablesRevision {0};
+
+	/** the cache may be cleared while an expression is evaluated, as evaluating it can compile
+	 *	other expressions, so the caller shares the ownership of the returned expression */
+	CompiledExpressionPtr getCompiledExpression (const std::string& str) const
+	{
+		auto it = expressions.find (str);
+		if (it != expressions.end ())
+			return it->second;
+		if (expressions.size () >= kMaxCompiledExpressions)
+			expressions.clear ();
+		auto expression = std::make_shared<UIDescriptionPrivate::CompiledExpression> ();
+		UIDescriptionPrivate::compileExpression (str, *expression);
+		expressions.emplace (str, expression);
+		return expression;
+	}
+
+	bool evaluateExpression (const UIDescription* desc,
+							 const UIDescriptionPrivate::CompiledExpression& expression,
+							 double& result);
+
+	void invalidateVariable (const std::string& name)
+	{
+		auto it = variables.find (name);
+		if (it == variables.end () || !it->second.evaluated)
+			return;
+		it->second.evaluated = false;
+		auto dependents = std::move (it->second.dependents);
+		it->second.dependents.clear ();
+		for (const auto& dependent : dependents)
+			invalidateVariable (dependent);
+	}
+
+	/** invalidate the cached values of variables whose node has changed and their dependents */
+	void syncVariables (const UIDescription* desc)
+	{
+		auto baseNode = getVariableBaseNode ();
+		const Detail::UIDescList* list = baseNode ? &baseNode->getChildren () : nullptr;
+		auto revision = list ? list->getRevision () : 0;
+		if (list == variablesList && revision == variablesRevision)
+			return;
+		variablesList = list;
+		variablesRevision = revision;
+		std::vector<std::string> changed;
+		for (const auto& it : variables)
+		{
+			if (it.second.evaluated &&
+				desc->findChildNodeByNameAttribute (baseNode, it.first.data ()) != it.second.node)
+				changed.emplace_back (it.first);
+		}
+		for (const auto& name : changed)
+			invalidateVariable (name);
+	}
+
+	NameIndex colorNames;
+	NameIndex fontNames;
+	NameIndex bitmapNames;
+	NameIndex gradientNames;
+	NameIndex tagNames;
+
+	template<typename NodeType, typename NodeKeyFunction, typename MatchFunction>
+	UTF8StringPtr lookupName (const UIDescription* desc, NameIndex& index, IdStringPtr mainNodeName,
+							  size_t key, NodeKeyFunction nodeKey, MatchFunction match,
+							  uint64_t dependencyRevision = 0)
+	{
+		UINode* baseNode = desc->getBaseNode (mainNodeName);
+		if (!baseNode)
+			return nullptr;
+		auto& children = baseNode->getChildren ();
+		if (index.list != &children || index.revision != children.getRevision () ||
+			index.dependencyRevision != dependencyRevision)
+		{
+			index.nodes.clear ();
+			for (const auto& itNode : children)
+			{
+				size_t nodeKeyValue;
+				auto* node = dynamic_cast<NodeType*> (itNode);
+				if (node && nodeKey (node, nodeKeyValue))
+					index.nodes[nodeKeyValue].emplace_back (node);
+			}
+			index.list = &children;
+			index.revision = children.getRevision ();
+			index.dependencyRevision = dependencyRevision;
+		}
+		auto it = index.nodes.find (key);
+		if (it == index.nodes.end ())
+			return nullptr;
+		// the nodes are in list order, so the first match is the same a linear search would find
+		for (auto& node : it->second)
+		{
+			if (match (static_cast<NodeType*> (node)))
+			{
+				const std::string* name = node->getAttributes ()->getAttributeValue ("name");
+				return name ? name->c_str () : nullptr;
+			}
+		}
+		return nullptr;
+	}
+
+	template<typename NodeType>
+	static void collectNamedNodes (UINode* baseNode,
+								   std::unordered_map<std::string, NodeType*>& nodeMap)
+	{
+		if (baseNode == nullptr)
+			return;
+		for (auto& child : baseNode->getChildren ())
+		{
+			auto node = dynamic_cast<NodeType*> (child);
+			auto name = child->getAttributes ()->getAttributeValue ("name");
+			if (node && name)
+				nodeMap.emplace (*name, node);
+		}
+	}
+
+	/** decode the bitmaps and create the fonts and gradients referenced by the views of
+	 *	templateNode and the templates it includes.
+	 *
+	 *	Any attribute value which is the name of a bitmap, font or gradient is taken as a
+	 *	reference, a bitmap reference includes the scaled versions of the bitmap. The bitmaps are
+	 *	decoded in parallel, the fonts are created on the calling thread afterwards as creating
+	 *	platform fonts is not thread safe on all platforms.
+	 */
+	void prefetchResources (const UIDescription* desc, UINode* templateNode)
+	{
+		using Detail::UIBitmapNode;
+		using Detail::UIFontNode;
+		using Detail::UIGradientNode;
+
+		std::unordered_map<std::string, UIBitmapNode*> bitmapNodes;
+		std::unordered_map<std::string, std::vector<UIBitmapNode*>> scaledBitmapNodes;
+		if (auto baseNode = desc->getBaseNode (Detail::MainNodeNames::kBitmap))
+		{
+			for (auto& child : baseNode->getChildren ())
+			{
+				auto node = dynamic_cast<UIBitmapNode*> (child);
+				auto name = child->getAttributes ()->getAttributeValue ("name");
+				if (node == nullptr || name == nullptr)
+					continue;
+				bitmapNodes.emplace (*name, node);
+				scaledBitmapNodes[Detail::removeScaleFactorFromName (*name)].emplace_back (node);
+			}
+		}
+		std::unordered_map<std::string, UIFontNode*> fontNodes;
+		std::unordered_map<std::string, UIGradientNode*> gradientNodes;
+		collectNamedNodes (desc->getBaseNode (Detail::MainNodeNames::kFont), fontNodes);
+		collectNamedNodes (desc->getBaseNode (Detail::MainNodeNames::kGradient), gradientNodes);
+
+		std::vector<UIBitmapNode*> bitmaps;
+		std::vector<UIFontNode*> fonts;
+		std::unordered_set<UINode*> referenced;
+		std::unordered_set<std::string> visitedTemplates;
+		auto numGradients = 0u;
+
+		std::function<void (UINode*)> collectReferences = [&] (UINode* node) {
+			for (const auto& attr : *node->getAttributes ())
+			{
+				const auto& value = attr.second;
+				if (attr.first == Detail::MainNodeNames::kTemplate)
+				{
+					if (!visitedTemplates.emplace (value).second || !nodes)
+						continue;
+					for (auto& child : nodes->getChildren ())
+					{
+						auto name = child->getAttributes ()->getAttributeValue ("name");
+						if (child->getName () == Detail::MainNodeNames::kTemplate && name &&
+						    *name == value)
+						{
+							collectReferences (child);
+							break;
+						}
+					}
+				}
+				else if (bitmapNodes.find (value) != bitmapNodes.end ())
+				{
+					for (auto bitmapNode :
+					     scaledBitmapNodes[Detail::removeScaleFactorFromName (value)])
+					{
+						if (!bitmapNode->hasBitmap () && referenced.emplace (bitmapNode).second)
+							bitmaps.emplace_back (bitmapNode);
+					}
+				}
+				else
+				{
+					auto font = fontNodes.find (value);
+					if (font != fontNodes.end ())
+					{
+						if (referenced.emplace (font->second).second)
+							fonts.emplace_back (font->second);
+						continue;
+					}
+					auto gradient = gradientNodes.find (value);
+					if (gradient != gradientNodes.end () &&
+					    referenced.emplace (gradient->second).second)
+					{
+						gradient->second->getGradient ();
+						++numGradients;
+					}
+				}
+			}
+			for (auto& child : node->getChildren ())
+			{
+				if (child->getName () == "view")
+					collectReferences (child);
+			}
+		};
+		collectReferences (templateNode);
+
+		std::vector<SharedPointer<CBitmap>> decodedBitmaps (bitmaps.size ());
+		auto numTasks = static_cast<uint32_t> (bitmaps.size ());
+		auto task = [&] (uint32_t index) {
+			decodedBitmaps[index] = bitmaps[index]->decodeBitmap (filePath);
+		};
+		if (numTasks > 1)
+			prefetchPool->parallelFor (numTasks, WorkerPool::kMaxThreads, task);
+		else if (numTasks == 1)
+			task (0);
+		for (auto index = 0u; index < bitmaps.size (); ++index)
+			bitmaps[index]->setDecodedBitmap (decodedBitmaps[index]);
+		for (auto fontNode : fonts)
+		{
+			if (auto font = fontNode->getFont ())
+				font->getPlatformFont ();
+		}
+
+		createViewStatistics.numPrefetchedBitmaps = static_cast<uint32_t> (bitmaps.size ());
+		createViewStatistics.numPrefetchedFonts = static_cast<uint32_t> (fonts.size ());
+		createViewStatistics.numPrefetchedGradients = numGradients;
+	}
 };
 
+//-----------------------------------------------------------------------------
+static size_t colorKey (const CColor& color)
+{
+	return (static_cast<size_t> (color.red) << 24) | (static_cast<size_t> (color.green) << 16) |
+		   (static_cast<size_t> (color.blue) << 8) | static_cast<size_t> (color.alpha);
+}
+
+//-----------------------------------------------------------------------------
+static size_t colorStopsKey (const CGradient::ColorStopMap& colorStops)
+{
+	size_t key = colorStops.size ();
+	for (const auto& stop : colorStops)
+	{
+		key = key * 31 + std::hash<double> () (stop.first);
+		key = key * 31 + colorKey (stop.second);
+	}
+	return key;
+}
+
 //-----------------------------------------------------------------------------
 UIDescription::UIDescription (const CResourceDescription& uidescFile, IViewFactory* _viewFactory)
 {
@@ -246,15 +575,41 @@ bool UIDescription::parse ()
 	if (parsed ())
 		return true;
 		
-	static auto parseUIDesc = [] (IContentProvider* contentProvider) -> SharedPointer<UINode> {
-		if (auto nodes = Detail::UIJsonDescReader::read (*contentProvider))
-			return nodes;
+	auto parseUIDesc = [this] (IContentProvider* contentProvider) -> SharedPointer<UINode> {
+		using Clock = std::chrono::steady_clock;
+		auto start = Clock::now ();
+		SharedPointer<UINode> nodes;
+		auto format = Detail::detectUIDescFormat (*contentProvider);
+		switch (format)
+		{
+			case Format::Binary:
+			{
+				nodes = Detail::UIBinaryDescReader::read (*contentProvider, impl->lazyTemplates);
+				break;
+			}
+			case Format::JSON:
+			{
+				nodes = Detail::UIJsonDescReader::read (*contentProvider);
+				break;
+			}
+			case Format::XML:
+			{
 #if VSTGUI_ENABLE_XML_PARSER
-		Detail::UIXMLParser parser;
-		if (auto nodes = parser.parse (contentProvider))
-			return nodes;
+				Detail::UIXMLParser parser;
+				nodes = parser.parse (contentProvider);
+#elif DEBUG
+				DebugPrint ("XML not available.");
 #endif
-		return nullptr;
+				break;
+			}
+			case Format::Compressed:
+			case Format::Unknown:
+				break;
+		}
+		impl->parseStatistics.format = format;
+		impl->parseStatistics.parseMicroseconds = static_cast<uint64_t> (
+		    std::chrono::duration_cast<std::chrono::microseconds> (Clock::now () - start).count ());
+		return nodes;
 	};
 
 	if (impl->contentProvider)
@@ -279,21 +634,38 @@ bool UIDescription::parse ()
 		}
 		else if (impl->uidescFile.type == CResourceDescription::kStringType)
 		{
-			CFileStream fileStream;
-			if (fileStream.open (impl->uidescFile.u.name, CFileStream::kReadMode))
+			uint64_t size = 0;
+			std::shared_ptr<IPlatformResourceInputStream> mappedFile =
+			    MappedFileResourceInputStream::create (impl->uidescFile.u.name);
+			auto memory = mappedFile ? mappedFile->getMemory (size) : nullptr;
+			if (memory && size <= std::numeric_limits<uint32_t>::max ())
 			{
-				InputStreamContentProvider contentProvider (fileStream);
+				MemoryContentProvider contentProvider (memory, static_cast<uint32_t> (size),
+				                                       mappedFile);
 				if ((impl->nodes = parseUIDesc (&contentProvider)))
 				{
 					addDefaultNodes ();
 					return true;
 				}
 			}
+			else
+			{
+				CFileStream fileStream;
+				if (fileStream.open (impl->uidescFile.u.name, CFileStream::kReadMode))
+				{
+					InputStreamContentProvider contentProvider (fileStream);
+					if ((impl->nodes = parseUIDesc (&contentProvider)))
+					{
+						addDefaultNodes ();
+						return true;
+					}
+				}
+			}
 		}
 	}
 	if (!impl->nodes)
 	{
-		impl->nodes = makeOwned<UINode> ("vstgui-ui-description");
+		impl->nodes = makeOwned<UINode> ("vstgui-ui-description", nullptr, true);
 		addDefaultNodes ();
 	}
 	return false;
@@ -341,6 +713,40 @@ void UIDescription::setBitmapCreator2 (IBitmapCreator2* creator)
 	impl->bitmapCreator2 = creator;
 }
 
+//------------------------------------------------------------------------
+void UIDescription::setBitmapFilterCachePath (UTF8StringPtr path, uint64_t bitmapsRevision)
+{
+	impl->bitmapFilterCachePath = path ? path : "";
+	impl->bitmapFilterCacheRevision = bitmapsRevision;
+}
+
+//------------------------------------------------------------------------
+void UIDescription::setPrefetchTemplateResources (bool state)
+{
+	if (state == false)
+		impl->prefetchPool = nullptr;
+	else if (!impl->prefetchPool)
+		impl->prefetchPool = WorkerPool::get ();
+}
+
+//------------------------------------------------------------------------
+void UIDescription::setLazyTemplates (bool state)
+{
+	impl->lazyTemplates = state;
+}
+
+//------------------------------------------------------------------------
+auto UIDescription::getCreateViewStatistics () const -> const CreateViewStatistics&
+{
+	return impl->createViewStatistics;
+}
+
+//------------------------------------------------------------------------
+auto UIDescription::getParseStatistics () const -> const ParseStatistics&
+{
+	return impl->parseStatistics;
+}
+
 //-----------------------------------------------------------------------------
 static void FreeNodePlatformResources (Detail::UINode* node)
 {
@@ -349,6 +755,7 @@ static void FreeNodePlatformResources (Detail::UINode* node)
 		child->freePlatformResources ();
 		FreeNodePlatformResources (child);
 	}
+	node->getChildren ().markChanged ();
 }
 
 //-----------------------------------------------------------------------------
@@ -418,7 +825,10 @@ bool UIDescription::save (UTF8StringPtr filename, int32_t flags)
 	std::string oldName = moveOldFile (filename);
 	bool result = false;
 	CFileStream stream;
-	if (stream.open (filename, CFileStream::kWriteMode|CFileStream::kTruncateMode))
+	int32_t mode = CFileStream::kWriteMode | CFileStream::kTruncateMode;
+	if (flags & kWriteAsBinary)
+		mode |= CFileStream::kBinaryMode;
+	if (stream.open (filename, mode))
 	{
 		result = saveToStream (stream, flags);
 	}
@@ -467,6 +877,8 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags)
 	}
 	impl->nodes->getAttributes ()->setAttribute ("version", "1");
 	
+	if (flags & kWriteAsBinary)
+		return Detail::UIBinaryDescWriter::write (stream, impl->nodes);
 	BufferedOutputStream bufferedStream (stream);
 	if (flags & kWriteAsXML)
 	{
@@ -753,9 +1165,30 @@ CView* UIDescription::createView (UTF8StringPtr name, IController* _controller)
 				const std::string* nodeName = itNode->getAttributes ()->getAttributeValue ("name");
 				if (nodeName && *nodeName == name)
 				{
+					using Clock = std::chrono::steady_clock;
+					auto microseconds = [] (Clock::duration d) {
+						return static_cast<uint64_t> (
+						    std::chrono::duration_cast<std::chrono::microseconds> (d).count ());
+					};
+					// templates included by this template are prefetched and timed with it
+					bool isOuterTemplate = impl->createViewDepth++ == 0;
+					auto start = Clock::now ();
+					if (isOuterTemplate)
+					{
+						impl->createViewStatistics = {};
+						if (impl->prefetchPool)
+							impl->prefetchResources (this, itNode);
+					}
+					auto buildStart = Clock::now ();
 					CView* view = createViewFromNode (itNode);
 					if (view)
 						view->setAttribute (kTemplateNameAttributeID, static_cast<uint32_t> (strlen (name) + 1), name);
+					if (--impl->createViewDepth == 0)
+					{
+						auto end = Clock::now ();
+						impl->createViewStatistics.prefetchMicroseconds = microseconds (buildStart - start);
+						impl->createViewStatistics.buildMicroseconds = microseconds (end - buildStart);
+					}
 					return view;
 				}
 			}
@@ -818,7 +1251,7 @@ Detail::UINode* UIDescription::getBaseNode (UTF8StringPtr name) const
 		if (node)
 			return node;
 
-		node = new UINode (name);
+		node = new UINode (name, nullptr, true);
 		impl->nodes->getChildren ().add (node);
 		return node;
 	}
@@ -936,7 +1369,15 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 		}
 		if (bitmap && bitmapNode->getFilterProcessed () == false)
 		{
-			std::list<SharedPointer<BitmapFilter::IFilter> > filters;
+			BitmapFilter::Pipeline pipeline;
+			// identifies the filters and their settings for the cache
+			std::string filterDescription;
+			auto describe = [&] (const std::string& name, const void* value, size_t size) {
+				filterDescription += name;
+				filterDescription += '=';
+				filterDescription.append (static_cast<const char*> (value), size);
+				filterDescription += ';';
+			};
 			for (auto& childNode : bitmapNode->getChildren ())
 			{
 				const std::string* filterName = nullptr;
@@ -945,7 +1386,9 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 					auto filter = owned (BitmapFilter::Factory::getInstance().createFilter (filterName->c_str ()));
 					if (filter == nullptr)
 						continue;
-					filters.emplace_back (filter);
+					pipeline.addFilter (filter);
+					filterDescription += *filterName;
+					filterDescription += '{';
 					for (auto& propertyNode : childNode->getChildren ())
 					{
 						if (propertyNode->getName () != "property")
@@ -959,28 +1402,40 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 							{
 								int32_t intValue;
 								if (propertyNode->getAttributes ()->getIntegerAttribute ("value", intValue))
+								{
 									filter->setProperty (propName->c_str (), intValue);
+									describe (*propName, &intValue, sizeof (intValue));
+								}
 								break;
 							}
 							case BitmapFilter::Property::kFloat:
 							{
 								double floatValue;
 								if (propertyNode->getAttributes ()->getDoubleAttribute ("value", floatValue))
+								{
 									filter->setProperty (propName->c_str (), floatValue);
+									describe (*propName, &floatValue, sizeof (floatValue));
+								}
 								break;
 							}
 							case BitmapFilter::Property::kPoint:
 							{
 								CPoint pointValue;
 								if (propertyNode->getAttributes ()->getPointAttribute ("value", pointValue))
+								{
 									filter->setProperty (propName->c_str (), pointValue);
+									describe (*propName, &pointValue, sizeof (pointValue));
+								}
 								break;
 							}
 							case BitmapFilter::Property::kRect:
 							{
 								CRect rectValue;
 								if (propertyNode->getAttributes ()->getRectAttribute ("value", rectValue))
+								{
 									filter->setProperty (propName->c_str (), rectValue);
+									describe (*propName, &rectValue, sizeof (rectValue));
+								}
 								break;
 							}
 							case BitmapFilter::Property::kColor:
@@ -990,7 +1445,10 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 								{
 									CColor color;
 									if (getColor (colorString->c_str (), color))
+									{
 										filter->setProperty(propName->c_str (), color);
+										describe (*propName, &color, sizeof (color));
+									}
 								}
 								break;
 							}
@@ -1004,18 +1462,39 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 								break;
 						}
 					}
+					filterDescription += '}';
 				}
 			}
-			for (auto& filter : filters)
+			if (!pipeline.empty ())
 			{
-				filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-				if (filter->run ())
+				Detail::BitmapFilterCache::Key cacheKey;
+				const std::string* path = bitmapNode->getAttributes ()->getAttributeValue ("path");
+				bool useCache = !impl->bitmapFilterCachePath.empty () && path;
+				if (useCache)
 				{
-					auto obj = filter->getProperty (BitmapFilter::Standard::Property::kOutputBitmap).getObject ();
-					if (auto* outputBitmap = dynamic_cast<CBitmap*>(obj))
-					{
-						bitmap->setPlatformBitmap (outputBitmap->getPlatformBitmap ());
-					}
+					Detail::BitmapFilterCache::Source source;
+					source.bitmapName = name;
+					source.path = *path;
+					source.revision = impl->bitmapFilterCacheRevision;
+					// bitmaps of a bitmap creator may not have a readable source, then only the
+					// revision identifies the content
+					Detail::BitmapFilterCache::hashContent (bitmap->getResourceDescription (),
+					                                        source.contentHash);
+					useCache = Detail::BitmapFilterCache::makeKey (source, filterDescription,
+					                                               bitmap, cacheKey);
+				}
+				PlatformBitmapPtr cachedBitmap;
+				if (useCache)
+					cachedBitmap = Detail::BitmapFilterCache::load (impl->bitmapFilterCachePath, cacheKey);
+				if (cachedBitmap)
+				{
+					bitmap->setPlatformBitmap (cachedBitmap);
+				}
+				else if (auto outputBitmap = pipeline.run (bitmap))
+				{
+					bitmap->setPlatformBitmap (outputBitmap->getPlatformBitmap ());
+					if (useCache)
+						Detail::BitmapFilterCache::store (impl->bitmapFilterCachePath, cacheKey, outputBitmap);
 				}
 			}
 			bitmapNode->setFilterProcessed ();
@@ -1088,71 +1567,108 @@ CGradient* UIDescription::getGradient (UTF8StringPtr name) const
 	return nullptr;
 }
 
-//-----------------------------------------------------------------------------
-template<typename NodeType, typename ObjType, typename CompareFunction> UTF8StringPtr UIDescription::lookupName (const ObjType& obj, IdStringPtr mainNodeName, CompareFunction compare) const
-{
-	UINode* baseNode = getBaseNode (mainNodeName);
-	if (baseNode)
-	{
-		auto& children = baseNode->getChildren ();
-		for (const auto& itNode : children)
-		{
-			auto* node = dynamic_cast<NodeType*>(itNode);
-			if (node && compare (this, node, obj))
-			{
-				const std::string* name = node->getAttributes ()->getAttributeValue ("name");
-				return name ? name->c_str () : nullptr;
-			}
-		}
-	}
-	return nullptr;
-}
-
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupColorName (const CColor& color) const
 {
-	return lookupName<Detail::UIColorNode> (color, Detail::MainNodeNames::kColor, [] (const UIDescription* desc, Detail::UIColorNode* node, const CColor& color) {
-		return node->getColor() == color;
-	});
+	return impl->lookupName<Detail::UIColorNode> (
+		this, impl->colorNames, Detail::MainNodeNames::kColor, colorKey (color),
+		[] (Detail::UIColorNode* node, size_t& key) {
+			key = colorKey (node->getColor ());
+			return true;
+		},
+		[&] (Detail::UIColorNode* node) { return node->getColor () == color; });
 }
 
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupFontName (const CFontRef font) const
 {
-	return font ? lookupName<Detail::UIFontNode> (font, Detail::MainNodeNames::kFont, [] (const UIDescription* desc, Detail::UIFontNode* node, const CFontRef& font) {
-		return node->getFont () && node->getFont () == font;
-	}) : nullptr;
+	if (!font)
+		return nullptr;
+	return impl->lookupName<Detail::UIFontNode> (
+		this, impl->fontNames, Detail::MainNodeNames::kFont, std::hash<const CFontDesc*> () (font),
+		[] (Detail::UIFontNode* node, size_t& key) {
+			if (auto nodeFont = node->getFont ())
+			{
+				key = std::hash<const CFontDesc*> () (nodeFont);
+				return true;
+			}
+			return false;
+		},
+		[&] (Detail::UIFontNode* node) { return node->getFont () == font; });
 }
 
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupBitmapName (const CBitmap* bitmap) const
 {
-	return bitmap ? lookupName<Detail::UIBitmapNode> (bitmap, Detail::MainNodeNames::kBitmap, [] (const UIDescription* desc, Detail::UIBitmapNode* node, const CBitmap* bitmap) {
-		return node->getBitmap (desc->impl->filePath) == bitmap;
-	}) : nullptr;
+	if (!bitmap)
+		return nullptr;
+	// the bitmap of a node is created with a resource description pointing to the path attribute
+	// of the node, so the nodes are keyed by the address of that attribute. Building the index
+	// this way does not load any bitmaps and only bitmaps already loaded can match.
+	const auto& desc = bitmap->getResourceDescription ();
+	if (desc.type != CResourceDescription::kStringType || desc.u.name == nullptr)
+		return nullptr;
+	return impl->lookupName<Detail::UIBitmapNode> (
+		this, impl->bitmapNames, Detail::MainNodeNames::kBitmap,
+		std::hash<const void*> () (desc.u.name),
+		[] (Detail::UIBitmapNode* node, size_t& key) {
+			if (auto path = node->getAttributes ()->getAttributeValue ("path"))
+			{
+				key = std::hash<const void*> () (path->c_str ());
+				return true;
+			}
+			return false;
+		},
+		[&] (Detail::UIBitmapNode* node) {
+			return node->hasBitmap () && node->getBitmap (impl->filePath) == bitmap;
+		});
 }
 
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupGradientName (const CGradient* gradient) const
 {
-	return gradient ? lookupName<Detail::UIGradientNode> (gradient, Detail::MainNodeNames::kGradient, [] (const UIDescription* desc, Detail::UIGradientNode* node, const CGradient* gradient) {
-		return node->getGradient() == gradient || (node->getGradient () && gradient->getColorStops () == node->getGradient ()->getColorStops ());
-	}) : nullptr;
+	if (!gradient)
+		return nullptr;
+	// gradients with the same color stops are equal, so they are keyed by their color stops
+	return impl->lookupName<Detail::UIGradientNode> (
+		this, impl->gradientNames, Detail::MainNodeNames::kGradient,
+		colorStopsKey (gradient->getColorStops ()),
+		[] (Detail::UIGradientNode* node, size_t& key) {
+			if (auto nodeGradient = node->getGradient ())
+			{
+				key = colorStopsKey (nodeGradient->getColorStops ());
+				return true;
+			}
+			return false;
+		},
+		[&] (Detail::UIGradientNode* node) {
+			return node->getGradient () == gradient ||
+				   (node->getGradient () &&
+					gradient->getColorStops () == node->getGradient ()->getColorStops ());
+		});
 }
 	
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupControlTagName (const int32_t tag) const
 {
-	return lookupName<Detail::UIControlTagNode> (tag, Detail::MainNodeNames::kControlTag, [] (const UIDescription* desc, Detail::UIControlTagNode* node, const int32_t tag) {
-		int32_t nodeTag = node->getTag ();
-		if (nodeTag == -1 && node->getTagString ())
-		{
-			double v;
-			if (desc->calculateStringValue (node->getTagString ()->c_str (), v))
-				nodeTag = (int32_t)v;
-		}
-		return nodeTag == tag;
-	});
+	// tag strings may use variables, so the index depends on the variables, too
+	auto variableBaseNode = impl->getVariableBaseNode ();
+	auto variablesRevision = variableBaseNode ? variableBaseNode->getChildren ().getRevision () : 0;
+	return impl->lookupName<Detail::UIControlTagNode> (
+		this, impl->tagNames, Detail::MainNodeNames::kControlTag,
+		static_cast<size_t> (static_cast<uint32_t> (tag)),
+		[this] (Detail::UIControlTagNode* node, size_t& key) {
+			int32_t nodeTag = node->getTag ();
+			if (nodeTag == -1 && node->getTagString ())
+			{
+				double v;
+				if (calculateStringValue (node->getTagString ()->c_str (), v))
+					nodeTag = (int32_t)v;
+			}
+			key = static_cast<size_t> (static_cast<uint32_t> (nodeTag));
+			return true;
+		},
+		[] (Detail::UIControlTagNode* node) { return true; }, variablesRevision);
 }
 
 //-----------------------------------------------------------------------------
@@ -1163,8 +1679,9 @@ void UIDescription::changeNodeName (UTF8StringPtr oldName, UTF8StringPtr newName
 	auto* node = dynamic_cast<NodeType*> (findChildNodeByNameAttribute(mainNode, oldName));
 	if (node)
 	{
+		std::string oldNameStr (oldName);
 		node->getAttributes ()->setAttribute ("name", newName);
-		mainNode->childAttributeChanged (node, "name", oldName);
+		mainNode->childAttributeChanged (node, "name", oldNameStr.data ());
 		mainNode->sortChildren ();
 	}
 }
@@ -1224,6 +1741,7 @@ void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 		if (!node->noExport ())
 		{
 			node->setColor (newColor);
+			colorsNode->getChildren ().markChanged ();
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescColorChanged (this);
 			});
@@ -1258,6 +1776,7 @@ void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 		if (!node->noExport ())
 		{
 			node->setFont (newFont);
+			fontsNode->getChildren ().markChanged ();
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescFontChanged (this);
 			});
@@ -1290,6 +1809,7 @@ void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 		if (!node->noExport ())
 		{
 			node->setGradient (newGradient);
+			gradientsNode->getChildren ().markChanged ();
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescGradientChanged (this);
 			});
@@ -1323,6 +1843,7 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 		{
 			node->setBitmap (newName);
 			node->setNinePartTiledOffset (nineparttiledOffset);
+			bitmapsNode->getChildren ().markChanged ();
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescBitmapChanged (this);
 			});
@@ -1350,7 +1871,8 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::list<SharedPointer<UIAttributes> >& filters)
 {
-	auto* bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (Detail::MainNodeNames::kBitmap), bitmapName));
+	UINode* bitmapsNode = getBaseNode (Detail::MainNodeNames::kBitmap);
+	auto* bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, bitmapName));
 	if (bitmapNode)
 	{
 		bitmapNode->getChildren().removeAll ();
@@ -1373,6 +1895,7 @@ void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::li
 			bitmapNode->getChildren ().add (filterNode);
 		}
 		bitmapNode->invalidBitmap ();
+		bitmapsNode->getChildren ().markChanged ();
 		impl->forEachListener ([this] (UIDescriptionListener* l) {
 			l->onUIDescBitmapChanged (this);
 		});
@@ -1726,7 +2249,9 @@ bool UIDescription::changeTemplateName (UTF8StringPtr name, UTF8StringPtr newNam
 	UINode* templateNode = findChildNodeByNameAttribute (impl->nodes, name);
 	if (templateNode)
 	{
+		std::string oldName (name);
 		templateNode->getAttributes()->setAttribute ("name", newName);
+		impl->nodes->childAttributeChanged (templateNode, "name", oldName.data ());
 		impl->forEachListener ([this] (UIDescriptionListener* l) {
 			l->onUIDescTemplateChanged (this);
 		});
@@ -1849,6 +2374,7 @@ bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::s
 		if (create)
 			return false;
 		controlTagNode->setTagString (newTagString);
+		tagsNode->getChildren ().markChanged ();
 		impl->forEachListener ([this](UIDescriptionListener* l) { l->onUIDescTagChanged (this); });
 		return true;
 	}
@@ -1874,26 +2400,69 @@ bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::s
 //-----------------------------------------------------------------------------
 bool UIDescription::getVariable (UTF8StringPtr name, double& value) const
 {
-	auto* node = dynamic_cast<Detail::UIVariableNode*> (
-	    findChildNodeByNameAttribute (impl->getVariableBaseNode (), name));
-	if (node)
+	impl->syncVariables (this);
+	auto it = impl->variables.find (name);
+	if (it == impl->variables.end ())
 	{
-		if (node->getType () == Detail::UIVariableNode::kNumber)
+		// only variables which exist are cached
+		if (!findChildNodeByNameAttribute (impl->getVariableBaseNode (), name))
+			return false;
+		it = impl->variables.emplace (name, UIDescriptionPrivate::VariableState ()).first;
+	}
+	auto& state = it->second;
+	if (!state.evaluated)
+	{
+		if (state.evaluating)
 		{
-			value = node->getNumber ();
-			return true;
+		#if DEBUG
+			DebugPrint ("Variable depends on itself :%s\n", name);
+		#endif
+			return false;
 		}
-		if (node->getType () == Detail::UIVariableNode::kString)
+		state.node = findChildNodeByNameAttribute (impl->getVariableBaseNode (), name);
+		state.success = false;
+		bool cacheable = true;
+		if (auto* node = dynamic_cast<Detail::UIVariableNode*> (state.node.get ()))
 		{
-			double v;
-			if (calculateStringValue (node->getString ().c_str (), v))
+			if (node->getType () == Detail::UIVariableNode::kNumber)
 			{
-				value = v;
-				return true;
+				state.value = node->getNumber ();
+				state.success = true;
+			}
+			else if (node->getType () == Detail::UIVariableNode::kString)
+			{
+				// the value is only cached when it does not depend on control tags, as those can
+				// be changed by the controller, neither directly nor through other variables
+				Detail::Locale localeResetter;
+				auto expression = impl->getCompiledExpression (node->getString ());
+				cacheable = !expression->usesTags;
+				state.evaluating = true;
+				double v;
+				state.success = impl->evaluateExpression (this, *expression, v);
+				state.evaluating = false;
+				if (state.success)
+					state.value = v;
+				for (const auto& instruction : expression->program)
+				{
+					if (instruction.op != UIDescriptionPrivate::CompiledExpression::Op::Variable)
+						continue;
+					auto dependency = impl->variables.find (instruction.name);
+					if (dependency == impl->variables.end () || !dependency->second.evaluated)
+					{
+						cacheable = false;
+						continue;
+					}
+					auto& dependents = dependency->second.dependents;
+					if (std::find (dependents.begin (), dependents.end (), name) == dependents.end ())
+						dependents.emplace_back (name);
+				}
 			}
 		}
+		state.evaluated = cacheable;
 	}
-	return false;
+	if (state.success)
+		value = state.value;
+	return state.success;
 }
 
 //-----------------------------------------------------------------------------
@@ -1908,6 +2477,24 @@ bool UIDescription::getVariable (UTF8StringPtr name, std::string& value) const
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+uint64_t UIDescription::getResourceRevision () const
+{
+	// list revisions are unique and increasing, so the maximum changes whenever one list changes
+	uint64_t revision = 0;
+	if (impl->nodes)
+	{
+		for (auto name : {Detail::MainNodeNames::kVariable, Detail::MainNodeNames::kColor})
+		{
+			if (auto node = impl->nodes->getChildren ().findChildNode (name))
+				revision = std::max (revision, node->getChildren ().getRevision ());
+		}
+	}
+	if (impl->sharedResources)
+		revision = std::max (revision, impl->sharedResources->getResourceRevision ());
+	return revision;
+}
+
 namespace UIDescriptionPrivate {
 
 using Locale = Detail::Locale;
@@ -2021,139 +2608,199 @@ static bool tokenizeString (std::string& str, StringTokenList& tokens)
 }
 
 //-----------------------------------------------------------------------------
-static bool computeTokens (StringTokenList& tokens, double& result)
+class ExpressionCompiler
 {
-	int32_t openCount = 0;
-	StringTokenList::iterator openPosition = tokens.end ();
-	// first check parentheses
-	for (StringTokenList::iterator it = tokens.begin (); it != tokens.end (); ++it)
+public:
+	using Op = CompiledExpression::Op;
+
+	ExpressionCompiler (const StringTokenList& tokens, CompiledExpression& expression)
+	: pos (tokens.begin ()), end (tokens.end ()), expression (expression)
 	{
-		if ((*it).type == StringToken::kOpenParenthesis)
+	}
+
+	bool compile ()
+	{
+		return compileSum () && pos == end;
+	}
+
+private:
+	bool isType (StringToken::Type type) const { return pos != end && pos->type == type; }
+
+	void emit (Op op) { expression.program.push_back ({op}); }
+
+	bool compileOperand ()
+	{
+		if (pos == end)
+			return false;
+		if (pos->type == StringToken::kOpenParenthesis)
 		{
-			openCount++;
-			if (openCount == 1)
-				openPosition = it;
+			++pos;
+			if (!compileSum () || !isType (StringToken::kCloseParenthesis))
+				return false;
+			++pos;
+			return true;
 		}
-		else if ((*it).type == StringToken::kCloseParenthesis)
+		if (pos->type != StringToken::kString)
+			return false;
+		const auto& token = *pos++;
+		const char* tokenStr = token.c_str ();
+		char* endPtr = nullptr;
+		double value = strtod (tokenStr, &endPtr);
+		if (endPtr == tokenStr + token.length ())
 		{
-			openCount--;
-			if (openCount == 0)
-			{
-				StringTokenList tmp (++openPosition, it);
-				double value = 0;
-				if (computeTokens (tmp, value))
-				{
-					--openPosition;
-					++it;
-					tokens.erase (openPosition, it);
-					tokens.insert (it, StringToken (StringToken::kResult, value));
-					if (it == tokens.end ())
-					{
-						break;
-					}
+			expression.program.push_back ({Op::Number, value});
+			return true;
+		}
+		// if it is not pure numeric it is a control tag or variable which is resolved on evaluation
+		if (token.find ("tag.") == 0)
+		{
+			expression.program.push_back ({Op::Tag, 0., token.substr (4)});
+			expression.usesTags = true;
+			return true;
+		}
+		if (token.find ("var.") == 0)
+		{
+			expression.program.push_back ({Op::Variable, 0., token.substr (4)});
+			return true;
+		}
+	#if DEBUG
+		DebugPrint("Substitution failed :%s\n", tokenStr);
+	#endif
+		return false;
+	}
 
-				}
-				else
-					return false;
-			}
+	bool compileProduct ()
+	{
+		if (!compileOperand ())
+			return false;
+		while (isType (StringToken::kMulitply) || isType (StringToken::kDivide))
+		{
+			auto op = pos->type == StringToken::kMulitply ? Op::Multiply : Op::Divide;
+			++pos;
+			if (!compileOperand ())
+				return false;
+			emit (op);
 		}
+		return true;
 	}
-	// now multiply and divide
-	StringTokenList::iterator prevToken = tokens.begin ();
-	for (StringTokenList::iterator it = tokens.begin (); it != tokens.end (); ++it)
+
+	bool compileSum ()
 	{
-		if (prevToken != it)
+		// a sign is only allowed in front of the first operand
+		bool negate = isType (StringToken::kSubtract);
+		if (negate || isType (StringToken::kAdd))
+			++pos;
+		if (!compileProduct ())
+			return false;
+		if (negate)
+			emit (Op::Negate);
+		while (isType (StringToken::kAdd) || isType (StringToken::kSubtract))
 		{
-			if ((*it).type == StringToken::kMulitply)
+			auto op = pos->type == StringToken::kAdd ? Op::Add : Op::Subtract;
+			++pos;
+			// a trailing operator is ignored
+			if (pos == end)
+				break;
+			if (!compileProduct ())
+				return false;
+			emit (op);
+		}
+		return true;
+	}
+
+	StringTokenList::const_iterator pos;
+	StringTokenList::const_iterator end;
+	CompiledExpression& expression;
+};
+
+//-----------------------------------------------------------------------------
+static void compileExpression (const std::string& str, CompiledExpression& expression)
+{
+	std::string tmp (str);
+	StringTokenList tokens;
+	expression.program.clear ();
+	expression.usesTags = false;
+	expression.valid = tokenizeString (tmp, tokens) && ExpressionCompiler (tokens, expression).compile ();
+#if DEBUG
+	if (!expression.valid)
+		DebugPrint("Compiling expression failed :%s\n", str.data ());
+#endif
+}
+
+} // UIDescriptionPrivate
+
+//-----------------------------------------------------------------------------
+bool UIDescription::Impl::evaluateExpression (const UIDescription* desc,
+											 const UIDescriptionPrivate::CompiledExpression& expression,
+											 double& result)
+{
+	using Op = UIDescriptionPrivate::CompiledExpression::Op;
+
+	if (!expression.valid)
+		return false;
+	std::vector<double> stack;
+	stack.reserve (expression.program.size ());
+	for (const auto& instruction : expression.program)
+	{
+		switch (instruction.op)
+		{
+			case Op::Number:
 			{
-				if ((*prevToken).type == StringToken::kResult)
-				{
-					++it;
-					if ((*it).type == StringToken::kResult)
-					{
-						double value = (*prevToken).result * (*it).result;
-						++it;
-						tokens.erase (prevToken, it);
-						tokens.insert (it, StringToken (StringToken::kResult, value));
-						--it;
-						prevToken = it;
-					}
-					else
-					{
-						return false;
-					}
-				}
-				else
+				stack.emplace_back (instruction.number);
+				break;
+			}
+			case Op::Tag:
+			{
+				double value = desc->getTagForName (instruction.name.data ());
+				if (value == -1)
 				{
+				#if DEBUG
+					DebugPrint("Tag not found :tag.%s\n", instruction.name.data ());
+				#endif
 					return false;
 				}
+				stack.emplace_back (value);
+				break;
 			}
-			else if ((*it).type == StringToken::kDivide)
+			case Op::Variable:
 			{
-				if ((*prevToken).type == StringToken::kResult)
-				{
-					++it;
-					if ((*it).type == StringToken::kResult)
-					{
-						double value = (*prevToken).result / (*it).result;
-						++it;
-						tokens.erase (prevToken, it);
-						tokens.insert (it, StringToken (StringToken::kResult, value));
-						--it;
-						prevToken = it;
-					}
-					else
-					{
-						return false;
-					}
-				}
-				else
+				double value;
+				if (!desc->getVariable (instruction.name.data (), value))
 				{
+				#if DEBUG
+					DebugPrint("Variable not found :var.%s\n", instruction.name.data ());
+				#endif
 					return false;
 				}
+				stack.emplace_back (value);
+				break;
 			}
-			else
+			case Op::Negate:
 			{
-				prevToken = it;
+				stack.back () = -stack.back ();
+				break;
 			}
-		}
-	}
-	// now add and subtract
-	int32_t lastType = -1;
-	for (StringTokenList::const_iterator it = tokens.begin (); it != tokens.end (); ++it)
-	{
-		if ((*it).type == UIDescriptionPrivate::StringToken::kResult)
-		{
-			double value = (*it).result;
-			if (lastType == -1)
-				result = value;
-			else if (lastType == StringToken::kAdd)
-				result += value;
-			else if (lastType == StringToken::kSubtract)
-				result -= value;
-			else
+			default:
 			{
-			#if DEBUG
-				DebugPrint ("Wrong Expression: %d\n", (*it).type);
-			#endif
-				return false;
+				auto rhs = stack.back ();
+				stack.pop_back ();
+				auto& lhs = stack.back ();
+				if (instruction.op == Op::Add)
+					lhs += rhs;
+				else if (instruction.op == Op::Subtract)
+					lhs -= rhs;
+				else if (instruction.op == Op::Multiply)
+					lhs *= rhs;
+				else
+					lhs /= rhs;
+				break;
 			}
 		}
-		else if (!(lastType == -1 || lastType == UIDescriptionPrivate::StringToken::kResult))
-		{
-		#if DEBUG
-			DebugPrint ("Wrong Expression: %d\n", (*it).type);
-		#endif
-			return false;
-		}
-		lastType = (*it).type;
-		
 	}
+	result = stack.back ();
 	return true;
 }
 
-} // UIDescriptionPrivate
-
 //-----------------------------------------------------------------------------
 bool UIDescription::calculateStringValue (UTF8StringPtr _str, double& result) const
 {
@@ -2163,65 +2810,13 @@ bool UIDescription::calculateStringValue (UTF8StringPtr _str, double& result) co
 	result = strtod (_str, &endPtr);
 	if (endPtr == _str + strlen (_str))
 		return true;
-	std::string str (_str);
-	UIDescriptionPrivate::StringTokenList tokens;
-	if (!UIDescriptionPrivate::tokenizeString (str, tokens))
-	{
-	#if DEBUG
-		DebugPrint("TokenizeString failed :%s\n", _str);
-	#endif
+	// expressions are compiled once, the variables and control tags are resolved on evaluation
+	auto expression = impl->getCompiledExpression (_str);
+	double value;
+	if (!impl->evaluateExpression (this, *expression, value))
 		return false;
-	}
-	// first make substituation
-	for (auto& token : tokens)
-	{
-		if (token.type == UIDescriptionPrivate::StringToken::kString)
-		{
-			const char* tokenStr = token.c_str ();
-			double value = strtod (tokenStr, &endPtr);
-			if (endPtr != tokenStr + token.length ())
-			{
-				// if it is not pure numeric try to substitute the string with a control tag or variable
-				if (token.find ("tag.") == 0)
-				{
-					value = getTagForName (token.c_str () + 4);
-					if (value == -1)
-					{
-					#if DEBUG
-						DebugPrint("Tag not found :%s\n", tokenStr);
-					#endif
-						return false;
-					}
-				}
-				else if (token.find ("var.") == 0)
-				{
-					double v;
-					if (getVariable (token.c_str () + 4, v))
-					{
-						value = v;
-					}
-					else
-					{
-					#if DEBUG
-						DebugPrint("Variable not found :%s\n", tokenStr);
-					#endif
-						return false;
-					}
-				}
-				else
-				{
-				#if DEBUG
-					DebugPrint("Substitution failed :%s\n", tokenStr);
-				#endif
-					return false;
-				}
-			}
-			token.result = value;
-			token.type = UIDescriptionPrivate::StringToken::kResult;
-		}
-	}
-	result = 0;
-	return UIDescriptionPrivate::computeTokens (tokens, result);
+	result = value;
+	return true;
 }
 
 } // VSTGUI
@@ -29,6 +29,7 @@ protected:
 		WriteImagesIntoUIDescFileBit,
 		DoNotVerifyImageDataBit,
 		WriteAsXmlBit,
+		WriteAsBinaryBit,
 		LastSaveFlagBit,
 	};
 public:
@@ -43,6 +44,8 @@ public:
 		kWriteImagesIntoUIDescFile	= 1 << WriteImagesIntoUIDescFileBit,
 		kDoNotVerifyImageData	= 1 << DoNotVerifyImageDataBit,
 		kWriteAsXML = 1 << WriteAsXmlBit,
+		/** write the compiled binary format, see Detail::UIBinaryDesc */
+		kWriteAsBinary = 1 << WriteAsBinaryBit,
 		
 		kWriteImagesIntoXMLFile [[deprecated("use kWriteImagesIntoUIDescFile")]] = kWriteImagesIntoUIDescFile,
 		kDoNotVerifyImageXMLData [[deprecated("use kDoNotVerifyImageData")]] = kDoNotVerifyImageData,
@@ -82,6 +85,7 @@ public:
 
 	bool getVariable (UTF8StringPtr name, double& value) const override;
 	bool getVariable (UTF8StringPtr name, std::string& value) const override;
+	uint64_t getResourceRevision () const override;
 
 	void collectTemplateViewNames (std::list<const std::string*>& names) const override;
 	void collectColorNames (std::list<const std::string*>& names) const override;
@@ -140,6 +144,51 @@ public:
 
 	void setBitmapCreator (IBitmapCreator* bitmapCreator);
 	void setBitmapCreator2 (IBitmapCreator2* bitmapCreator);
+	/** set a directory where the results of bitmap filters are cached, an empty path disables
+	 *	the cache (default). The bitmaps are identified by their names, paths and the content of
+	 *	their image files. Bitmaps of a bitmap creator which are not read from their paths are
+	 *	only identified by the revision, which must then be changed whenever they change. */
+	void setBitmapFilterCachePath (UTF8StringPtr path, uint64_t bitmapsRevision = 0);
+
+	/** decode the bitmaps a template references on worker threads and create the fonts and
+	 *	gradients it references before createView creates its views (default off) */
+	void setPrefetchTemplateResources (bool state);
+	/** read the view descriptions of a template when the template is used for the first time
+	 *	instead of when parsing (default off). Must be set before parse. Only descriptions in
+	 *	the binary format (see kWriteAsBinary) can be loaded lazily. */
+	void setLazyTemplates (bool state);
+
+	struct CreateViewStatistics
+	{
+		/** microseconds spent to collect and decode the resources of the template */
+		uint64_t prefetchMicroseconds {0};
+		/** microseconds spent to create the views */
+		uint64_t buildMicroseconds {0};
+		uint32_t numPrefetchedBitmaps {0};
+		uint32_t numPrefetchedFonts {0};
+		uint32_t numPrefetchedGradients {0};
+	};
+	/** timing of the last createView call */
+	const CreateViewStatistics& getCreateViewStatistics () const;
+
+	enum class Format
+	{
+		Unknown,
+		JSON,
+		XML,
+		Binary,
+		/** zlib compressed description, only CompressedUIDescription can parse it */
+		Compressed,
+	};
+	struct ParseStatistics
+	{
+		/** format detected from the first bytes of the content */
+		Format format {Format::Unknown};
+		/** microseconds spent to detect the format and parse the content */
+		uint64_t parseMicroseconds {0};
+	};
+	/** format and timing of the last parse call */
+	const ParseStatistics& getParseStatistics () const;
 
 	using FocusDrawing = FocusDrawingSettings;
 	FocusDrawing getFocusDrawingSettings () const;
@@ -166,7 +215,6 @@ private:
 	UINode* findNodeForView (CView* view) const;
 	bool updateAttributesForView (UINode* node, CView* view, bool deep = true);
 	void removeNode (UTF8StringPtr name, IdStringPtr mainNodeName);
-	template<typename NodeType, typename ObjType, typename CompareFunction> UTF8StringPtr lookupName (const ObjType& obj, IdStringPtr mainNodeName, CompareFunction compare) const;
 	template<typename NodeType> void changeNodeName (UTF8StringPtr oldName, UTF8StringPtr newName, IdStringPtr mainNodeName);
 	template<typename NodeType> void collectNamesFromNode (IdStringPtr mainNodeName, std::list<const std::string*>& names) const;
 	
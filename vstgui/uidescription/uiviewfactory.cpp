@@ -8,6 +8,7 @@
 #include "../lib/cstring.h"
 #include "detail/uiviewcreatorattributes.h"
 #include "../lib/platform/std_unorderedmap.h"
+#include <vector>
 
 namespace VSTGUI {
 
@@ -89,6 +90,7 @@ class ViewCreatorRegistry : private ViewCreatorRegistryMap
 {
 public:
 	using const_iterator = ViewCreatorRegistryMap::const_iterator;
+	using CreatorChain = std::vector<const IViewCreator*>;
 
 	const_iterator begin () { return ViewCreatorRegistryMap::begin (); }
 	const_iterator end () { return ViewCreatorRegistryMap::end (); }
@@ -109,7 +111,7 @@ public:
 		}
 #endif
 		insert (std::make_pair (viewCreator->getViewName (), viewCreator));
-		
+		changed ();
 	}
 
 	void remove (const IViewCreator* viewCreator)
@@ -118,7 +120,41 @@ public:
 		if (it == end ())
 			return;
 		erase (it);
+		changed ();
+	}
+
+	/** the creator registered for name followed by the creators of its base views */
+	const CreatorChain& getCreatorChain (IdStringPtr name)
+	{
+		static const CreatorChain emptyChain;
+		if (!name)
+			return emptyChain;
+		auto it = chains.find (name);
+		if (it != chains.end ())
+			return it->second;
+		CreatorChain chain;
+		auto iter = find (name);
+		while (iter != end ())
+		{
+			if (std::find (chain.begin (), chain.end (), iter->second) != chain.end ())
+				break;
+			chain.emplace_back (iter->second);
+			iter = find (iter->second->getBaseViewName ());
+		}
+		return chains.emplace (name, std::move (chain)).first->second;
+	}
+
+	uint64_t getRevision () const { return revision; }
+
+private:
+	void changed ()
+	{
+		chains.clear ();
+		++revision;
 	}
+
+	std::unordered_map<std::string, CreatorChain> chains;
+	uint64_t revision {0};
 };
 
 //-----------------------------------------------------------------------------
@@ -131,6 +167,39 @@ static ViewCreatorRegistry& getCreatorRegistry ()
 //-----------------------------------------------------------------------------
 static CViewAttributeID kViewNameAttribute = 'cvcr';
 
+//-----------------------------------------------------------------------------
+/** the evaluated attributes of a view description and the attributes to remember for the editor.
+ *
+ *	It is stored on the attributes object, so that creating the same view again (for example from
+ *	a template used for list rows or switch container pages) does not need to evaluate the
+ *	variables again and the typed attribute values are only parsed once. The attributes drop it
+ *	when they change.
+ */
+struct UIViewFactory::ViewCreationPlan : UIAttributes::DerivedData
+{
+	const UIViewFactory* factory {nullptr};
+	const IUIDescription* description {nullptr};
+	const IViewCreator* creator {nullptr};
+	uint64_t registryRevision {0};
+	uint64_t resourceRevision {0};
+	SharedPointer<UIAttributes> evaluatedAttributes;
+	std::vector<std::pair<std::string, std::string>> rememberedAttributes;
+};
+
+
+//-----------------------------------------------------------------------------
+static bool applyCreatorChain (const ViewCreatorRegistry::CreatorChain& chain, CView* view,
+							   const UIAttributes& attributes, const IUIDescription* description)
+{
+	bool result = false;
+	for (auto creator : chain)
+	{
+		if (!(result = creator->apply (view, attributes, description)))
+			break;
+	}
+	return result;
+}
+
 //-----------------------------------------------------------------------------
 UIViewFactory::UIViewFactory ()
 {
@@ -140,22 +209,16 @@ UIViewFactory::UIViewFactory ()
 CView* UIViewFactory::createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const
 {
 	auto& registry = getCreatorRegistry ();
-	auto iter = registry.find (className->c_str ());
-	if (iter != registry.end ())
+	const auto& chain = registry.getCreatorChain (className->c_str ());
+	if (!chain.empty ())
 	{
-		CView* view = (*iter).second->create (attributes, description);
+		CView* view = chain.front ()->create (attributes, description);
 		if (view)
 		{
-			IdStringPtr viewName = (*iter).second->getViewName ();
+			IdStringPtr viewName = chain.front ()->getViewName ();
 			view->setAttribute (kViewNameAttribute, viewName);
-			UIAttributes evaluatedAttributes;
-			evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
-			while (iter != registry.end () && (*iter).second->apply (view, evaluatedAttributes, description))
-			{
-				if ((*iter).second->getBaseViewName () == nullptr)
-					break;
-				iter = registry.find ((*iter).second->getBaseViewName ());
-			}
+			auto evaluatedAttributes = evaluateAttributes (view, attributes, description);
+			applyCreatorChain (chain, view, *evaluatedAttributes, description);
 			return view;
 		}
 	}
@@ -181,38 +244,24 @@ CView* UIViewFactory::createView (const UIAttributes& attributes, const IUIDescr
 //-----------------------------------------------------------------------------
 bool UIViewFactory::applyAttributeValues (CView* view, const UIAttributes& attributes, const IUIDescription* desc) const
 {
-	bool result = false;
 	auto& registry = getCreatorRegistry ();
-	auto iter = registry.find (getViewName (view));
-
-	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
-	
-	while (iter != registry.end () && (result = (*iter).second->apply (view, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
-	{
-		iter = registry.find ((*iter).second->getBaseViewName ());
-	}
-	return result;
+	const auto& chain = registry.getCreatorChain (getViewName (view));
+	auto evaluatedAttributes = evaluateAttributes (view, attributes, desc);
+	return applyCreatorChain (chain, view, *evaluatedAttributes, desc);
 }
 
 //-----------------------------------------------------------------------------
 bool UIViewFactory::applyCustomViewAttributeValues (CView* customView, IdStringPtr baseViewName, const UIAttributes& attributes, const IUIDescription* desc) const
 {
-	bool result = false;
 	auto& registry = getCreatorRegistry ();
-	auto iter = registry.find (baseViewName);
-	if (iter != registry.end ())
+	const auto& chain = registry.getCreatorChain (baseViewName);
+	if (!chain.empty ())
 	{
-		IdStringPtr viewName = (*iter).second->getViewName ();
+		IdStringPtr viewName = chain.front ()->getViewName ();
 		customView->setAttribute (kViewNameAttribute, viewName);
 	}
-	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
-	while (iter != registry.end () && (result = (*iter).second->apply (customView, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
-	{
-		iter = registry.find ((*iter).second->getBaseViewName ());
-	}
-	return result;
+	auto evaluatedAttributes = evaluateAttributes (customView, attributes, desc);
+	return applyCreatorChain (chain, customView, *evaluatedAttributes, desc);
 }
 
 //-----------------------------------------------------------------------------
@@ -225,8 +274,10 @@ IdStringPtr UIViewFactory::getViewName (CView* view)
 }
 
 //-----------------------------------------------------------------------------
-void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
+void UIViewFactory::buildCreationPlan (ViewCreationPlan& plan, CView* view, const UIAttributes& attributes, const IUIDescription* description) const
 {
+	plan.evaluatedAttributes = makeOwned<UIAttributes> ();
+	plan.rememberedAttributes.clear ();
 	std::string evaluatedValue;
 	for (const auto& attr : attributes)
 	{
@@ -234,9 +285,9 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 		if (description && description->getVariable (value.c_str (), evaluatedValue))
 		{
 		#if VSTGUI_LIVE_EDITING
-			rememberAttribute (view, attr.first.c_str (), value.c_str ());
+			plan.rememberedAttributes.emplace_back (attr.first, value);
 		#endif
-			evaluatedAttributes.setAttribute (attr.first, evaluatedValue);
+			plan.evaluatedAttributes->setAttribute (attr.first, evaluatedValue);
 		}
 		else
 		{
@@ -248,17 +299,69 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 				case IViewCreator::kTagType:
 				case IViewCreator::kFontType:
 				case IViewCreator::kGradientType:
-					rememberAttribute (view, attr.first.c_str (), value.c_str ());
+					plan.rememberedAttributes.emplace_back (attr.first, value);
 					break;
 				default:
 					break;
 			}
 		#endif
-			evaluatedAttributes.setAttribute (attr.first, value);
+			plan.evaluatedAttributes->setAttribute (attr.first, value);
 		}
 	}
 }
 
+//-----------------------------------------------------------------------------
+void UIViewFactory::rememberAttributes (CView* view, const ViewCreationPlan& plan) const
+{
+#if VSTGUI_LIVE_EDITING
+	for (const auto& attr : plan.rememberedAttributes)
+		rememberAttribute (view, attr.first.c_str (), attr.second);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<UIAttributes> UIViewFactory::evaluateAttributes (CView* view, const UIAttributes& attributes, const IUIDescription* description) const
+{
+	auto& registry = getCreatorRegistry ();
+	const auto& chain = registry.getCreatorChain (getViewName (view));
+	auto creator = chain.empty () ? nullptr : chain.front ();
+
+	auto plan = dynamic_cast<ViewCreationPlan*> (attributes.getDerivedData ());
+	if (!plan)
+	{
+		plan = new ViewCreationPlan;
+		attributes.setDerivedData (std::unique_ptr<UIAttributes::DerivedData> (plan));
+	}
+	// the evaluated attributes depend on the variables of the description
+	auto resourceRevision = description ? description->getResourceRevision () : 0;
+	if (plan->evaluatedAttributes == nullptr || plan->factory != this ||
+		plan->description != description || plan->creator != creator ||
+		plan->registryRevision != registry.getRevision () ||
+		plan->resourceRevision != resourceRevision)
+	{
+		buildCreationPlan (*plan, view, attributes, description);
+		plan->evaluatedAttributes->enableParsedValueCache ();
+		plan->factory = this;
+		plan->description = description;
+		plan->creator = creator;
+		plan->registryRevision = registry.getRevision ();
+		plan->resourceRevision = resourceRevision;
+	}
+	rememberAttributes (view, *plan);
+	// the plan may be replaced while the attributes are applied when the view creates sub views
+	return plan->evaluatedAttributes;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
+{
+	ViewCreationPlan plan;
+	buildCreationPlan (plan, view, attributes, description);
+	rememberAttributes (view, plan);
+	for (const auto& attr : *plan.evaluatedAttributes)
+		evaluatedAttributes.setAttribute (attr.first, attr.second);
+}
+
 #if VSTGUI_LIVE_EDITING
 //-----------------------------------------------------------------------------
 bool UIViewFactory::getAttributeNamesForView (CView* view, StringList& attributeNames) const
@@ -56,12 +56,19 @@ public:
 protected:
 	void evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
 	CView* createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const;
+	SharedPointer<UIAttributes> evaluateAttributes (CView* view, const UIAttributes& attributes, const IUIDescription* description) const;
 
 #if VSTGUI_LIVE_EDITING
 	static size_t createHash (const std::string& str);
 	void rememberAttribute (CView* view, IdStringPtr attrName, const std::string& value) const;
 	bool getRememberedAttribute (CView* view, IdStringPtr attrName, std::string& value) const;
 #endif
+
+private:
+	struct ViewCreationPlan;
+
+	void buildCreationPlan (ViewCreationPlan& plan, CView* view, const UIAttributes& attributes, const IUIDescription* description) const;
+	void rememberAttributes (CView* view, const ViewCreationPlan& plan) const;
 };
 
 } // VSTGUI
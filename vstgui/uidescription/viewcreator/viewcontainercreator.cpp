@@ -76,6 +76,11 @@ bool ViewContainerCreator::apply (CView* view, const UIAttributes& attributes,
 			}
 		}
 	}
+	bool b;
+	if (attributes.getBooleanAttribute (kAttrRenderCache, b))
+		viewContainer->setRenderCacheEnabled (b);
+	if (attributes.getBooleanAttribute (kAttrOpaque, b))
+		viewContainer->setOpaque (b);
 	return true;
 }
 
@@ -84,6 +89,8 @@ bool ViewContainerCreator::getAttributeNames (StringList& attributeNames) const
 {
 	attributeNames.emplace_back (kAttrBackgroundColor);
 	attributeNames.emplace_back (kAttrBackgroundColorDrawStyle);
+	attributeNames.emplace_back (kAttrRenderCache);
+	attributeNames.emplace_back (kAttrOpaque);
 	return true;
 }
 
@@ -94,6 +101,10 @@ auto ViewContainerCreator::getAttributeType (const string& attributeName) const
 		return kColorType;
 	if (attributeName == kAttrBackgroundColorDrawStyle)
 		return kListType;
+	if (attributeName == kAttrRenderCache)
+		return kBooleanType;
+	if (attributeName == kAttrOpaque)
+		return kBooleanType;
 	return kUnknownType;
 }
 
@@ -114,6 +125,16 @@ bool ViewContainerCreator::getAttributeValue (CView* view, const string& attribu
 		stringValue = backgroundColorDrawStyleStrings ()[vc->getBackgroundColorDrawStyle ()];
 		return true;
 	}
+	if (attributeName == kAttrRenderCache)
+	{
+		stringValue = vc->isRenderCacheEnabled () ? strTrue : strFalse;
+		return true;
+	}
+	if (attributeName == kAttrOpaque)
+	{
+		stringValue = vc->getOpaque () ? strTrue : strFalse;
+		return true;
+	}
 	return false;
 }
 
@@ -8,6 +8,7 @@
 
 #include "cstream.h"
 #include "icontentprovider.h"
+#include <algorithm>
 
 /// @cond ignore
 #if VSTGUI_USE_SYSTEM_EXPAT
@@ -121,21 +122,40 @@ bool Parser::parse (IContentProvider* provider, IHandler* handler)
 
 	static const uint32_t kBufferSize = 0x8000;
 
+	static const uint32_t kMaxInPlaceSize = 0x40000000;
+
 	provider->rewind ();
 
+	// content which is available in memory is parsed in place
+	uint32_t contentSize = 0;
+	const int8_t* content = provider->getContent (contentSize);
+
 	while (true) 
 	{
-		void* buffer = XML_GetBuffer (pImpl->parser, kBufferSize);
-		if (buffer == nullptr)
+		uint32_t bytesRead;
+		XML_Status status;
+		if (content)
 		{
-			pImpl->handler = nullptr;
-			return false;
+			bytesRead = std::min (contentSize, kMaxInPlaceSize);
+			status = XML_Parse (pImpl->parser, reinterpret_cast<const char*> (content),
+			                    static_cast<int> (bytesRead), bytesRead == 0);
+			content += bytesRead;
+			contentSize -= bytesRead;
 		}
+		else
+		{
+			void* buffer = XML_GetBuffer (pImpl->parser, kBufferSize);
+			if (buffer == nullptr)
+			{
+				pImpl->handler = nullptr;
+				return false;
+			}
 
-		uint32_t bytesRead = provider->readRawData ((int8_t*)buffer, kBufferSize);
-		if (bytesRead == kStreamIOError)
-			bytesRead = 0;
-		XML_Status status = XML_ParseBuffer (pImpl->parser, static_cast<int> (bytesRead), bytesRead == 0);
+			bytesRead = provider->readRawData ((int8_t*)buffer, kBufferSize);
+			if (bytesRead == kStreamIOError)
+				bytesRead = 0;
+			status = XML_ParseBuffer (pImpl->parser, static_cast<int> (bytesRead), bytesRead == 0);
+		}
 		switch (status) 
 		{
 			case XML_STATUS_ERROR:
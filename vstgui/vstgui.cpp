@@ -2,6 +2,7 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "lib/blurengine.cpp"
 #include "lib/cbitmap.cpp"
 #include "lib/cbitmapfilter.cpp"
 #include "lib/ccolor.cpp"
@@ -23,6 +24,7 @@
 #include "lib/crowcolumnview.cpp"
 #include "lib/cscrollview.cpp"
 #include "lib/cshadowviewcontainer.cpp"
+#include "lib/cspriteatlas.cpp"
 #include "lib/csplitview.cpp"
 #include "lib/cstring.cpp"
 #include "lib/ctabview.cpp"
@@ -32,8 +34,10 @@
 #include "lib/cvstguitimer.cpp"
 #include "lib/genericstringlistdatabrowsersource.cpp"
 #include "lib/pixelbuffer.cpp"
+#include "lib/timerwheel.cpp"
 #include "lib/vstguidebug.cpp"
 #include "lib/vstguiinit.cpp"
+#include "lib/workerpool.cpp"
 
 #include "lib/controls/cautoanimation.cpp"
 #include "lib/controls/cbuttons.cpp"
@@ -67,3 +71,4 @@
 #include "lib/platform/common/fileresourceinputstream.cpp"
 #include "lib/platform/common/genericoptionmenu.cpp"
 #include "lib/platform/common/generictextedit.cpp"
+#include "lib/platform/common/mappedfileresourceinputstream.cpp"
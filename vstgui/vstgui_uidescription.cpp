@@ -71,6 +71,9 @@
 #include "uidescription/viewcreator/vumetercreator.cpp"
 #include "uidescription/viewcreator/xypadcreator.cpp"
 
+#include "uidescription/detail/bitmapfiltercache.cpp"
+#include "uidescription/detail/uibinarypersistence.cpp"
+#include "uidescription/detail/uidescformat.cpp"
 #include "uidescription/detail/uidesclist.cpp"
 #include "uidescription/detail/uijsonpersistence.cpp"
 #include "uidescription/detail/uinode.cpp"